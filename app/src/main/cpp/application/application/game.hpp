@@ -2,6 +2,7 @@
 
 #include <assets/data.hpp>
 #include <SDL.h>
+#include <filesystem>
 #include <string>
 #include <vector>
 #include <inttypes.h>
@@ -9,6 +10,10 @@
 class Window;
 class Renderer;
 class Text;
+class InputSystem;
+class TextFitAnalyzer;
+class FontLoader;
+class FontPreview;
 
 class Game {
 public:
@@ -18,6 +23,22 @@ public:
     [[nodiscard]] bool isInit() const;
     void run() const;
 
+    // Before run(): save the session's input to `path`, or play `path` back
+    // instead of live input and quit when it ends
+    static bool recordInput(const std::filesystem::path& path);
+    static bool replayInput(const std::filesystem::path& path);
+
+    // The main window's tab bodies, drawn into the current ImGui window, and
+    // the upkeep of the state they share, once per frame before ImGui::NewFrame().
+    // play() calls these every frame; a test can draw the tabs without it.
+    static void BeginEditorFrame(SDL_Renderer* renderer);
+    static void DrawLocalizationTab(TextFitAnalyzer& textFit, float itemWidth);
+    static void DrawFontTab(FontLoader& fontLoader, FontPreview& fontPreview, size_t& previewKey);
+    static void DrawDecorTab(SDL_Renderer* renderer, const std::filesystem::path& gamePath);
+
+    // After LocalizationList was loaded or replaced by another language or a preset
+    static void RefreshLocalization(TextFitAnalyzer& textFit);
+
     Game(const Game&) = delete;
     Game(Game&&) = delete;
     Game& operator=(const Game&) = delete;
@@ -28,7 +49,7 @@ private:
     static void loadStartScreen(Window& window, Renderer& renderer);
 
     bool m_isInit;
-    static std::vector<SDL_GameController*> controllers;
+    static InputSystem input;
 
     static const std::string s_orientation;
     static const std::string s_name;
@@ -37,5 +58,8 @@ private:
     static const void launchGame();
 
     static void AddCustomDecorFromDialog(SDL_Renderer* renderer);
+#if !defined(__ANDROID__)
+    static void AddCustomDecorFolderFromDialog();
+#endif
     static void DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::path& gamePath);
 };
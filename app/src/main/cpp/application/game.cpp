@@ -4,10 +4,30 @@
 #include <objects/text.hpp>
 #include <objects/imgui_window.hpp>
 #include <objects/missing_game_window.hpp>
+#include <objects/debug_overlay.hpp>
+#include <objects/font_preview.hpp>
 #include <utils/icon.hpp>
 #include <utils/find_game.hpp>
 #include <utils/input_system.hpp>
 #include <utils/file_manager.hpp>
+#include <utils/decor_collection.hpp>
+#include <utils/decor_importer.hpp>
+#include <utils/decor_hash_index.hpp>
+#include <utils/content_hash.hpp>
+#include <utils/texture.hpp>
+#include <utils/texture_manager.hpp>
+#include <utils/frame_arena.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/trigram_index.hpp>
+#include <utils/localization_packs.hpp>
+#include <utils/preset_store.hpp>
+#include <utils/text_fit_analyzer.hpp>
+#include <utils/font_loader.hpp>
+#include <utils/task_scheduler.hpp>
+#include <utils/spsc_ring.hpp>
+#include <utils/latency_tracker.hpp>
+#include <utils/trace.hpp>
+#include <utils/frame_skip.hpp>
 #include <assets/data.hpp>
 #include <SDL.h>
 #include <SDL_image.h>
@@ -15,13 +35,18 @@
 #include <imgui.h>
 #include <backends/imgui_impl_sdl2.h>
 #include <backends/imgui_impl_sdlrenderer2.h>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <array>
+#include <chrono>
 #include <filesystem>
+#include <unordered_set>
 
 #if defined(__ANDROID__)
-#include <jni.h>
+#include <utils/jni_bridge.hpp>
+#include <memory>
 #else
 #include <steam/steam_api.h>
 #include <tinyfiledialogs.h>
@@ -43,61 +68,184 @@ const SDL_Point Game::s_windowPos = {
         static_cast<int>(SDL_WINDOWPOS_CENTERED)
 };
 
-std::vector<SDL_GameController*> Game::controllers;
+InputSystem Game::input;
 
-#if defined(__ANDROID__)
-static std::vector<CustomeDecorationList> gPendingDecorations;
-static std::mutex gPendingMutex;
+static DecorImporter gDecorImporter;
+static TextureManager gTextureManager;
+static FrameArena gFrameArena;
 
-static std::unordered_map<std::string, std::vector<unsigned char>> gImageCache;
+// Search over "key\nvalue" of every localization entry, one document per key
+static TrigramIndex gLocalizationIndex;
+static bool gLocalizationSearchDirty = true;
 
-void ProcessPendingDecorations(SDL_Renderer* renderer)
+static void IndexLocalizationEntry(size_t index)
+{
+    static std::string s_text;
+    const LocalizationText& value = LocalizationList[index];
+    s_text.assign(LocalizationKeyNames[index]);
+    s_text += '\n';
+    s_text.append(value.data(), strnlen(value.data(), value.size()));
+    gLocalizationIndex.update(static_cast<TrigramIndex::DocId>(index), s_text);
+}
+
+static void RebuildLocalizationIndex()
 {
-    std::vector<CustomeDecorationList> localQueue;
+    gLocalizationIndex.resize(LocalizationKeyCount);
+    for (size_t i = 0; i < LocalizationKeyCount; ++i) {
+        IndexLocalizationEntry(i);
+    }
+    gLocalizationSearchDirty = true;
+}
+
+// Languages beside the game's own text; packs live in the pref directory
+static LocalizationPacks gLocalizationPacks;
+
+static PresetStore gPresetStore;
 
+// Applies a preset and writes only what it changed. Returns true when
+// LocalizationList changed.
+static bool ApplyPreset(const std::string& name, const std::filesystem::path& gamePath, char* status, size_t statusSize)
+{
+    PresetStore::Diff diff;
+    if (!gPresetStore.apply(name, diff))
     {
-        std::lock_guard<std::mutex> lock(gPendingMutex);
-        if (gPendingDecorations.empty()) return;
-        localQueue.swap(gPendingDecorations);
+        std::snprintf(status, statusSize, "Could not apply '%s'", name.c_str());
+        return false;
     }
 
-    for (auto& deco : localQueue)
+    if (!diff.config.empty())
     {
-        auto it = gImageCache.find(deco.path.string());
-        if (it == gImageCache.end()) {
-            SDL_Log("No cached image bytes for: %s", deco.path.c_str());
-            continue;
-        }
+        FileManager::updateConfigFiles(diff.config);
+    }
+    if (diff.hasDecorChanges())
+    {
+        FileManager::processCustomDecorations(gamePath);
+    }
+    const size_t importing = diff.missingDecor.size();
+    if (importing != 0 && !gDecorImporter.start(std::move(diff.missingDecor)))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "An import is still running; preset decor was not restored");
+    }
 
-        const auto& bytes = it->second;
+    std::snprintf(status, statusSize, "'%s': %zu config entries, %zu decor changed, %zu decor importing (Save to copy)%s",
+        name.c_str(), diff.config.count(), diff.decorRenamed + diff.decorRemoved + diff.decorRestored, importing,
+        diff.decorUnavailable != 0 ? ", some decor missing" : "");
 
-        SDL_RWops* rw = SDL_RWFromConstMem(bytes.data(), bytes.size());
-        if (!rw) {
-            SDL_Log("SDL_RWFromConstMem failed for %s: %s", deco.path.c_str(), SDL_GetError());
-            continue;
-        }
+    if (diff.config.localization.none())
+    {
+        return false;
+    }
+    gLocalizationPacks.markDirty();
+    return true;
+}
+
+#if !defined(__ANDROID__)
+// True when the active language was part of the import and LocalizationList changed
+static bool ImportLocalizationFromDialog()
+{
+    const char* filters[] = { "*.csv", "*.po" };
+    const char* path = tinyfd_openFileDialog("Import localization", "", 2, filters, "CSV or PO files", 0);
+    if (!path)
+    {
+        SDL_Log("No file selected");
+        return false;
+    }
+
+    const std::filesystem::path file(path);
+    LocalizationPacks::ImportResult result;
+    const bool ok = file.extension() == ".po"
+        ? gLocalizationPacks.importPo(file, result)
+        : gLocalizationPacks.importCsv(file, result);
+    if (!ok)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Import of %s failed", path);
+    }
+    return std::find(result.languages.begin(), result.languages.end(), gLocalizationPacks.active()) != result.languages.end();
+}
+
+static void ExportLocalizationFromDialog(bool po)
+{
+    const char* filters[] = { po ? "*.po" : "*.csv" };
+    const std::string defaultName = po ? gLocalizationPacks.active() + ".po" : std::string("localization.csv");
+    const char* path = tinyfd_saveFileDialog("Export localization", defaultName.c_str(), 1, filters, po ? "PO file" : "CSV file");
+    if (!path)
+    {
+        SDL_Log("No file selected");
+        return;
+    }
+
+    if (po)
+    {
+        gLocalizationPacks.exportPo(gLocalizationPacks.active(), path);
+    }
+    else
+    {
+        gLocalizationPacks.exportCsv(path);
+    }
+}
+#endif
+
+// Decor previews are capped so a huge source image costs a preview-sized
+// surface instead of its full resolution, and never exceeds what the renderer
+// can hold in one texture.
+constexpr int gMaxDecorPreviewSize = 4096;
+
+// Render-thread time per frame for finished background work
+constexpr std::chrono::microseconds gMainThreadTaskBudget(2000);
+
+static SDL_Point DecorPreviewLimit(SDL_Renderer* renderer)
+{
+    SDL_Point limit{ gMaxDecorPreviewSize, gMaxDecorPreviewSize };
+    SDL_RendererInfo info;
+    if (renderer && SDL_GetRendererInfo(renderer, &info) == 0) {
+        if (info.max_texture_width > 0) limit.x = std::min(limit.x, info.max_texture_width);
+        if (info.max_texture_height > 0) limit.y = std::min(limit.y, info.max_texture_height);
+    }
+    return limit;
+}
+
+#if defined(__ANDROID__)
+// A picked file as one message: the bytes are copied once out of the Java
+// array and then only change owner
+struct PickedImage {
+    std::string path;
+    std::unique_ptr<unsigned char[]> bytes;
+    size_t size = 0;
+};
 
-        SDL_Surface* surface = IMG_Load_RW(rw, 1);
-        if (!surface) {
-            SDL_Log("IMG_Load_RW failed for %s: %s", deco.path.c_str(), IMG_GetError());
+// Filled by nativeOnImagePicked on the Java UI thread, drained by the render thread
+static SpscRing<PickedImage, 16> gPickedImages;
+
+void ProcessPendingDecorations(SDL_Renderer* renderer)
+{
+    PickedImage image;
+    while (gPickedImages.tryPop(image))
+    {
+        CustomeDecorationList deco;
+        deco.path = image.path;
+        deco.name = deco.path.stem().string();
+        deco.setOperation(CustomeDecorationOperationEnum::Add);
+
+        deco.contentHash = ContentHash::hash(image.bytes.get(), image.size);
+        const CustomDecorCollection::Index existing = CustomDecorList.findByHash(deco.contentHash);
+        if (existing != CustomDecorCollection::npos) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Skipping %s: identical to decor '%s'",
+                deco.path.c_str(), CustomDecorList[existing].name.c_str());
             continue;
         }
 
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-
+        const SDL_Point limit = DecorPreviewLimit(renderer);
+        SDL_Texture* texture = TextureUpload::fromImage(renderer, image.bytes.get(), image.size, limit.x, limit.y, true);
         if (!texture) {
-            SDL_Log("SDL_CreateTextureFromSurface failed for %s", deco.path.c_str());
+            SDL_Log("Failed to load %s: %s", deco.path.c_str(), IMG_GetError());
             continue;
         }
 
-        deco.texture = texture;
-        deco.ensureUniqueName(CustomDecorList);
-        CustomDecorList.push_back(std::move(deco));
-
+        // The picked file lives in a temporary cache, so this one cannot be reloaded
+        deco.texture = gTextureManager.adopt(texture, {}, true);
         SDL_Log("Decor texture added: %s", deco.path.c_str());
 
-        gImageCache.erase(it);
+        CustomDecorList.add(std::move(deco));
     }
 }
 
@@ -108,26 +256,25 @@ Java_com_ipoleksenko_sense_customizer_FileManager_nativeOnImagePicked(
 {
     if (!byteArray || !jPath) return;
 
+    PickedImage image;
     const char* rawPath = env->GetStringUTFChars(jPath, nullptr);
-    std::string path(rawPath);
+    image.path = rawPath;
     env->ReleaseStringUTFChars(jPath, rawPath);
 
+    // Left uninitialized: GetByteArrayRegion writes every byte
     jsize len = env->GetArrayLength(byteArray);
-    std::vector<unsigned char> bytes(len);
-    env->GetByteArrayRegion(byteArray, 0, len, reinterpret_cast<jbyte*>(bytes.data()));
+    image.bytes.reset(new unsigned char[len]);
+    image.size = static_cast<size_t>(len);
+    env->GetByteArrayRegion(byteArray, 0, len, reinterpret_cast<jbyte*>(image.bytes.get()));
 
-    CustomeDecorationList item;
-    item.path = path;
-    item.name = std::filesystem::path(path).stem().string();
-    item.operations.push_back(CustomeDecorationOperationEnum::Add);
+    SDL_Log("Received image %s (%d bytes) from Java", image.path.c_str(), (int)len);
 
-    {
-        std::lock_guard<std::mutex> lock(gPendingMutex);
-        gPendingDecorations.push_back(std::move(item));
-        gImageCache[path] = std::move(bytes);
+    // One image per pick, drained every frame; a full ring means the render
+    // thread is not running, and the Java UI thread must not wait for it
+    if (!gPickedImages.tryPush(std::move(image))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Dropping picked image %s: %zu images already waiting",
+            image.path.c_str(), gPickedImages.capacity());
     }
-
-    SDL_Log("Received image %s (%d bytes) from Java", path.c_str(), (int)len);
 }
 #endif
 
@@ -173,6 +320,14 @@ bool Game::isInit() const {
     return m_isInit;
 }
 
+bool Game::recordInput(const std::filesystem::path& path) {
+    return input.recording().startRecording(path);
+}
+
+bool Game::replayInput(const std::filesystem::path& path) {
+    return input.recording().startReplay(path);
+}
+
 void Game::run() const {
     if (!isInit()) {
         return;
@@ -207,6 +362,7 @@ void Game::run() const {
 
     loadStartScreen(window, renderer);
     play(window, renderer);
+    input.recording().finish();
 }
 
 void Game::loadStartScreen(Window& window, Renderer& renderer) {
@@ -229,59 +385,40 @@ void Game::loadStartScreen(Window& window, Renderer& renderer) {
 const void Game::launchGame() {
 #if defined(__ANDROID__)
     const char* packageName = "com.ipoleksenko.sense";
-    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-    jobject activity = (jobject)SDL_AndroidGetActivity();
-
-    jclass activityClass = env->GetObjectClass(activity);
-    if (!activityClass) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get activity class");
+    JNIEnv* env = Jni::env();
+    if (!env) {
         return;
     }
 
-    jmethodID getPackageManager = env->GetMethodID(activityClass,
-                                                   "getPackageManager", "()Landroid/content/pm/PackageManager;");
-    jobject packageManager = env->CallObjectMethod(activity, getPackageManager);
+    const Jni::Bindings& jni = Jni::bindings();
+    Jni::LocalFrame frame(env);
+
+    jobject activity = static_cast<jobject>(SDL_AndroidGetActivity());
+    if (!activity) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get activity");
+        return;
+    }
 
-    jclass pmClass = env->GetObjectClass(packageManager);
-    jmethodID getLaunchIntentForPackage = env->GetMethodID(pmClass,
-                                                           "getLaunchIntentForPackage", "(Ljava/lang/String;)Landroid/content/Intent;");
+    jobject packageManager = Jni::call<jobject>(env, activity, jni.getPackageManager);
     jstring jPackageName = env->NewStringUTF(packageName);
-    jobject launchIntent = env->CallObjectMethod(packageManager, getLaunchIntentForPackage, jPackageName);
+    jobject launchIntent = Jni::call<jobject>(env, packageManager, jni.getLaunchIntentForPackage, jPackageName);
+    Jni::clearException(env, "getLaunchIntentForPackage");
 
     if (launchIntent) {
-        jmethodID startActivity = env->GetMethodID(activityClass, "startActivity", "(Landroid/content/Intent;)V");
-        env->CallVoidMethod(activity, startActivity, launchIntent);
+        Jni::call<void>(env, activity, jni.startActivity, launchIntent);
         SDL_Log("Launching installed game: %s", packageName);
     } else {
-        jclass uriClass = env->FindClass("android/net/Uri");
-        jmethodID parse = env->GetStaticMethodID(uriClass, "parse", "(Ljava/lang/String;)Landroid/net/Uri;");
         std::string marketUrl = "market://details?id=" + std::string(packageName);
         jstring jUrl = env->NewStringUTF(marketUrl.c_str());
-        jobject uri = env->CallStaticObjectMethod(uriClass, parse, jUrl);
+        jobject uri = Jni::callStatic<jobject>(env, jni.uriParse, jUrl);
 
-        jclass intentClass = env->FindClass("android/content/Intent");
-        jmethodID intentConstructor = env->GetMethodID(intentClass, "<init>",
-                                                       "(Ljava/lang/String;Landroid/net/Uri;)V");
         jstring actionView = env->NewStringUTF("android.intent.action.VIEW");
-        jobject marketIntent = env->NewObject(intentClass, intentConstructor, actionView, uri);
+        jobject marketIntent = env->NewObject(jni.intent, jni.intentInit.id, actionView, uri);
 
-        jmethodID startActivity = env->GetMethodID(activityClass, "startActivity", "(Landroid/content/Intent;)V");
-        env->CallVoidMethod(activity, startActivity, marketIntent);
+        Jni::call<void>(env, activity, jni.startActivity, marketIntent);
         SDL_Log("Game not installed, opening Google Play: %s", marketUrl.c_str());
-
-        env->DeleteLocalRef(uri);
-        env->DeleteLocalRef(jUrl);
-        env->DeleteLocalRef(uriClass);
-        env->DeleteLocalRef(intentClass);
-        env->DeleteLocalRef(actionView);
-        env->DeleteLocalRef(marketIntent);
     }
-
-    env->DeleteLocalRef(jPackageName);
-    env->DeleteLocalRef(pmClass);
-    env->DeleteLocalRef(packageManager);
-    env->DeleteLocalRef(activityClass);
-    env->DeleteLocalRef(activity);
+    Jni::clearException(env, "startActivity");
 #else
     const char* steamAppId = "3832650";
     std::string steamCommand = "steam://run/" + std::string(steamAppId);
@@ -303,68 +440,67 @@ const void Game::launchGame() {
 void Game::AddCustomDecorFromDialog(SDL_Renderer* renderer)
 {
 #if defined(__ANDROID__)
-    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
+    JNIEnv* env = Jni::env();
     if (!env) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get JNI environment");
         return;
     }
 
-    jclass fileManagerClass = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-    if (!fileManagerClass) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find class: com/ipoleksenko/sense/customizer/FileManager");
-        return;
+    Jni::callStatic<void>(env, Jni::bindings().pickImageFromGallery);
+    if (!Jni::clearException(env, "pickImageFromGallery")) {
+        SDL_Log("Called FileManager.pickImageFromGallery() successfully");
     }
-
-    jmethodID pickImageMethod = env->GetStaticMethodID(fileManagerClass, "pickImageFromGallery", "()V");
-    if (!pickImageMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find static method: pickImageFromGallery()V");
-        env->DeleteLocalRef(fileManagerClass);
-        return;
-    }
-
-    env->CallStaticVoidMethod(fileManagerClass, pickImageMethod);
-    SDL_Log("Called FileManager.pickImageFromGallery() successfully");
-
-    env->DeleteLocalRef(fileManagerClass);
 #else
     const char* filters[] = { "*.png" };
-    const char* selectedPath = tinyfd_openFileDialog(
-        "Select PNG image",
+    const char* selectedPaths = tinyfd_openFileDialog(
+        "Select PNG images",
         "",
         1,
         filters,
         "PNG images",
-        0 // 0 = single file, 1 = allow multiple selection
+        1 // 0 = single file, 1 = allow multiple selection
     );
 
-    if (!selectedPath)
+    if (!selectedPaths)
     {
         SDL_Log("No file selected");
         return;
     }
 
-    SDL_Log("Selected file: %s", selectedPath);
+    // Multiple selections come back as one '|' separated string
+    std::vector<std::filesystem::path> files;
+    std::string_view remaining(selectedPaths);
+    while (!remaining.empty()) {
+        const size_t separator = remaining.find('|');
+        files.emplace_back(std::string(remaining.substr(0, separator)));
+        if (separator == std::string_view::npos) break;
+        remaining.remove_prefix(separator + 1);
+    }
+
+    SDL_Log("Selected %zu file(s)", files.size());
+    gDecorImporter.start(std::move(files));
+#endif
+}
 
-    SDL_Texture* tex = IMG_LoadTexture(renderer, selectedPath);
-    if (!tex)
+#if !defined(__ANDROID__)
+void Game::AddCustomDecorFolderFromDialog()
+{
+    const char* folder = tinyfd_selectFolderDialog("Select a folder with PNG images", "");
+    if (!folder)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture: %s", IMG_GetError());
+        SDL_Log("No folder selected");
         return;
     }
 
-    CustomeDecorationList item;
-    item.name = std::filesystem::path(selectedPath).stem().string();
-    item.path = selectedPath;
-    item.texture = tex;
-    item.operations.push_back(CustomeDecorationOperationEnum::Add);
-
-    item.ensureUniqueName(CustomDecorList);
+    std::vector<std::filesystem::path> files = DecorImporter::listPngFiles(folder);
+    SDL_Log("Found %zu PNG file(s) in %s", files.size(), folder);
 
-    CustomDecorList.push_back(std::move(item));
-
-    SDL_Log("Added custom decor: %s", selectedPath);
-#endif
+    if (files.empty()) {
+        return;
+    }
+    gDecorImporter.start(std::move(files));
 }
+#endif
 
 void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::path& gamePath)
 {
@@ -375,9 +511,6 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
 
     static std::filesystem::path s_loadedPath;
     if (s_loadedPath != gamePath) {
-        for (auto& it : CustomDecorList) {
-            if (it.texture) SDL_DestroyTexture(it.texture);
-        }
         CustomDecorList.clear();
 
         std::filesystem::path decorPath = gamePath / "decor";
@@ -386,23 +519,67 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
 
         SDL_Log("Scanning decor folder: %s", decorPath.string().c_str());
 
-        for (auto& entry : std::filesystem::directory_iterator(decorPath)) {
-            if (!entry.is_regular_file()) continue;
-            std::string ext = entry.path().extension().string();
-            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-            if (ext == ".png") {
-                SDL_Texture* tex = IMG_LoadTexture(renderer, entry.path().string().c_str());
-                if (!tex) continue;
-
-                CustomeDecorationList item;
-                item.name = entry.path().stem().string();
-                item.path = entry.path();
-                item.texture = tex;
-                item.operations.push_back(CustomeDecorationOperationEnum::None);
-                CustomDecorList.push_back(std::move(item));
+        DecorHashIndex hashIndex(gamePath / DecorHashIndex::FILE_NAME);
+        hashIndex.load();
+
+        std::unordered_set<std::string> seen;
+        uint64_t hashedBytes = 0;
+        size_t cachedCount = 0;
+        const auto scanStart = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration hashTime{};
+        const SDL_Point previewLimit = DecorPreviewLimit(renderer);
+
+        for (const auto& file : DecorImporter::listPngFiles(decorPath)) {
+            // Read once; the bytes feed both the hash and the decoder
+            std::string bytes;
+            if (!FileManager::readLocalFile(file, bytes)) continue;
+
+            const std::string fileName = file.filename().string();
+            const int64_t writeTime = DecorHashIndex::writeTimeOf(file);
+            uint64_t contentHash = 0;
+            if (hashIndex.lookup(fileName, bytes.size(), writeTime, contentHash)) {
+                ++cachedCount;
+            } else {
+                const auto hashStart = std::chrono::steady_clock::now();
+                contentHash = ContentHash::hash(bytes);
+                hashTime += std::chrono::steady_clock::now() - hashStart;
+                hashedBytes += bytes.size();
+                hashIndex.update(fileName, bytes.size(), writeTime, contentHash);
             }
+            seen.insert(fileName);
+
+            SDL_Texture* tex = TextureUpload::fromImage(renderer, bytes.data(), bytes.size(),
+                previewLimit.x, previewLimit.y, true);
+            if (!tex) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to load decor %s: %s", fileName.c_str(), IMG_GetError());
+                continue;
+            }
+
+            CustomeDecorationList item;
+            item.name = file.stem().string();
+            item.path = file;
+            item.texture = gTextureManager.adopt(tex, file, true);
+            item.contentHash = contentHash;
+
+            const CustomDecorCollection::Index existing = CustomDecorList.findByHash(contentHash);
+            if (existing != CustomDecorCollection::npos) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Decor '%s' is identical to '%s'",
+                    item.name.c_str(), CustomDecorList[existing].name.c_str());
+            }
+            CustomDecorList.add(std::move(item));
         }
 
+        hashIndex.retainOnly(seen);
+        hashIndex.save();
+
+        const double hashSeconds = std::chrono::duration<double>(hashTime).count();
+        SDL_Log("Decor scan: %zu files in %.2f s, hashed %.1f MB at %.0f MB/s (%zu cached)",
+            seen.size(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - scanStart).count(),
+            hashedBytes / 1048576.0,
+            hashSeconds > 0.0 ? (hashedBytes / 1048576.0) / hashSeconds : 0.0,
+            cachedCount);
+
         s_loadedPath = gamePath;
     }
 
@@ -420,21 +597,85 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.30f, 0.50f, 1.00f, 1.00f));
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.15f, 0.35f, 0.80f, 1.00f));
 
+    const bool importing = gDecorImporter.isBusy();
+    if (importing) ImGui::BeginDisabled();
+
     bool addClicked = ImGui::Button(buttonText, buttonSize);
+#if !defined(__ANDROID__)
+    ImGui::SetCursorPosX(cursorX);
+    bool addFolderClicked = ImGui::Button("Import PNG folder", buttonSize);
+#endif
+
+    if (importing) ImGui::EndDisabled();
 
     ImGui::PopStyleColor(3);
     ImGui::PopStyleVar();
 
+#if !defined(__ANDROID__)
+    PngOptimizer::Options pngOptions = gDecorImporter.pngOptions();
+    ImGui::SetCursorPosX(cursorX);
+    bool pngOptionsChanged = ImGui::Checkbox("Optimize PNG on import", &pngOptions.enabled);
+    if (pngOptions.enabled) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.0f);
+        if (ImGui::InputInt("Max size", &pngOptions.maxDimension, 64, 256)) {
+            pngOptions.maxDimension = std::clamp(pngOptions.maxDimension, 16, 8192);
+            pngOptionsChanged = true;
+        }
+    }
+    if (pngOptionsChanged) {
+        gDecorImporter.setPngOptions(pngOptions);
+    }
+#endif
+
     if (addClicked) {
         AddCustomDecorFromDialog(renderer);
     }
+#if !defined(__ANDROID__)
+    if (addFolderClicked) {
+        AddCustomDecorFolderFromDialog();
+    }
+#endif
+
+    if (importing) {
+        const DecorImporter::Progress progress = gDecorImporter.progress();
+        const size_t done = progress.imported + progress.duplicates + progress.failed;
+        const float fraction = progress.total ? static_cast<float>(done) / progress.total : 0.0f;
+
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "%zu / %zu", done, progress.total);
+
+        ImGui::Spacing();
+        ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0.0f), overlay);
+        ImGui::TextDisabled("Decoded %zu, duplicates %zu, failed %zu", progress.decoded, progress.duplicates, progress.failed);
+        if (progress.optimized > 0) {
+            ImGui::TextDisabled("Optimized %zu: %.1f KB -> %.1f KB", progress.optimized,
+                progress.bytesIn / 1024.0, progress.bytesOut / 1024.0);
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Cancel import")) {
+            gDecorImporter.cancel();
+        }
+    }
 
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
 
-    ImGui::TextWrapped("Folder: %s", gamePath.string().c_str());
+    ImGui::TextWrapped("Folder: %s", gFrameArena.pathString(gamePath));
     ImGui::TextWrapped("Loaded items: %d", (int)CustomDecorList.size());
+
+    const TextureManager::Stats textureStats = gTextureManager.stats();
+    ImGui::TextDisabled("Textures: %zu of %zu resident, %.1f / %.0f MB, hit rate %.1f%%, %llu evicted",
+        textureStats.resident, textureStats.textures,
+        textureStats.residentBytes / 1048576.0, textureStats.budgetBytes / 1048576.0,
+        textureStats.hitRate() * 100.0, static_cast<unsigned long long>(textureStats.evictions));
+
+    int budgetMB = static_cast<int>(gTextureManager.budget() / (1024 * 1024));
+    ImGui::SetNextItemWidth(160.0f);
+    if (ImGui::InputInt("Texture budget (MB)", &budgetMB, 16, 64)) {
+        gTextureManager.setBudget(static_cast<uint64_t>(std::clamp(budgetMB, 16, 4096)) * 1024 * 1024);
+    }
     ImGui::Spacing();
 
     if (CustomDecorList.empty()) {
@@ -442,10 +683,15 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
         return;
     }
 
-    int idx = 0;
-    for (size_t i = 0; i < CustomDecorList.size(); ++i) {
+    // Cancelled items leave tombstones, so indices (and ImGui IDs) stay stable
+    // for the rest of the frame; drop them here, before the loop.
+    CustomDecorList.compact();
+
+    for (size_t i = 0; i < CustomDecorList.slotCount(); ++i) {
+        if (!CustomDecorList.isAlive(i)) continue;
+
         auto& item = CustomDecorList[i];
-        ImGui::PushID(idx++);
+        ImGui::PushID(static_cast<int>(i));
 
         bool isRemoved = item.hasOperation(CustomeDecorationOperationEnum::Remove);
         bool isNew = item.hasOperation(CustomeDecorationOperationEnum::Add);
@@ -460,44 +706,44 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
 
         char buf[1024];
         std::snprintf(buf, sizeof(buf), "%s", item.name.c_str());
-        if (ImGui::InputText(("##name" + std::to_string(idx)).c_str(), buf, sizeof(buf))) {
+        if (ImGui::InputText("##name", buf, sizeof(buf))) {
             if (item.name != buf) {
-                item.name = buf;
-                item.ensureUniqueName(CustomDecorList);
-                item.addOperation(CustomeDecorationOperationEnum::Rename);
+                CustomDecorList.rename(i, buf);
             }
-
         }
 
-        ImGui::TextWrapped("Path: %s", item.path.string().c_str());
+        ImGui::TextWrapped("Path: %s", gFrameArena.pathString(item.path));
 
-        if (item.texture) {
+        const CustomDecorCollection::Index original = CustomDecorList.findByHash(item.contentHash, i);
+        if (original != CustomDecorCollection::npos && original < i) {
+            ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "Identical to '%s'", CustomDecorList[original].name.c_str());
+        }
+
+        if (SDL_Texture* texture = item.texture.get()) {
             int texW = 0, texH = 0;
-            SDL_QueryTexture(item.texture, nullptr, nullptr, &texW, &texH);
+            SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH);
             float maxWidth = 256.0f;
             float scale = (texW > 0) ? ((texW > maxWidth) ? (maxWidth / (float)texW) : 1.0f) : 1.0f;
             ImVec2 imageSize(texW * scale, texH * scale);
-            ImGui::Image((ImTextureID)(intptr_t)item.texture, imageSize);
+            ImGui::Image((ImTextureID)(intptr_t)texture, imageSize);
         }
 
         ImGui::SameLine();
 
         if (isRemoved) {
-            if (ImGui::Button(("Restore##" + std::to_string(idx)).c_str())) {
+            if (ImGui::Button("Restore")) {
                 item.restoreFromRemove();
                 SDL_Log("Restored item: %s", item.name.c_str());
 
             }
         }
         else {
-            const char* btnLabel = isNew ? "Cancel##" : "Remove##";
-            if (ImGui::Button((std::string(btnLabel) + std::to_string(idx)).c_str())) {
+            if (ImGui::Button(isNew ? "Cancel" : "Remove")) {
                 if (isNew) {
-                    if (item.texture) SDL_DestroyTexture(item.texture);
-                    CustomDecorList.erase(CustomDecorList.begin() + i);
                     SDL_Log("Canceled new item: %s", item.name.c_str());
+                    CustomDecorList.erase(i);
                     ImGui::PopID();
-                    break;
+                    continue;
                 }
                 else {
                     item.addOperation(CustomeDecorationOperationEnum::Remove);
@@ -506,16 +752,15 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
             }
         }
 
-        if (!item.operations.empty()) {
-            ImGui::TextWrapped("Operations:");
-            for (auto op : item.operations) {
-                const char* label = "";
-                switch (op) {
-                case CustomeDecorationOperationEnum::None:   label = "None"; break;
-                case CustomeDecorationOperationEnum::Add:    label = "Add"; break;
-                case CustomeDecorationOperationEnum::Remove: label = "Remove"; break;
-                case CustomeDecorationOperationEnum::Rename: label = "Rename"; break;
-                }
+        ImGui::TextWrapped("Operations:");
+        if (item.hasOperation(CustomeDecorationOperationEnum::None)) {
+            ImGui::SameLine();
+            ImGui::TextWrapped("[None]");
+        }
+        for (auto [op, label] : { std::pair{ CustomeDecorationOperationEnum::Add, "Add" },
+                                  std::pair{ CustomeDecorationOperationEnum::Remove, "Remove" },
+                                  std::pair{ CustomeDecorationOperationEnum::Rename, "Rename" } }) {
+            if (item.hasOperation(op)) {
                 ImGui::SameLine();
                 ImGui::TextWrapped("[%s]", label);
             }
@@ -529,6 +774,239 @@ void Game::DrawAddCustomDecorTab(SDL_Renderer* renderer, const std::filesystem::
     }
 }
 
+// Per-key UI state of the Localization tab, indexed like LocalizationList.
+// The line count only changes when the text does, so it is recounted on open
+// and on edit.
+struct LocalizationCell {
+    bool open = false;
+    int lines = 0;
+};
+static std::array<LocalizationCell, LocalizationKeyCount> gLocalizationCells;
+
+static char gLocalizationQuery[128] = "";
+static std::vector<TrigramIndex::DocId> gLocalizationResults;
+
+static int CountLines(const LocalizationText& text)
+{
+    int lines = 3;
+    for (char c : text) {
+        if (c == '\0') break;
+        if (c == '\n') lines++;
+    }
+    return lines;
+}
+
+void Game::BeginEditorFrame(SDL_Renderer* renderer)
+{
+    gFrameArena.reset();
+    gTextureManager.beginFrame();
+    MemoryTracker::setTextureBytes(gTextureManager.stats().residentBytes);
+    TaskScheduler::shared().runMainThread(gMainThreadTaskBudget);
+    gDecorImporter.pump(renderer, gTextureManager, CustomDecorList);
+}
+
+void Game::RefreshLocalization(TextFitAnalyzer& textFit)
+{
+    RebuildLocalizationIndex();
+    textFit.updateAll();
+    for (size_t i = 0; i < LocalizationKeyCount; ++i) {
+        gLocalizationCells[i].lines = CountLines(LocalizationList[i]);
+    }
+}
+
+void Game::DrawLocalizationTab(TextFitAnalyzer& textFit, float itemWidth)
+{
+    if (gLocalizationPacks.isOpen()) {
+        ImGui::SetNextItemWidth(itemWidth);
+        if (ImGui::BeginCombo("Language", gLocalizationPacks.active().c_str())) {
+            for (const std::string& language : gLocalizationPacks.languages()) {
+                const bool isActive = language == gLocalizationPacks.active();
+                if (ImGui::Selectable(language.c_str(), isActive) && !isActive
+                    && gLocalizationPacks.activate(language)) {
+                    RefreshLocalization(textFit);
+                }
+            }
+            ImGui::EndCombo();
+        }
+#if !defined(__ANDROID__)
+        ImGui::SameLine();
+        if (ImGui::Button("Import CSV/PO") && ImportLocalizationFromDialog()) {
+            RefreshLocalization(textFit);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export CSV")) {
+            ExportLocalizationFromDialog(false);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export PO")) {
+            ExportLocalizationFromDialog(true);
+        }
+#endif
+    }
+
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    if (ImGui::InputTextWithHint("##search", "Search keys and text", gLocalizationQuery, sizeof(gLocalizationQuery))) {
+        gLocalizationSearchDirty = true;
+    }
+    // Edits update the index but do not refilter, so the entry being
+    // typed into stays visible until the query changes
+    if (gLocalizationSearchDirty) {
+        gLocalizationIndex.search(gLocalizationQuery, gLocalizationResults);
+        gLocalizationSearchDirty = false;
+    }
+    if (gLocalizationQuery[0] != '\0') {
+        ImGui::TextDisabled("%zu of %zu", gLocalizationResults.size(), LocalizationKeyCount);
+    }
+
+    if (ImGui::CollapsingHeader("Text fit")) {
+        // Text areas in the game's 1280x720 layout, per font size
+        for (size_t sizeClass = 0; sizeClass < TextFitAnalyzer::s_sizeClassCount; ++sizeClass) {
+            const auto fitClass = static_cast<TextFitAnalyzer::SizeClass>(sizeClass);
+            const TextFitAnalyzer::Area& area = textFit.area(fitClass);
+            int size[2] = { area.width, area.height };
+
+            ImGui::SetNextItemWidth(itemWidth);
+            if (ImGui::InputInt2(fitClass == TextFitAnalyzer::SizeClass::Text ? "FONT_SIZE area" : "OTHER_TEXT_FONT_SIZE area", size)) {
+                textFit.setArea(fitClass, { std::max(1, size[0]), std::max(1, size[1]) });
+            }
+        }
+        if (textFit.isBusy()) {
+            ImGui::TextDisabled("Measuring...");
+        }
+    }
+    ImGui::Separator();
+
+    for (const TrigramIndex::DocId i : gLocalizationResults) {
+        LocalizationCell& cell = gLocalizationCells[i];
+        LocalizationText& value = LocalizationList[i];
+        ImGui::PushID(static_cast<int>(i));
+
+        // Key names are null-terminated literals
+        if (ImGui::Button(LocalizationKeyNames[i].data())) {
+            cell.open = !cell.open;
+            cell.lines = CountLines(value);
+        }
+
+        const TextFitAnalyzer::Result& fit = textFit.result(i);
+        if (fit.isReady && fit.overflows) {
+            const TextFitAnalyzer::Area& area = textFit.area(TextFitAnalyzer::sizeClassOf(i));
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Overflows: %d/%d px wide, %d/%d px tall (%d lines)",
+                fit.widestLine, area.width, fit.height, area.height, fit.lines);
+        }
+        if (fit.isReady && fit.missingGlyphs != 0) {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%u missing glyph(s): %s",
+                fit.missingGlyphs, fit.missingSample.c_str());
+        }
+
+        if (cell.open) {
+            float lineHeight = ImGui::GetTextLineHeight();
+            ImVec2 inputSize(-FLT_MIN, cell.lines * lineHeight);
+
+            if (ImGui::InputTextMultiline("##value", value.data(), value.size(), inputSize)) {
+                cell.lines = CountLines(value);
+                IndexLocalizationEntry(i);
+                textFit.update(i);
+                gLocalizationPacks.markDirty();
+            }
+        }
+
+        ImGui::PopID();
+        ImGui::Separator();
+    }
+}
+
+void Game::DrawFontTab(FontLoader& fontLoader, FontPreview& fontPreview, size_t& previewKey)
+{
+    for (size_t i = 0; i < FontKeyCount; ++i) {
+        const FontKey fontKey = static_cast<FontKey>(i);
+        ImGui::PushID(static_cast<int>(i));
+        ImGui::SeparatorText(FontKeyNames[i].data());
+
+        if (int* size = FontList.size(fontKey)) {
+            int temp = *size;
+
+            ImGui::SliderInt("##slider", &temp, 1, 128);
+
+            ImGui::Spacing();
+            ImGui::InputScalar(
+                "##input",
+                ImGuiDataType_S32,
+                &temp,
+                nullptr,
+                nullptr,
+                "%d",
+                ImGuiInputTextFlags_None
+            );
+
+            *size = std::clamp(temp, 1, 128);
+        }
+        else {
+            ImGui::InputTextMultiline(
+                "##text",
+                FontList.font.data(),
+                FontList.font.size(),
+                ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2)
+            );
+        }
+        ImGui::PopID();
+    }
+
+    ImGui::SeparatorText("Preview");
+    switch (fontLoader.state()) {
+    case FontLoader::State::Loading:
+        ImGui::TextDisabled("Loading %s...", gFrameArena.pathString(fontLoader.path()));
+        break;
+    case FontLoader::State::Ready:
+        ImGui::TextDisabled("%s", gFrameArena.pathString(fontLoader.path()));
+        break;
+    case FontLoader::State::Failed:
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.3f, 1.0f), "Cannot use %s, showing the embedded font",
+            gFrameArena.pathString(fontLoader.path()));
+        break;
+    default:
+        ImGui::TextDisabled("Embedded font");
+        break;
+    }
+
+    if (ImGui::BeginCombo("##previewKey", LocalizationKeyNames[previewKey].data())) {
+        for (size_t i = 0; i < LocalizationKeyCount; ++i) {
+            if (ImGui::Selectable(LocalizationKeyNames[i].data(), i == previewKey)) {
+                previewKey = i;
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    const int previewSize = TextFitAnalyzer::sizeClassOf(previewKey) == TextFitAnalyzer::SizeClass::Text
+        ? FontList.fontSize
+        : FontList.otherTextFontSize;
+    fontPreview.render(LocalizationList[previewKey].data(), previewSize, ImGui::GetContentRegionAvail().x);
+}
+
+void Game::DrawDecorTab(SDL_Renderer* renderer, const std::filesystem::path& gamePath)
+{
+    if (ImGui::BeginTabBar("Decor")) {
+
+        if (ImGui::BeginTabItem("Standart Decor")) {
+            for (size_t i = 0; i < StandartDecorList.size(); ++i) {
+                auto& item = StandartDecorList[i];
+
+                ImGui::Checkbox(item.first.c_str(), &item.second);
+            }
+            ImGui::EndTabItem();
+        }
+
+        if (ImGui::BeginTabItem("Add Custom Decor")) {
+            DrawAddCustomDecorTab(renderer, gamePath);
+            ImGui::EndTabItem();
+        }
+
+        ImGui::EndTabBar();
+    }
+}
+
 void Game::play(Window& window, Renderer& renderer) {
 
     SDL_Event event{};
@@ -563,9 +1041,14 @@ void Game::play(Window& window, Renderer& renderer) {
 
     ImGui_ImplSDL2_InitForSDLRenderer(window.getSdlWindow(), renderer.getSdlRenderer());
     ImGui_ImplSDLRenderer2_Init(renderer.getSdlRenderer());
+    InputSystem::takeOverImGuiGamepads();
+
+    const SDL_Point previewLimit = DecorPreviewLimit(renderer.getSdlRenderer());
+    gDecorImporter.setPreviewLimit(previewLimit.x, previewLimit.y);
+    gTextureManager.setRenderer(renderer.getSdlRenderer());
+    gTextureManager.setPreviewLimit(previewLimit.x, previewLimit.y);
 
     ImGui::GetIO().ConfigFlags  |= ImGuiConfigFlags_NavEnableGamepad
-                                |  ImGuiBackendFlags_HasGamepad
                                 |  ImGuiConfigFlags_NavEnableKeyboard
                                 |  ImGuiConfigFlags_IsTouchScreen;
 
@@ -574,7 +1057,7 @@ void Game::play(Window& window, Renderer& renderer) {
     if (gamePath.empty() || !std::filesystem::exists(gamePath))
     {
         MissingGameWindow missingGameWindow(window, renderer);
-        missingGameWindow.showMissingGameWindow(controllers);
+        missingGameWindow.showMissingGameWindow(input);
         return;
     }
 #if defined(__ANDROID__)
@@ -583,6 +1066,11 @@ void Game::play(Window& window, Renderer& renderer) {
     FileManager::setGamePath(gamePath);
 #endif
     FileManager::loadLocalization();
+    if (!FileManager::prefPath().empty()) {
+        gLocalizationPacks.open(FileManager::prefPath() / "localization");
+        gPresetStore.open(FileManager::prefPath() / "presets");
+    }
+    RebuildLocalizationIndex();
     FileManager::loadCustomFontSize();
     FileManager::loadDecorAssets();
 
@@ -594,6 +1082,33 @@ void Game::play(Window& window, Renderer& renderer) {
     folderWindow.setFullscreen();
     folderWindow.setPosition({0,0});
 
+    DebugOverlay debugOverlay;
+
+    TextFitAnalyzer textFit;
+    textFit.setFontSizes(FontList.fontSize, FontList.otherTextFontSize);
+    textFit.setFont(Incbin_Data(FONT_FONT_TTF), Incbin_Size(FONT_FONT_TTF));
+
+    // FONT from font.cfg, loaded in the background; until it is ready the
+    // preview and the analyzer use the embedded font
+    FontLoader fontLoader;
+    FontPreview fontPreview(renderer.getSdlRenderer());
+    std::array<char, 1024> requestedFont{};
+    size_t previewKey = static_cast<size_t>(LocalizationKey::A_START);
+
+    auto applyCustomFont = [&]() {
+        std::shared_ptr<const MappedFile> font;
+        if (fontLoader.state() == FontLoader::State::Ready) {
+            font = fontLoader.font();
+        }
+        fontPreview.setFont(font);
+        if (font) {
+            textFit.setFont(font->data(), font->size(), font);
+        }
+        else {
+            textFit.setFont(Incbin_Data(FONT_FONT_TTF), Incbin_Size(FONT_FONT_TTF));
+        }
+        };
+
     folderWindow.setContent([&]() {
 
         auto applyButtonStyle = [](bool isSelected) {
@@ -645,99 +1160,78 @@ void Game::play(Window& window, Renderer& renderer) {
         ImGui::SameLine();
         drawButton("Save/Play", Folders::SavePlay);
 
-        static std::unordered_map<std::string, bool> cellOpen;
-
         if (currentFolder == Folders::Localization) {
-            for (auto& [key, value] : LocalizationList) {
-                if (ImGui::Button(key.c_str())) {
-                    cellOpen[key] = !cellOpen[key];
-                }
-
-                if (cellOpen[key]) {
-                    int newlines = 3;
-                    for (char c : value) if (c == '\n') newlines++;
-
-                    float lineHeight = ImGui::GetTextLineHeight();
-                    ImVec2 inputSize(-FLT_MIN, newlines * lineHeight);
-
-                    ImGui::InputTextMultiline(("##" + key).c_str(), value.data(), value.size(), inputSize);
-                }
-
-                ImGui::Separator();
-            }
+            DrawLocalizationTab(textFit, buttonWidth);
         }
         else if (currentFolder == Folders::Font) {
-            for (auto& [key, value] : FontList) {
-                ImGui::SeparatorText(key.c_str());
-
-                std::visit([&](auto& val) {
-                    using T = std::decay_t<decltype(val)>;
-
-                    if constexpr (std::is_same_v<T, int>) {
-                        int temp = val;
-
-                        ImGui::SliderInt(("##slider_" + key).c_str(), &temp, 1, 128);
-
-                        ImGui::Spacing();
-                        ImGui::InputScalar(
-                            ("##input_" + key).c_str(),
-                            ImGuiDataType_S32,
-                            &temp,
-                            nullptr,
-                            nullptr,
-                            "%d",
-                            ImGuiInputTextFlags_None
-                        );
-
-                        val = std::clamp(temp, 1, 128);
-                    }
-
-                    else if constexpr (std::is_same_v<T, std::array<char, 1024>>) {
-                        ImGui::InputTextMultiline(
-                            ("##text_" + key).c_str(),
-                            val.data(),
-                            val.size(),
-                            ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2)
-                        );
-                    }
-                    }, value);
-            }
+            DrawFontTab(fontLoader, fontPreview, previewKey);
         }
         else if (currentFolder == Folders::Decor) {
-            if (ImGui::BeginTabBar("Decor")) {
+            DrawDecorTab(renderer.getSdlRenderer(), gamePath);
+        }
+        else if (currentFolder == Folders::SavePlay)
+        {
+            ImVec2 windowSize = ImGui::GetWindowSize();
 
-                if (ImGui::BeginTabItem("Standart Decor")) {
-                    for (size_t i = 0; i < StandartDecorList.size(); ++i) {
-                        auto& item = StandartDecorList[i];
+            float buttonWidth = screenSize.x * 0.5f;
+            float buttonHeight = screenSize.y * 0.2f;
+            float spacing = screenSize.y * 0.02f;
 
-                        ImGui::Checkbox(item.first.c_str(), &item.second);
+            if (gPresetStore.isOpen()) {
+                static char presetName[64] = "";
+                static int selectedPreset = -1;
+                static char presetStatus[256] = "";
+                const std::vector<std::string>& presets = gPresetStore.names();
+                if (selectedPreset >= static_cast<int>(presets.size())) selectedPreset = -1;
+
+                ImGui::SeparatorText("Presets");
+                ImGui::SetNextItemWidth(buttonWidth * 0.5f);
+                if (ImGui::BeginCombo("##preset", selectedPreset >= 0 ? presets[selectedPreset].c_str() : "Select a preset")) {
+                    for (int i = 0; i < static_cast<int>(presets.size()); ++i) {
+                        if (ImGui::Selectable(presets[i].c_str(), i == selectedPreset)) {
+                            selectedPreset = i;
+                            std::snprintf(presetName, sizeof(presetName), "%s", presets[i].c_str());
+                        }
                     }
-                    ImGui::EndTabItem();
+                    ImGui::EndCombo();
                 }
 
-                if (ImGui::BeginTabItem("Add Custom Decor")) {
-                    DrawAddCustomDecorTab(renderer.getSdlRenderer(), gamePath);
-                    ImGui::EndTabItem();
+                ImGui::BeginDisabled(selectedPreset < 0);
+                ImGui::SameLine();
+                if (ImGui::Button("Apply") && ApplyPreset(presets[selectedPreset], gamePath, presetStatus, sizeof(presetStatus))) {
+                    RefreshLocalization(textFit);
                 }
+                ImGui::SameLine();
+                if (ImGui::Button("Delete") && gPresetStore.remove(presets[selectedPreset])) {
+                    selectedPreset = -1;
+                }
+                ImGui::EndDisabled();
 
+                ImGui::SetNextItemWidth(buttonWidth * 0.5f);
+                ImGui::InputTextWithHint("##preset_name", "Preset name", presetName, sizeof(presetName));
+                ImGui::BeginDisabled(!PresetStore::isValidName(presetName));
+                ImGui::SameLine();
+                if (ImGui::Button("Save preset")) {
+                    const bool saved = gPresetStore.save(presetName);
+                    std::snprintf(presetStatus, sizeof(presetStatus), saved ? "Saved '%s'" : "Could not save '%s'", presetName);
+                    const auto it = std::find(presets.begin(), presets.end(), presetName);
+                    selectedPreset = it == presets.end() ? -1 : static_cast<int>(it - presets.begin());
+                }
+                ImGui::EndDisabled();
 
-                ImGui::EndTabBar();
+                if (presetStatus[0] != '\0') {
+                    ImGui::TextDisabled("%s", presetStatus);
+                }
             }
-        }
-        else if (currentFolder == Folders::SavePlay)
-        {
-            ImVec2 windowSize = ImGui::GetWindowSize();
-
-            float buttonWidth = screenSize.x * 0.5f;
-            float buttonHeight = screenSize.y * 0.2f;
-            float spacing = screenSize.y * 0.02f;
 
             float totalHeight = buttonHeight * 3 + spacing * 2;
             float startX = (windowSize.x - buttonWidth) * 0.5f;
-            float startY = (windowSize.y - totalHeight) * 0.5f;
+            // Below the presets when the window is too short to center
+            float startY = std::max((windowSize.y - totalHeight) * 0.5f, ImGui::GetCursorPosY() + spacing);
 
             ImGui::SetCursorPos(ImVec2(startX, startY));
             if (ImGui::Button("Save", ImVec2(buttonWidth, buttonHeight))) {
+                gLocalizationPacks.flush();
                 FileManager::updateAllConfigFiles();
                 FileManager::processCustomDecorations(gamePath);
             }
@@ -749,6 +1243,7 @@ void Game::play(Window& window, Renderer& renderer) {
 
             ImGui::SetCursorPos(ImVec2(startX, startY + (buttonHeight + spacing) * 2));
             if (ImGui::Button("Save and Play", ImVec2(buttonWidth, buttonHeight))) {
+                gLocalizationPacks.flush();
                 FileManager::updateAllConfigFiles();
                 FileManager::processCustomDecorations(gamePath);
                 launchGame();
@@ -758,36 +1253,108 @@ void Game::play(Window& window, Renderer& renderer) {
         });
 
     while (isRunning) {
-        ProcessSDLEvents(isRunning, controllers);
+        TRACE_ZONE("Frame");
+        {
+            TRACE_ZONE("Events");
+            input.processEvents(isRunning);
+        }
 #if defined(__ANDROID__)
         ProcessPendingDecorations(renderer.getSdlRenderer());
 #endif
-        if (!controllers.empty())
-            UpdateGamepadNavigation(ImGui::GetIO(), controllers[0]);
-
-        if (ImGui::GetIO().WantTextInput)
-        {
-            SDL_StartTextInput();
+        MemoryTracker::beginFrame();
+        BeginEditorFrame(renderer.getSdlRenderer());
+        // A changed FONT is reloaded once it is no longer being typed in
+        if (!ImGui::GetIO().WantTextInput && std::strcmp(requestedFont.data(), FontList.font.data()) != 0) {
+            requestedFont = FontList.font;
+            const std::string fontPath = FileManager::resolveCustomFontPath(requestedFont.data());
+            if (fontPath.empty()) {
+                fontLoader.reset();
+                applyCustomFont();
+            }
+            else {
+                fontLoader.load(fontPath);
+            }
         }
-        else
-        {
-            SDL_StopTextInput();
+        if (fontLoader.pump()) {
+            applyCustomFont();
         }
+        textFit.setFontSizes(FontList.fontSize, FontList.otherTextFontSize);
+        input.updateTextInput(ImGui::GetIO());
 
-        renderer.setDrawColor({ 0x00, 0x00, 0x00, SDL_ALPHA_OPAQUE });
-        renderer.clear();
+        {
+            TRACE_ZONE("ImGui build");
+            ImGui_ImplSDLRenderer2_NewFrame();
+            ImGui_ImplSDL2_NewFrame();
+            InputSystem::markImGuiGamepads(ImGui::GetIO());
+            if (input.recording().isActive()) {
+                ImGui::GetIO().DeltaTime = InputRecording::s_frameSeconds;
+            }
+            ImGui::NewFrame();
 
-        ImGui_ImplSDLRenderer2_NewFrame();
-        ImGui_ImplSDL2_NewFrame();
-        ImGui::NewFrame();
+            folderWindow.render();
+            debugOverlay.render();
 
-        folderWindow.render();
+            ImGui::Render();
+        }
+        // Nothing changed since the frame on screen: it stays there as it is
+        if (FrameSkip::shouldDraw(ImGui::GetDrawData())) {
+            {
+                TRACE_ZONE("ImGui draw");
+                renderer.setDrawColor({ 0x00, 0x00, 0x00, SDL_ALPHA_OPAQUE });
+                renderer.clear();
+                ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer.getSdlRenderer());
+            }
+            renderer.present();
+        }
+        else {
+            LatencyTracker::skipPresent();
+        }
+        // A replay runs flat out; its wall time is the benchmark
+        if (input.recording().mode() != InputRecording::Mode::Replaying) {
+            SDL_Delay(16);
+        }
+    }
 
-        ImGui::Render();
-        ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer.getSdlRenderer());
+    gDecorImporter.cancel();
+    gTextureManager.shutdown();
+    gLocalizationPacks.flush();
 
-        renderer.present();
-        SDL_Delay(16);
+    if (MemoryTracker::isEnabled() && !FileManager::prefPath().empty()) {
+        MemoryTracker::writeReport(FileManager::prefPath() / "memory_report.json");
+    }
+
+    const FrameSkip::Stats frames = FrameSkip::stats();
+    const uint64_t frameCount = frames.drawn + frames.skipped;
+    SDL_Log("Frames: %llu drawn, %llu skipped (%.1f%%)", static_cast<unsigned long long>(frames.drawn),
+        static_cast<unsigned long long>(frames.skipped), frameCount > 0 ? 100.0 * frames.skipped / frameCount : 0.0);
+
+    const LatencyTracker::Snapshot& latency = LatencyTracker::snapshot();
+    for (std::size_t kind = 0; kind < LatencyTracker::s_kindCount; ++kind) {
+        const LatencyTracker::Histogram& histogram = latency.total[kind];
+        if (histogram.count > 0) {
+            SDL_Log("Input latency %s: %llu samples, p50 %.0f ms, p95 %.0f ms, p99 %.0f ms, max %.1f ms",
+                LatencyTracker::kindName(static_cast<InputKind>(kind)),
+                static_cast<unsigned long long>(histogram.count), histogram.percentile(0.50),
+                histogram.percentile(0.95), histogram.percentile(0.99), histogram.maxMs);
+        }
+    }
+    for (std::size_t stage = 0; stage < LatencyTracker::s_stageCount; ++stage) {
+        const LatencyTracker::Histogram& histogram = latency.stages[stage];
+        if (histogram.count > 0) {
+            SDL_Log("Input latency stage %s: mean %.2f ms, p50 %.0f ms, p95 %.0f ms, max %.1f ms",
+                LatencyTracker::stageName(static_cast<LatencyTracker::Stage>(stage)), histogram.meanMs(),
+                histogram.percentile(0.50), histogram.percentile(0.95), histogram.maxMs);
+        }
+    }
+    // A replay is the headless harness: its report goes next to the recording,
+    // so runs before and after a pacing change can be compared side by side
+    if (input.recording().mode() == InputRecording::Mode::Replaying) {
+        std::filesystem::path reportPath = input.recording().path();
+        reportPath += ".latency.json";
+        LatencyTracker::writeReport(reportPath);
+    }
+    else if (!FileManager::prefPath().empty()) {
+        LatencyTracker::writeReport(FileManager::prefPath() / "latency_report.json");
     }
 
     ImGui_ImplSDLRenderer2_Shutdown();
@@ -797,10 +1364,7 @@ void Game::play(Window& window, Renderer& renderer) {
 
 
 Game::~Game() {
-    for (auto controller : controllers) {
-        SDL_GameControllerClose(controller);
-    }
-    controllers.clear();
+    input.closeControllers();
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
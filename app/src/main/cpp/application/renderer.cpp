@@ -1,4 +1,6 @@
 #include <application/renderer.hpp>
+#include <utils/latency_tracker.hpp>
+#include <utils/trace.hpp>
 
 Renderer::Renderer(const Window& window) :
     m_sdlRenderer(SDL_CreateRenderer(
@@ -76,5 +78,8 @@ void Renderer::clear() const {
 }
 
 void Renderer::present() const {
+    TRACE_ZONE("Present");
+    LatencyTracker::beginPresent();
     SDL_RenderPresent(m_sdlRenderer);
+    LatencyTracker::endPresent();
 }
@@ -15,6 +15,18 @@
         ) \
     )
 
+#define Incbin_Data(NAME) \
+    INCBIN_CONCATENATE( \
+        INCBIN_CONCATENATE(INCBIN_PREFIX, NAME), \
+        INCBIN_STYLE_IDENT(DATA) \
+    )
+
+#define Incbin_Size(NAME) \
+    INCBIN_CONCATENATE( \
+        INCBIN_CONCATENATE(INCBIN_PREFIX, NAME), \
+        INCBIN_STYLE_IDENT(SIZE) \
+    )
+
 #define FONT_FONT_TTF FONT_FONT_TTF
 #define ICON_BMP ICON_BMP
 #define ICON_ICO ICON_ICO
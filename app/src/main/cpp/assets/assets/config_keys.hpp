@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Keys understood by the game's config files. The enum value of a key is also
+// its index in the matching table in data.hpp.
+#define LOCALIZATION_KEYS(X) \
+    X(LOADING_TEXT)          \
+    X(ENDLESS_MODE)          \
+    X(IDLE)                  \
+    X(A_START)               \
+    X(B_START)               \
+    X(C_START)               \
+    X(D_START)               \
+    X(E_START)               \
+    X(F_START)               \
+    X(G_START)               \
+    X(H_START)               \
+    X(I_START)               \
+    X(J_START)               \
+    X(K_START)               \
+    X(L_START)               \
+    X(M_START)               \
+    X(N_START)               \
+    X(O_START)               \
+    X(P_START)               \
+    X(Q_START)               \
+    X(R_START)               \
+    X(S_START)               \
+    X(T_START)               \
+    X(FINAL_START)
+
+#define FONT_KEYS(X) \
+    X(FONT)          \
+    X(FONT_SIZE)     \
+    X(OTHER_TEXT_FONT_SIZE)
+
+#define CONFIG_KEY_ENUM(name) name,
+#define CONFIG_KEY_NAME(name) std::string_view(#name),
+
+enum class LocalizationKey : uint8_t {
+    LOCALIZATION_KEYS(CONFIG_KEY_ENUM)
+    Count
+};
+
+enum class FontKey : uint8_t {
+    FONT_KEYS(CONFIG_KEY_ENUM)
+    Count
+};
+
+constexpr std::size_t LocalizationKeyCount = static_cast<std::size_t>(LocalizationKey::Count);
+constexpr std::size_t FontKeyCount = static_cast<std::size_t>(FontKey::Count);
+
+constexpr std::array<std::string_view, LocalizationKeyCount> LocalizationKeyNames = {
+    LOCALIZATION_KEYS(CONFIG_KEY_NAME)
+};
+
+constexpr std::array<std::string_view, FontKeyCount> FontKeyNames = {
+    FONT_KEYS(CONFIG_KEY_NAME)
+};
+
+#undef CONFIG_KEY_ENUM
+#undef CONFIG_KEY_NAME
+
+// Collision-free string -> index map, built at compile time. The seed search
+// tries FNV-1a variants until every key lands in its own slot, so a lookup is
+// one hash, one table read and one string compare.
+template <std::size_t N>
+class PerfectHash {
+public:
+    static constexpr std::size_t TableSize = [] {
+        std::size_t size = 1;
+        while (size < N * 2) size <<= 1;
+        return size;
+    }();
+    static constexpr uint8_t EmptySlot = 0xFF;
+    static constexpr int NotFound = -1;
+
+    static_assert(N < EmptySlot, "PerfectHash stores indices as uint8_t");
+
+    constexpr explicit PerfectHash(const std::array<std::string_view, N>& keys) :
+        m_keys(keys)
+    {
+        for (uint32_t seed = 1; seed < s_maxSeed; ++seed) {
+            if (tryBuild(seed)) {
+                m_seed = seed;
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr bool isValid() const { return m_seed != 0; }
+    [[nodiscard]] constexpr uint32_t seed() const { return m_seed; }
+
+    // Index of `key`, or NotFound for keys the table was not built with.
+    [[nodiscard]] constexpr int find(std::string_view key) const {
+        const uint8_t slot = m_slots[hash(m_seed, key) & (TableSize - 1)];
+        if (slot == EmptySlot || m_keys[slot] != key) {
+            return NotFound;
+        }
+        return slot;
+    }
+
+private:
+    static constexpr uint32_t s_maxSeed = 1u << 16;
+
+    static constexpr uint32_t hash(uint32_t seed, std::string_view key) {
+        uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : key) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    constexpr bool tryBuild(uint32_t seed) {
+        for (auto& slot : m_slots) slot = EmptySlot;
+
+        for (std::size_t i = 0; i < N; ++i) {
+            uint8_t& slot = m_slots[hash(seed, m_keys[i]) & (TableSize - 1)];
+            if (slot != EmptySlot) {
+                return false;
+            }
+            slot = static_cast<uint8_t>(i);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> m_keys;
+    std::array<uint8_t, TableSize> m_slots{};
+    uint32_t m_seed = 0;
+};
+
+constexpr PerfectHash<LocalizationKeyCount> LocalizationKeyHash(LocalizationKeyNames);
+constexpr PerfectHash<FontKeyCount> FontKeyHash(FontKeyNames);
+
+static_assert(LocalizationKeyHash.isValid(), "No collision-free seed for the localization keys");
+static_assert(FontKeyHash.isValid(), "No collision-free seed for the font keys");
+static_assert(LocalizationKeyHash.find("FINAL_START") == static_cast<int>(LocalizationKey::FINAL_START));
+static_assert(FontKeyHash.find("FONT_SIZE") == static_cast<int>(FontKey::FONT_SIZE));
+static_assert(FontKeyHash.find("FONT_") == PerfectHash<FontKeyCount>::NotFound);
+
+inline const char* keyName(LocalizationKey key) {
+    return LocalizationKeyNames[static_cast<std::size_t>(key)].data();
+}
+
+inline const char* keyName(FontKey key) {
+    return FontKeyNames[static_cast<std::size_t>(key)].data();
+}
@@ -3,10 +3,10 @@
 #include <array>
 #include <vector>
 #include <string>
-#include <variant>
 #include <filesystem>
 #include <algorithm>
 #include <SDL_image.h>
+#include <assets/config_keys.hpp>
 
 enum class Folders {
     Localization,
@@ -49,163 +49,36 @@ Touchscreen:
 )"
 );
 
-#define MAKE_ENTRY(key, text) { key, [](){ std::array<char,1024> arr{}; strncpy(arr.data(), text, arr.size() - 1); return arr; }() }
+using LocalizationText = std::array<char, 1024>;
 
-extern std::vector<std::pair<std::string, std::array<char, 1024>>> LocalizationStandartList;
-extern std::vector<std::pair<std::string, std::array<char, 1024>>> LocalizationList;
+// Indexed by LocalizationKey
+extern const std::array<LocalizationText, LocalizationKeyCount> LocalizationStandartList;
+extern std::array<LocalizationText, LocalizationKeyCount> LocalizationList;
 
-extern std::vector<std::pair<std::string, std::variant<int, std::array<char, 1024>>>> FontList;
+inline LocalizationText& localizationText(LocalizationKey key) {
+    return LocalizationList[static_cast<size_t>(key)];
+}
 
-extern std::vector<std::pair<std::string, bool>> StandartDecorList;
-enum class CustomeDecorationOperationEnum {
-    None,
-    Add,
-    Remove,
-    Rename
-}; 
-struct CustomeDecorationList {
-    std::string name;
-    SDL_Texture* texture = nullptr;
-    std::filesystem::path path;
-    std::vector<CustomeDecorationOperationEnum> operations;
-    std::vector<CustomeDecorationOperationEnum> prevOperations;
-
-    bool hasOperation(CustomeDecorationOperationEnum op) const {
-        return std::find(operations.begin(), operations.end(), op) != operations.end();
-    }
-
-    void addOperation(CustomeDecorationOperationEnum op) {
-        if (hasOperation(CustomeDecorationOperationEnum::Remove)) {
-            if (op != CustomeDecorationOperationEnum::Remove &&
-                op != CustomeDecorationOperationEnum::None)
-            {
-                prevOperations.erase(
-                    std::remove(prevOperations.begin(), prevOperations.end(), CustomeDecorationOperationEnum::None),
-                    prevOperations.end()
-                );
-
-                if (std::find(prevOperations.begin(), prevOperations.end(), op) == prevOperations.end()) {
-                    prevOperations.push_back(op);
-                    SDL_Log("Queued operation %d for removed decor '%s'", (int)op, name.c_str());
-                }
-            }
+struct FontSettings {
+    std::array<char, 1024> font{};   // FONT
+    int fontSize = 24;               // FONT_SIZE
+    int otherTextFontSize = 48;      // OTHER_TEXT_FONT_SIZE
 
-            if (op == CustomeDecorationOperationEnum::None) {
-                operations.clear();
-                operations.push_back(CustomeDecorationOperationEnum::None);
-                prevOperations.clear();
-                SDL_Log("Cleared operations for removed decor '%s'", name.c_str());
-            }
-
-            return;
-        }
-
-        if (op == CustomeDecorationOperationEnum::Remove) {
-            prevOperations = operations;
-            prevOperations.erase(
-                std::remove(prevOperations.begin(), prevOperations.end(),
-                    CustomeDecorationOperationEnum::Remove),
-                prevOperations.end()
-            );
-
-            operations.clear();
-            operations.push_back(CustomeDecorationOperationEnum::Remove);
-            SDL_Log("Marked decor '%s' for removal", name.c_str());
-            return;
-        }
-
-        if (op != CustomeDecorationOperationEnum::None) {
-            operations.erase(
-                std::remove(operations.begin(), operations.end(), CustomeDecorationOperationEnum::None),
-                operations.end()
-            );
-        }
-
-        if (op == CustomeDecorationOperationEnum::None) {
-            operations.clear();
-            operations.push_back(CustomeDecorationOperationEnum::None);
-            SDL_Log("Reset operations for '%s'", name.c_str());
-            return;
-        } 
-        
-        std::string originalName = path.stem().string();
-        if (name == originalName && hasOperation(CustomeDecorationOperationEnum::Rename)) {
-            operations.erase(
-                std::remove(operations.begin(), operations.end(), CustomeDecorationOperationEnum::Rename),
-                operations.end()
-            );
-            SDL_Log("Removed rename flag: '%s' reverted to original name", name.c_str());
-
-            if (operations.empty()) {
-                operations.push_back(CustomeDecorationOperationEnum::None);
-            }
-            return;
-        }
-
-        if (!hasOperation(op)) {
-            operations.push_back(op);
-            SDL_Log("Added operation %d for '%s'", (int)op, name.c_str());
+    // Size field behind a size key, nullptr for FONT.
+    int* size(FontKey key) {
+        switch (key) {
+        case FontKey::FONT_SIZE: return &fontSize;
+        case FontKey::OTHER_TEXT_FONT_SIZE: return &otherTextFontSize;
+        default: return nullptr;
         }
     }
+};
 
+extern FontSettings FontList;
 
-    void restoreFromRemove() {
-        if (!prevOperations.empty()) {
-            operations = prevOperations;
-        }
-        else {
-            operations = { CustomeDecorationOperationEnum::None };
-        }
-        prevOperations.clear();
-    }
-
-    static bool isNameTaken(const std::string& newName,
-        const std::vector<CustomeDecorationList>& list,
-        const CustomeDecorationList* self = nullptr)
-    {
-        for (const auto& deco : list) {
-            if (&deco == self) continue;
-            if (deco.name == newName)
-                return true;
-        }
-        return false;
-    }
-
-    void ensureUniqueName(std::vector<CustomeDecorationList>& list) {
-        if (name.empty()) {
-            name = "unknown";
-        }
-
-        sanitizeFileName(name);
-
-        if (!isNameTaken(name, list, this))
-            return;
-
-        std::string base = name;
-        int counter = 1;
-        std::string newName;
-
-        do {
-            newName = base + "_new";
-            if (counter > 1)
-                newName += std::to_string(counter);
-            counter++;
-        } while (isNameTaken(newName, list, this));
-
-        SDL_Log("Renamed duplicate '%s' → '%s'", name.c_str(), newName.c_str());
-        name = newName;
-        addOperation(CustomeDecorationOperationEnum::Rename);
-    }
+// Keys found in the config files that this build does not know about (e.g.
+// added by mods). Kept in file order so saving writes them back untouched.
+extern std::vector<std::pair<std::string, std::string>> UnknownLocalizationEntries;
+extern std::vector<std::pair<std::string, std::string>> UnknownFontEntries;
 
-    void sanitizeFileName(std::string& s) {
-        static const std::string invalidChars = "\\/:*?\"<>|";
-
-        for (char& c : s) {
-            if (invalidChars.find(c) != std::string::npos) {
-                c = '_';
-            }
-        }
-    }
-};
-
-extern std::vector<CustomeDecorationList> CustomDecorList;
+extern std::vector<std::pair<std::string, bool>> StandartDecorList;
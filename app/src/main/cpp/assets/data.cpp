@@ -1,39 +1,55 @@
 #include <assets/data.hpp>
+#include <cstring>
 
-std::vector<std::pair<std::string, std::array<char, 1024>>> LocalizationStandartList = {
-    MAKE_ENTRY("LOADING_TEXT", "Loading..."),
-    MAKE_ENTRY("ENDLESS_MODE", "ENDLESS MODE"),
-    MAKE_ENTRY("IDLE", IDLE_TEXT),
-    MAKE_ENTRY("A_START", "You opened your eyes, but did you see anything new?"),
-    MAKE_ENTRY("B_START", "Every day is like the one before, yet you search for differences"),
-    MAKE_ENTRY("C_START", "People chase dreams, but who said dreams hold value?"),
-    MAKE_ENTRY("D_START", "How many questions have you asked, and how many answers have you received?"),
-    MAKE_ENTRY("E_START", "The world moves in circles, but where is its beginning and where is its end?"),
-    MAKE_ENTRY("F_START", "You strive to find a purpose, but what is it even for?"),
-    MAKE_ENTRY("G_START", "Stones lie on the ground for millennia, yet you live for only a moment."),
-    MAKE_ENTRY("H_START", "What matters more: your thoughts or the sound of the wind?"),
-    MAKE_ENTRY("I_START", "The history of the world is full of heroes, but no one remembers them."),
-    MAKE_ENTRY("J_START", "If something disappears tomorrow, what changes today?"),
-    MAKE_ENTRY("K_START", "The sun rises every day, but not for you."),
-    MAKE_ENTRY("L_START", "Your heart beats, but who cares?"),
-    MAKE_ENTRY("M_START", "Everything you build will one day turn to dust."),
-    MAKE_ENTRY("N_START", "You search for truth, but in this world, there is no law of truth."),
-    MAKE_ENTRY("O_START", "You search for gods, but there are none."),
-    MAKE_ENTRY("P_START", "Joy and pain alternate, but both eventually fade."),
-    MAKE_ENTRY("Q_START", "You want to be needed, but by whom?"),
-    MAKE_ENTRY("R_START", "The stars shine, but not to show you the way."),
-    MAKE_ENTRY("S_START", "Eternity is a word that both frightens and frees."),
-    MAKE_ENTRY("T_START", "In this chaos, you seek meaning, but chaos demands no explanation."),
-    MAKE_ENTRY("FINAL_START", "THE UNIVERSE DOESN'T MAKE SENSE.")
-};
+namespace {
+    const char* localizationDefault(LocalizationKey key) {
+        switch (key) {
+        case LocalizationKey::LOADING_TEXT: return "Loading...";
+        case LocalizationKey::ENDLESS_MODE: return "ENDLESS MODE";
+        case LocalizationKey::IDLE: return IDLE_TEXT;
+        case LocalizationKey::A_START: return "You opened your eyes, but did you see anything new?";
+        case LocalizationKey::B_START: return "Every day is like the one before, yet you search for differences";
+        case LocalizationKey::C_START: return "People chase dreams, but who said dreams hold value?";
+        case LocalizationKey::D_START: return "How many questions have you asked, and how many answers have you received?";
+        case LocalizationKey::E_START: return "The world moves in circles, but where is its beginning and where is its end?";
+        case LocalizationKey::F_START: return "You strive to find a purpose, but what is it even for?";
+        case LocalizationKey::G_START: return "Stones lie on the ground for millennia, yet you live for only a moment.";
+        case LocalizationKey::H_START: return "What matters more: your thoughts or the sound of the wind?";
+        case LocalizationKey::I_START: return "The history of the world is full of heroes, but no one remembers them.";
+        case LocalizationKey::J_START: return "If something disappears tomorrow, what changes today?";
+        case LocalizationKey::K_START: return "The sun rises every day, but not for you.";
+        case LocalizationKey::L_START: return "Your heart beats, but who cares?";
+        case LocalizationKey::M_START: return "Everything you build will one day turn to dust.";
+        case LocalizationKey::N_START: return "You search for truth, but in this world, there is no law of truth.";
+        case LocalizationKey::O_START: return "You search for gods, but there are none.";
+        case LocalizationKey::P_START: return "Joy and pain alternate, but both eventually fade.";
+        case LocalizationKey::Q_START: return "You want to be needed, but by whom?";
+        case LocalizationKey::R_START: return "The stars shine, but not to show you the way.";
+        case LocalizationKey::S_START: return "Eternity is a word that both frightens and frees.";
+        case LocalizationKey::T_START: return "In this chaos, you seek meaning, but chaos demands no explanation.";
+        case LocalizationKey::FINAL_START: return "THE UNIVERSE DOESN'T MAKE SENSE.";
+        case LocalizationKey::Count: break;
+        }
+        return "";
+    }
 
-std::vector<std::pair<std::string, std::array<char, 1024>>> LocalizationList = LocalizationStandartList;
+    std::array<LocalizationText, LocalizationKeyCount> makeStandartList() {
+        std::array<LocalizationText, LocalizationKeyCount> list{};
+        for (size_t i = 0; i < list.size(); ++i) {
+            strncpy(list[i].data(), localizationDefault(static_cast<LocalizationKey>(i)), list[i].size() - 1);
+        }
+        return list;
+    }
+}
 
-std::vector<std::pair<std::string, std::variant<int, std::array<char, 1024>>>> FontList = {
-    {"FONT", std::array<char, 1024>{""}},
-    {"FONT_SIZE", 24},
-    {"OTHER_TEXT_FONT_SIZE", 48}
-};
+const std::array<LocalizationText, LocalizationKeyCount> LocalizationStandartList = makeStandartList();
+
+std::array<LocalizationText, LocalizationKeyCount> LocalizationList = LocalizationStandartList;
+
+FontSettings FontList;
+
+std::vector<std::pair<std::string, std::string>> UnknownLocalizationEntries;
+std::vector<std::pair<std::string, std::string>> UnknownFontEntries;
 
 std::vector<std::pair<std::string, bool>> StandartDecorList = {
     {"grass", true},
@@ -45,5 +61,3 @@ std::vector<std::pair<std::string, bool>> StandartDecorList = {
     {"smallrock2", true},
     {"smallrock3", true} 
 };
-
-std::vector<CustomeDecorationList> CustomDecorList;
\ No newline at end of file
@@ -13,6 +13,7 @@ set(MODULE_SOURCES
 set(MODULE_HEADERS
     ${INCLUDE_DIR}/assets.hpp
     ${INCLUDE_DIR}/data.hpp
+    ${INCLUDE_DIR}/config_keys.hpp
 )
 
 if(MSVC)
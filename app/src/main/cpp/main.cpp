@@ -1,13 +1,54 @@
 ﻿#include <cstdlib>
 #include <application/game.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/trace.hpp>
+#include <SDL.h>
+#include <cstring>
 
 
-int main(int, char*[]) {
+int main(int argc, char* argv[]) {
+    MemoryTracker::install();
+
+    // --record <file> saves the session's input; --replay <file> plays it
+    // back headless, on the dummy video driver unless SDL_VIDEODRIVER says otherwise,
+    // and writes its input latency report to <file>.latency.json.
+    // --trace <file> writes a Chrome trace of the whole run.
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* tracePath = nullptr;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--record") == 0) {
+            recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0) {
+            replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[++i];
+        }
+    }
+    Trace::setThreadName("Render");
+    if (tracePath) {
+        Trace::start(tracePath);
+    }
+    if (replayPath) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        // The renderer asks for acceleration, which the dummy driver has none of
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+
     Game game = Game();
 
     if(game.isInit()) {
+        if (replayPath && !Game::replayInput(replayPath)) {
+            return EXIT_FAILURE;
+        }
+        if (!replayPath && recordPath) {
+            Game::recordInput(recordPath);
+        }
         game.run();
     }
 
+    Trace::stop();
     return EXIT_SUCCESS;
 }
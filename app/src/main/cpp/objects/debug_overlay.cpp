@@ -0,0 +1,149 @@
+#include <objects/debug_overlay.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/task_scheduler.hpp>
+#include <utils/latency_tracker.hpp>
+#include <utils/frame_skip.hpp>
+#include <array>
+
+namespace {
+    double toMB(uint64_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    // The histogram plot stops here; slower samples are in the table's max
+    constexpr std::size_t s_plottedMs = 64;
+
+    void latencyRow(const char* name, const LatencyTracker::Histogram& histogram) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(histogram.count));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.0f", histogram.percentile(0.50));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.0f", histogram.percentile(0.95));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.0f", histogram.percentile(0.99));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", histogram.maxMs);
+    }
+
+    void renderLatency() {
+        const LatencyTracker::Snapshot& latency = LatencyTracker::snapshot();
+
+        ImGui::Separator();
+        ImGui::Text("Input to present (ms), %llu presents", static_cast<unsigned long long>(latency.presents));
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Reset##latency")) {
+            LatencyTracker::reset();
+            return;
+        }
+
+        if (ImGui::BeginTable("##latency", 6, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Input");
+            ImGui::TableSetupColumn("Samples");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t kind = 0; kind < LatencyTracker::s_kindCount; ++kind) {
+                latencyRow(LatencyTracker::kindName(static_cast<InputKind>(kind)), latency.total[kind]);
+            }
+            for (std::size_t stage = 0; stage < LatencyTracker::s_stageCount; ++stage) {
+                latencyRow(LatencyTracker::stageName(static_cast<LatencyTracker::Stage>(stage)), latency.stages[stage]);
+            }
+            ImGui::EndTable();
+        }
+
+        // All kinds together
+        std::array<float, s_plottedMs> plot{};
+        for (const LatencyTracker::Histogram& histogram : latency.total) {
+            for (std::size_t ms = 0; ms < s_plottedMs; ++ms) {
+                plot[ms] += static_cast<float>(histogram.buckets[ms]);
+            }
+        }
+        ImGui::PlotHistogram("##latency_plot", plot.data(), static_cast<int>(plot.size()), 0,
+            "0-64 ms", 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+    }
+}
+
+void DebugOverlay::render() {
+    if (ImGui::IsKeyPressed(ImGuiKey_F3, false)) {
+        toggle();
+    }
+    if (!m_isVisible) {
+        return;
+    }
+
+    const MemoryTracker::Snapshot stats = MemoryTracker::snapshot();
+
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    ImGui::SetNextWindowPos(ImVec2(displaySize.x - 10.0f, 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.75f);
+
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration
+                                 | ImGuiWindowFlags_AlwaysAutoResize
+                                 | ImGuiWindowFlags_NoSavedSettings
+                                 | ImGuiWindowFlags_NoFocusOnAppearing
+                                 | ImGuiWindowFlags_NoNav;
+
+    if (ImGui::Begin("##debug_overlay", nullptr, flags)) {
+        // The counters below change every frame; left in the fingerprint they
+        // would keep FrameSkip from skipping anything while the overlay is up.
+        // Under the mouse they are kept in, so the Reset button responds.
+        if (!ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows)) {
+            FrameSkip::excludeDrawList(ImGui::GetWindowDrawList());
+        }
+        ImGui::Text("Frame %llu", static_cast<unsigned long long>(stats.frames));
+        ImGui::Text("Peak RSS: %.1f MB", toMB(stats.peakRssBytes));
+        ImGui::Text("Decor textures: %.1f MB", toMB(stats.textureBytes));
+
+        const TaskScheduler& scheduler = TaskScheduler::shared();
+        const TaskScheduler::Stats tasks = scheduler.stats();
+        ImGui::Text("Tasks: %u workers, %llu run, %llu stolen, %llu cancelled", scheduler.workerCount(),
+            static_cast<unsigned long long>(tasks.executed), static_cast<unsigned long long>(tasks.stolen),
+            static_cast<unsigned long long>(tasks.cancelled));
+
+        const FrameSkip::Stats frames = FrameSkip::stats();
+        ImGui::Text("Frames: %llu drawn, %llu skipped", static_cast<unsigned long long>(frames.drawn),
+            static_cast<unsigned long long>(frames.skipped));
+
+        if (!MemoryTracker::isEnabled()) {
+            ImGui::TextDisabled("Allocation tracking is off (SENSE_MEMORY_TRACKING)");
+        }
+        else {
+            ImGui::Text("Allocations last frame: %llu (%.1f KB), max %llu",
+                static_cast<unsigned long long>(stats.frameAllocations), stats.frameBytes / 1024.0,
+                static_cast<unsigned long long>(stats.maxFrameAllocations));
+            ImGui::Text("Live: %.1f MB, peak %.1f MB", toMB(stats.liveBytes), toMB(stats.peakLiveBytes));
+
+            if (ImGui::BeginTable("##memory_tags", 4, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Subsystem");
+                ImGui::TableSetupColumn("Live MB");
+                ImGui::TableSetupColumn("Peak MB");
+                ImGui::TableSetupColumn("Allocations");
+                ImGui::TableHeadersRow();
+
+                for (std::size_t tag = 0; tag < MemoryTracker::s_tagCount; ++tag) {
+                    const MemoryTracker::TagStats& tagStats = stats.tags[tag];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(MemoryTracker::tagName(static_cast<MemoryTag>(tag)));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", toMB(tagStats.liveBytes));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", toMB(tagStats.peakLiveBytes));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(tagStats.allocations));
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        renderLatency();
+    }
+    ImGui::End();
+}
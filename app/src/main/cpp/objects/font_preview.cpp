@@ -0,0 +1,74 @@
+#include <objects/font_preview.hpp>
+#include <utils/frame_skip.hpp>
+#include <imgui.h>
+#include <cstring>
+
+FontPreview::FontPreview(SDL_Renderer* renderer) :
+    m_renderer(renderer),
+    m_text(renderer, 24, { 0, 0 })
+{
+    m_text.positionCenter();
+}
+
+FontPreview::~FontPreview() {
+    if (m_target) {
+        SDL_DestroyTexture(m_target);
+    }
+}
+
+void FontPreview::setFont(std::shared_ptr<const MappedFile> font) {
+    m_text.setCustomFont(std::move(font));
+    m_isDirty = true;
+}
+
+bool FontPreview::ensureTarget(int width, int height) {
+    if (m_target && m_targetSize.x == width && m_targetSize.y == height) {
+        return true;
+    }
+    if (m_target) {
+        SDL_DestroyTexture(m_target);
+    }
+
+    m_target = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!m_target) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Font preview unavailable: %s", SDL_GetError());
+        return false;
+    }
+    m_targetSize = { width, height };
+    m_isDirty = true;
+    return true;
+}
+
+void FontPreview::render(const char* text, int fontSize, float width) {
+    const int targetWidth = static_cast<int>(width);
+    const int targetHeight = targetWidth * 9 / 16;
+    if (targetWidth <= 0 || !SDL_RenderTargetSupported(m_renderer) || !ensureTarget(targetWidth, targetHeight)) {
+        return;
+    }
+
+    if (fontSize != m_drawnSize) {
+        m_text.resize(fontSize);
+        m_drawnSize = fontSize;
+        m_isDirty = true;
+    }
+    if (m_drawnText != text) {
+        m_drawnText = text;
+        m_text.setText(m_drawnText);
+        m_isDirty = true;
+    }
+
+    if (m_isDirty) {
+        // Drawn now, before ImGui renders the frame that shows it
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(m_renderer);
+        SDL_SetRenderTarget(m_renderer, m_target);
+        SDL_SetRenderDrawColor(m_renderer, 0x00, 0x00, 0x00, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(m_renderer);
+        m_text.render(m_targetSize);
+        SDL_SetRenderTarget(m_renderer, previousTarget);
+        m_isDirty = false;
+        // Same texture, new pixels: the draw data alone would not show it
+        FrameSkip::requestRedraw();
+    }
+
+    ImGui::Image((ImTextureID)(intptr_t)m_target, ImVec2(static_cast<float>(targetWidth), static_cast<float>(targetHeight)));
+}
@@ -14,7 +14,7 @@ void MissingGameWindow::shutdownImGui()
     ImGui::DestroyContext();
 }
 
-void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> controllers)
+void MissingGameWindow::showMissingGameWindow(InputSystem& input)
 {
     SDL_Event event{};
     bool isRunning = true;
@@ -27,80 +27,47 @@ void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> c
     ImGui_ImplSDLRenderer2_DestroyDeviceObjects();
     ImGui_ImplSDLRenderer2_CreateDeviceObjects();
 #else
-    m_steamRunning = SteamAPI_Init();
+    SteamStatus steamStatus(BASE_GAME_APP_ID);
+    steamStatus.start();
 #endif
 
     while (isRunning)
     {
-        ProcessSDLEvents(isRunning, controllers);
-
-        if (!controllers.empty())
-            UpdateGamepadNavigation(ImGui::GetIO(), controllers[0]);
-
-        if (ImGui::GetIO().WantTextInput)
-        {
-            SDL_StartTextInput();
-        }
-        else
-        {
-            SDL_StopTextInput();
-        }
+        input.processEvents(isRunning);
+        input.updateTextInput(ImGui::GetIO());
 
         m_renderer.setDrawColor({ 15, 15, 20, 255 });
         m_renderer.clear();
 
         ImGui_ImplSDLRenderer2_NewFrame();
         ImGui_ImplSDL2_NewFrame();
+        InputSystem::markImGuiGamepads(ImGui::GetIO());
+        if (input.recording().isActive()) {
+            ImGui::GetIO().DeltaTime = InputRecording::s_frameSeconds;
+        }
         ImGui::NewFrame();
 
         bool ownsGame = false;
         bool isInstalled = false;
 
 #if !defined(__ANDROID__)
-        if (m_steamRunning && SteamUser() && SteamApps())
-        {
-            ownsGame = SteamApps()->BIsSubscribedApp(BASE_GAME_APP_ID);
-            isInstalled = SteamApps()->BIsAppInstalled(BASE_GAME_APP_ID);
-        }
-        else
-        {
-            if (!m_steamRunning)
-                m_steamRunning = SteamAPI_Init();
-        }
+        const SteamStatus::Snapshot status = steamStatus.snapshot();
+        ownsGame = status.ownsGame;
+        isInstalled = status.isInstalled;
 #else
         ownsGame = true;
 
-        JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-        jobject activity = (jobject)SDL_AndroidGetActivity();
-        if (env && activity) {
-            jclass activityClass = env->GetObjectClass(activity);
-            jmethodID getPackageManager = env->GetMethodID(activityClass, "getPackageManager", "()Landroid/content/pm/PackageManager;");
-            jobject pm = env->CallObjectMethod(activity, getPackageManager);
-
-            jclass pmClass = env->GetObjectClass(pm);
-            jmethodID getPackageInfo = env->GetMethodID(pmClass, "getPackageInfo",
-                                                        "(Ljava/lang/String;I)Landroid/content/pm/PackageInfo;");
+        JNIEnv* env = Jni::env();
+        if (env) {
+            const Jni::Bindings& jni = Jni::bindings();
+            Jni::LocalFrame frame(env);
 
+            jobject activity = static_cast<jobject>(SDL_AndroidGetActivity());
+            jobject pm = Jni::call<jobject>(env, activity, jni.getPackageManager);
             jstring packageName = env->NewStringUTF(BASE_GAME_PKG_NAME);
 
-            jobject pkgInfo = nullptr;
-            jthrowable exc = nullptr;
-
-            pkgInfo = env->CallObjectMethod(pm, getPackageInfo, packageName, 0);
-            exc = env->ExceptionOccurred();
-
-            if (exc) {
-                env->ExceptionClear();
-                isInstalled = false;
-            } else {
-                isInstalled = true;
-            }
-
-            if (pkgInfo) env->DeleteLocalRef(pkgInfo);
-            env->DeleteLocalRef(packageName);
-            env->DeleteLocalRef(pmClass);
-            env->DeleteLocalRef(pm);
-            env->DeleteLocalRef(activityClass);
+            Jni::call<jobject>(env, pm, jni.getPackageInfo, packageName, jint(0));
+            isInstalled = pm && !Jni::clearException(env, "getPackageInfo");
         } else {
             isInstalled = false;
         }
@@ -121,7 +88,11 @@ void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> c
         ImGui::SetCursorPos(ImVec2(center.x - 200, center.y - 120));
 
 #if !defined(__ANDROID__)
-        if (!m_steamRunning)
+        if (status.generation == 0)
+        {
+            ImGui::TextColored(ImVec4(1.0f, 0.9f, 0.4f, 1.0f), "Connecting to %s...", storeName);
+        }
+        else if (!status.steamRunning)
         {
             ImGui::TextColored(ImVec4(1.0f, 0.9f, 0.4f, 1.0f),
                 "%s is not running.\nPlease start %s and restart this program.", storeName, storeName);
@@ -139,38 +110,14 @@ void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> c
                 if (ImGui::Button(openStoreButton.c_str(), btn))
                 {
 #if defined(__ANDROID__)
-                    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-                    jobject activity = (jobject)SDL_AndroidGetActivity();
-                    if (env && activity)
-                    {
-                        jclass uriClass = env->FindClass("android/net/Uri");
-                        jmethodID parse = env->GetStaticMethodID(uriClass, "parse", "(Ljava/lang/String;)Landroid/net/Uri;");
-                        jstring uriString = env->NewStringUTF(marketUri.c_str());
-                        jobject uriObj = env->CallStaticObjectMethod(uriClass, parse, uriString);
-
-                        jclass intentClass = env->FindClass("android/content/Intent");
-                        jmethodID ctor = env->GetMethodID(intentClass, "<init>", "(Ljava/lang/String;Landroid/net/Uri;)V");
-                        jstring actionView = env->NewStringUTF("android.intent.action.VIEW");
-                        jobject intent = env->NewObject(intentClass, ctor, actionView, uriObj);
-
-                        jclass activityClass = env->GetObjectClass(activity);
-                        jmethodID startActivity = env->GetMethodID(activityClass, "startActivity", "(Landroid/content/Intent;)V");
-                        env->CallVoidMethod(activity, startActivity, intent);
-
-                        env->DeleteLocalRef(intent);
-                        env->DeleteLocalRef(actionView);
-                        env->DeleteLocalRef(intentClass);
-                        env->DeleteLocalRef(uriObj);
-                        env->DeleteLocalRef(uriString);
-                        env->DeleteLocalRef(uriClass);
-                        env->DeleteLocalRef(activityClass);
-                    }
+                    openMarketPage();
 #else
 #ifdef _WIN32
                     ShellExecuteA(nullptr, "open", STEAM_URL, nullptr, nullptr, SW_SHOWNORMAL);
 #else
                     system((std::string("xdg-open ") + STEAM_URL).c_str());
 #endif
+                    steamStatus.requestRefresh();
 #endif
                 }
             }
@@ -185,38 +132,14 @@ void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> c
                 if (ImGui::Button(installButton.c_str(), btn))
                 {
 #if defined(__ANDROID__)
-                    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-                    jobject activity = (jobject)SDL_AndroidGetActivity();
-                    if (env && activity)
-                    {
-                        jclass uriClass = env->FindClass("android/net/Uri");
-                        jmethodID parse = env->GetStaticMethodID(uriClass, "parse", "(Ljava/lang/String;)Landroid/net/Uri;");
-                        jstring uriString = env->NewStringUTF(marketUri.c_str());
-                        jobject uriObj = env->CallStaticObjectMethod(uriClass, parse, uriString);
-
-                        jclass intentClass = env->FindClass("android/content/Intent");
-                        jmethodID ctor = env->GetMethodID(intentClass, "<init>", "(Ljava/lang/String;Landroid/net/Uri;)V");
-                        jstring actionView = env->NewStringUTF("android.intent.action.VIEW");
-                        jobject intent = env->NewObject(intentClass, ctor, actionView, uriObj);
-
-                        jclass activityClass = env->GetObjectClass(activity);
-                        jmethodID startActivity = env->GetMethodID(activityClass, "startActivity", "(Landroid/content/Intent;)V");
-                        env->CallVoidMethod(activity, startActivity, intent);
-
-                        env->DeleteLocalRef(intent);
-                        env->DeleteLocalRef(actionView);
-                        env->DeleteLocalRef(intentClass);
-                        env->DeleteLocalRef(uriObj);
-                        env->DeleteLocalRef(uriString);
-                        env->DeleteLocalRef(uriClass);
-                        env->DeleteLocalRef(activityClass);
-                    }
+                    openMarketPage();
 #else
 #ifdef _WIN32
                     ShellExecuteA(nullptr, "open", STEAM_INSTALL, nullptr, nullptr, SW_SHOWNORMAL);
 #else
                     system((std::string("xdg-open ") + STEAM_INSTALL).c_str());
 #endif
+                    steamStatus.requestRefresh();
 #endif
                 }
             }
@@ -235,18 +158,36 @@ void MissingGameWindow::showMissingGameWindow(std::vector<SDL_GameController*> c
         ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), m_renderer.getSdlRenderer());
         m_renderer.present();
 
-#if !defined(__ANDROID__)
-        if (m_steamRunning)
-            SteamAPI_RunCallbacks();
-#endif
-
-        SDL_Delay(16);
+        if (input.recording().mode() != InputRecording::Mode::Replaying) {
+            SDL_Delay(16);
+        }
     }
 
 #if !defined(__ANDROID__)
-    if (m_steamRunning)
-        SteamAPI_Shutdown();
+    steamStatus.stop();
 #endif
 
     shutdownImGui();
 }
+
+#if defined(__ANDROID__)
+void MissingGameWindow::openMarketPage() const
+{
+    JNIEnv* env = Jni::env();
+    if (!env)
+        return;
+
+    const Jni::Bindings& jni = Jni::bindings();
+    Jni::LocalFrame frame(env);
+
+    jstring uriString = env->NewStringUTF(marketUri.c_str());
+    jobject uriObj = Jni::callStatic<jobject>(env, jni.uriParse, uriString);
+
+    jstring actionView = env->NewStringUTF("android.intent.action.VIEW");
+    jobject intent = env->NewObject(jni.intent, jni.intentInit.id, actionView, uriObj);
+
+    jobject activity = static_cast<jobject>(SDL_AndroidGetActivity());
+    Jni::call<void>(env, activity, jni.startActivity, intent);
+    Jni::clearException(env, "startActivity");
+}
+#endif
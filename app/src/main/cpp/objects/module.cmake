@@ -7,12 +7,16 @@ set(MODULE_SOURCES
     ${MODULE_DIR}/text.cpp
     ${MODULE_DIR}/imgui_window.cpp
     ${MODULE_DIR}/missing_game_window.cpp
+    ${MODULE_DIR}/debug_overlay.cpp
+    ${MODULE_DIR}/font_preview.cpp
 )
 
 set(MODULE_HEADERS
     ${INCLUDE_DIR}/text.hpp
     ${INCLUDE_DIR}/imgui_window.hpp
     ${INCLUDE_DIR}/missing_game_window.hpp
+    ${INCLUDE_DIR}/debug_overlay.hpp
+    ${INCLUDE_DIR}/font_preview.hpp
 )
 
 add_library(
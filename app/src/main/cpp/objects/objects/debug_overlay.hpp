@@ -0,0 +1,24 @@
+#pragma once
+
+#include <imgui.h>
+
+// Corner window with memory numbers from MemoryTracker, the task
+// scheduler's counters and input-to-present latency from LatencyTracker.
+// Hidden by default; F3 toggles it. Its numbers are left out of FrameSkip's
+// fingerprint, so while it is up they refresh only on frames drawn for some
+// other reason, or every frame while the mouse is over it.
+class DebugOverlay
+{
+public:
+    DebugOverlay() = default;
+
+    void toggle() { m_isVisible = !m_isVisible; }
+    void setVisible(bool visible) { m_isVisible = visible; }
+    [[nodiscard]] bool isVisible() const { return m_isVisible; }
+
+    // Inside an ImGui frame, after the main window
+    void render();
+
+private:
+    bool m_isVisible = false;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <objects/text.hpp>
+#include <SDL.h>
+#include <memory>
+#include <string>
+
+// A line of localization drawn the way the game lays it out, with the FONT
+// from font.cfg, shown in the Font tab. The text is drawn into a target
+// texture and only redrawn when the text, size or font changes.
+class FontPreview
+{
+public:
+    explicit FontPreview(SDL_Renderer* renderer);
+    ~FontPreview();
+
+    // Null = the embedded font
+    void setFont(std::shared_ptr<const MappedFile> font);
+
+    // Inside an ImGui window: a 16:9 box `width` wide
+    void render(const char* text, int fontSize, float width);
+
+    FontPreview(const FontPreview&) = delete;
+    FontPreview(FontPreview&&) = delete;
+    FontPreview& operator=(const FontPreview&) = delete;
+    FontPreview& operator=(FontPreview&&) = delete;
+
+private:
+    bool ensureTarget(int width, int height);
+
+    SDL_Renderer* m_renderer;
+    Text m_text;
+    SDL_Texture* m_target = nullptr;
+    SDL_Point m_targetSize{};
+
+    std::string m_drawnText;
+    int m_drawnSize = 0;
+    bool m_isDirty = true;
+};
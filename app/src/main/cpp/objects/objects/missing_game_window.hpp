@@ -10,9 +10,10 @@
 #include <application/renderer.hpp>
 #include <vector>
 #if defined(__ANDROID__)
-#include <jni.h>
+#include <utils/jni_bridge.hpp>
 #else
 #include <steam/steam_api.h>
+#include <utils/steam_status.hpp>
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -26,15 +27,17 @@ public:
     MissingGameWindow(Window& window, Renderer& renderer);
     ~MissingGameWindow();
 
-    void showMissingGameWindow(std::vector<SDL_GameController*> controllers);
+    void showMissingGameWindow(InputSystem& input);
 
 private:
     void shutdownImGui();
+#if defined(__ANDROID__)
+    void openMarketPage() const;
+#endif
 
 private:
     Window& m_window;
     Renderer& m_renderer;
-    bool m_steamRunning = false;
 
 
 #if defined(__ANDROID__) 
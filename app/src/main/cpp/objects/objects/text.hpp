@@ -1,8 +1,10 @@
 #pragma once
 
 #include <utils/texture.hpp>
+#include <utils/font_loader.hpp>
 #include <SDL.h>
 #include <SDL_ttf.h>
+#include <memory>
 #include <string>
 
 class Text {
@@ -19,7 +21,20 @@ public:
     void setText(const std::string& text);
     void setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     void setLocalizedText(const std::string& key);
+
+    // Loads `path` (FONT from font.cfg when empty) in the background. Until
+    // it is ready, and for any glyph it lacks, the embedded font is used.
     void loadCustomFont(const std::string& path = "");
+
+    // Uses a font another FontLoader already loaded; null = embedded only
+    void setCustomFont(std::shared_ptr<const MappedFile> font);
+
+    [[nodiscard]] bool hasCustomFont() const { return m_customFont != nullptr; }
+    [[nodiscard]] bool isCustomFontLoading() const { return m_loader && m_loader->state() == FontLoader::State::Loading; }
+
+    // Picks up a finished background load; true when the font changed
+    bool updateCustomFont();
+
     void animationStart(const bool& fadeIn);
     void animationStop();
     int getAnimationDuration() const;
@@ -39,10 +54,22 @@ private:
     };
     PositionMode m_positionMode = PositionMode::Default;
 
+    // One line as a surface; runs the custom font has no glyphs for are
+    // drawn with the embedded font
+    SDL_Surface* renderLine(const std::string& line, SDL_Color color) const;
+    void openCustomFont();
+    void closeCustomFont();
+
     TTF_Font* m_sdlFont;
     SDL_Renderer* m_sdlRenderer;
     bool m_isInit;
 
+    int m_fontSize = 0;
+    bool m_forceDefaultFont = false;
+    TTF_Font* m_customFont = nullptr;
+    std::shared_ptr<const MappedFile> m_customSource;
+    std::unique_ptr<FontLoader> m_loader;
+
     std::string m_text;
     const SDL_Point m_pos;
     Uint8 m_alpha;
@@ -1,6 +1,10 @@
 #include <objects/text.hpp>
 #include <utils/texture.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/utf8.hpp>
 #include <SDL_ttf.h>
+#include <algorithm>
 #include <vector>
 #include <sstream>
 
@@ -25,6 +29,9 @@ Text::Text(
     m_animationDuration(animationDuration),
     m_color{ 255, 255, 255, 255 }
 {
+    m_fontSize = fontSize;
+    m_forceDefaultFont = forceDefaultFont;
+
     if(forceDefaultFont) {
         m_sdlFont = TTF_OpenFontRW(SDL_Incbin(FONT_FONT_TTF), SDL_TRUE, fontSize);
         m_isInit = m_sdlFont != nullptr;
@@ -48,6 +55,7 @@ Text::Text(
 }
 
 Text::~Text() {
+    closeCustomFont();
     if(m_isInit) {
         TTF_CloseFont(m_sdlFont);
         m_sdlFont = nullptr;
@@ -56,6 +64,7 @@ Text::~Text() {
 }
 
 void Text::setText(const std::string& text) {
+    MemoryTagScope memoryTag(MemoryTag::Text);
     m_text = text;
 }
 
@@ -64,20 +73,67 @@ void Text::setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
 }
 
 void Text::loadCustomFont(const std::string& path) {
-    if (m_isInit) {
-        TTF_CloseFont(m_sdlFont);
-        m_sdlFont = nullptr;
-        m_isInit = false;
+    if (m_forceDefaultFont) {
+        return;
     }
 
-    m_sdlFont = TTF_OpenFontRW(SDL_Incbin(FONT_FONT_TTF), SDL_TRUE, 25);
+    const std::string fontPath = path.empty() ? FileManager::loadCustomFontPath() : path;
+    if (fontPath.empty()) {
+        if (m_loader) m_loader->reset();
+        setCustomFont(nullptr);
+        return;
+    }
 
-    m_isInit = m_sdlFont != nullptr;
-    if (!m_isInit) {
-        SDL_LogCritical(
-            SDL_LOG_CATEGORY_SYSTEM, "%s failed: %s",
-            "TTF_OpenFont", SDL_GetError()
-        );
+    // The current font stays in use until the new one is ready
+    if (!m_loader) {
+        m_loader = std::make_unique<FontLoader>();
+    }
+    m_loader->load(fontPath);
+}
+
+void Text::setCustomFont(std::shared_ptr<const MappedFile> font) {
+    if (font == m_customSource) {
+        return;
+    }
+    closeCustomFont();
+    m_customSource = std::move(font);
+    openCustomFont();
+}
+
+bool Text::updateCustomFont() {
+    if (!m_loader || !m_loader->pump()) {
+        return false;
+    }
+    if (m_loader->state() == FontLoader::State::Ready) {
+        setCustomFont(m_loader->font());
+    }
+    else {
+        setCustomFont(nullptr);
+    }
+    return true;
+}
+
+void Text::openCustomFont() {
+    MemoryTagScope memoryTag(MemoryTag::Text);
+    if (!m_customSource || m_fontSize <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(FontLoader::libraryMutex());
+    m_customFont = TTF_OpenFontRW(
+        SDL_RWFromConstMem(m_customSource->data(), static_cast<int>(m_customSource->size())), SDL_TRUE, m_fontSize);
+    if (!m_customFont) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Custom font failed, using the embedded one: %s", TTF_GetError());
+        return;
+    }
+    TTF_SetFontHinting(m_customFont, TTF_HINTING_LIGHT);
+}
+
+void Text::closeCustomFont() {
+    if (m_customFont) {
+        std::lock_guard<std::mutex> lock(FontLoader::libraryMutex());
+        TTF_CloseFont(m_customFont);
+        m_customFont = nullptr;
     }
 }
 
@@ -115,6 +171,11 @@ void Text::positionTopCenter() {
 
 void Text::resize(const int& fontSize)
 {
+    MemoryTagScope memoryTag(MemoryTag::Text);
+    m_fontSize = fontSize;
+    closeCustomFont();
+    openCustomFont();
+
     if (m_sdlFont) {
         TTF_CloseFont(m_sdlFont);
         m_sdlFont = nullptr;
@@ -133,7 +194,75 @@ void Text::resize(const int& fontSize)
 }
 
 
+SDL_Surface* Text::renderLine(const std::string& line, SDL_Color color) const {
+    if (!m_customFont) {
+        return TTF_RenderUTF8_Blended(m_sdlFont, line.c_str(), color);
+    }
+
+    // Split into runs by the font that has each glyph; spaces stay with the run they are in
+    struct Run {
+        TTF_Font* font;
+        std::string text;
+    };
+    std::vector<Run> runs;
+    for (std::size_t pos = 0; pos < line.size();) {
+        const std::size_t start = pos;
+        const uint32_t codePoint = Utf8::next(line, pos);
+
+        TTF_Font* font = m_customFont;
+        if (codePoint == ' ' && !runs.empty()) {
+            font = runs.back().font;
+        }
+        else if (!TTF_GlyphIsProvided32(m_customFont, codePoint) && m_sdlFont && TTF_GlyphIsProvided32(m_sdlFont, codePoint)) {
+            font = m_sdlFont;
+        }
+
+        if (runs.empty() || runs.back().font != font) {
+            runs.push_back({ font, std::string() });
+        }
+        runs.back().text.append(line, start, pos - start);
+    }
+
+    if (runs.size() == 1) {
+        return TTF_RenderUTF8_Blended(runs.front().font, line.c_str(), color);
+    }
+
+    // Render each run, then place them side by side on a shared baseline
+    std::vector<SDL_Surface*> surfaces;
+    int width = 0;
+    int ascent = 0;
+    int descent = 0;
+    for (const Run& run : runs) {
+        SDL_Surface* surface = TTF_RenderUTF8_Blended(run.font, run.text.c_str(), color);
+        surfaces.push_back(surface);
+        if (!surface) continue;
+        width += surface->w;
+        ascent = std::max(ascent, TTF_FontAscent(run.font));
+        descent = std::max(descent, surface->h - TTF_FontAscent(run.font));
+    }
+
+    SDL_Surface* combined = width > 0
+        ? SDL_CreateRGBSurfaceWithFormat(0, width, ascent + descent, 32, SDL_PIXELFORMAT_ARGB8888)
+        : nullptr;
+    int x = 0;
+    for (std::size_t i = 0; i < surfaces.size(); ++i) {
+        SDL_Surface* surface = surfaces[i];
+        if (!surface) continue;
+        if (combined) {
+            // Copy, not blend: the runs do not overlap and their alpha must survive
+            SDL_Rect dest = { x, ascent - TTF_FontAscent(runs[i].font), surface->w, surface->h };
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surface, nullptr, combined, &dest);
+            x += surface->w;
+        }
+        SDL_FreeSurface(surface);
+    }
+    return combined;
+}
+
 void Text::render(const SDL_Point& areaSize) {
+    MemoryTagScope memoryTag(MemoryTag::Text);
+    updateCustomFont();
     if (m_text.empty()) {
         return;
     }
@@ -171,11 +300,7 @@ void Text::render(const SDL_Point& areaSize) {
         drawColor.a = m_alpha;
 
         textures.emplace_back(
-            TTF_RenderUTF8_Blended(
-                m_sdlFont,
-                line.c_str(),
-                drawColor
-            ),
+            renderLine(line, drawColor),
             m_sdlRenderer
         );
 
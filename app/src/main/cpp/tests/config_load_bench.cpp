@@ -0,0 +1,136 @@
+#include <tests/bench.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/storage_backend.hpp>
+#include <SDL.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#if __has_include(<assets/config_keys.hpp>)
+#include <assets/config_keys.hpp>
+#define CONFIG_LOAD_BENCH_HAS_KEY_TABLES 1
+#endif
+
+// Loading and saving the game's config files through FileManager, on the
+// in-memory backend so only parsing, key lookup and formatting are timed.
+//
+// The load section uses FileManager calls that predate the perfect-hash key
+// tables, so this file builds unchanged on the revision before them for a
+// before/after comparison. The lookup section needs config_keys.hpp and
+// compares the hash against the linear scan it replaced in the same run.
+namespace {
+    constexpr const char* s_gamePath = "/game";
+
+    const char* const s_localizationKeys[] = {
+        "LOADING_TEXT", "ENDLESS_MODE", "IDLE", "A_START", "B_START", "C_START", "D_START", "E_START",
+        "F_START", "G_START", "H_START", "I_START", "J_START", "K_START", "L_START", "M_START", "N_START",
+        "O_START", "P_START", "Q_START", "R_START", "S_START", "T_START", "FINAL_START",
+    };
+
+    void writeFile(StorageBackend& storage, const char* name, const std::vector<std::string>& lines) {
+        const std::string bytes = FileManager::joinLines(lines);
+        storage.writeFile(FileManager::joinPath(s_gamePath, name), bytes.data(), bytes.size());
+    }
+
+    // A translated install: every known key, a few keys from newer game
+    // versions, comments, and the decor list
+    void writeGameConfigs(StorageBackend& storage) {
+        std::vector<std::string> localization = { "# Translation" };
+        for (const char* key : s_localizationKeys) {
+            localization.push_back(std::string(key) + "=\"Translated \\\"" + key + "\\\" text\\nsecond line\"");
+        }
+        for (int i = 0; i < 8; ++i) {
+            localization.push_back("FUTURE_KEY_" + std::to_string(i) + "=\"Not known to this build\"");
+        }
+        writeFile(storage, "localization.cfg", localization);
+
+        writeFile(storage, "font.cfg", {
+            "FONT=\"fonts/custom.ttf\"", "FONT_SIZE=32", "OTHER_TEXT_FONT_SIZE=20", "FUTURE_FONT_KEY=1",
+        });
+
+        std::vector<std::string> decor;
+        for (int i = 0; i < 64; ++i) {
+            decor.push_back("decor_" + std::to_string(i) + (i % 3 ? "=true" : "=false"));
+        }
+        writeFile(storage, "decor.cfg", decor);
+    }
+
+#if defined(CONFIG_LOAD_BENCH_HAS_KEY_TABLES)
+    // What lookups did before the tables: compare against every name in turn
+    int linearFind(std::string_view key) {
+        for (std::size_t i = 0; i < LocalizationKeyNames.size(); ++i) {
+            if (LocalizationKeyNames[i] == key) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    void benchKeyLookup() {
+        // Known keys from the end of the list are the scan's worst case
+        std::vector<std::string> keys;
+        for (const char* key : s_localizationKeys) keys.push_back(key);
+        for (int i = 0; i < 8; ++i) keys.push_back("FUTURE_KEY_" + std::to_string(i));
+
+        constexpr int s_rounds = 100000;
+        const uint64_t lookups = static_cast<uint64_t>(s_rounds) * keys.size();
+        std::printf("\nKey lookup (%llu lookups per run)\n", static_cast<unsigned long long>(lookups));
+
+        Bench::run("perfect hash", 10, [&]() {
+            uint64_t sum = 0;
+            for (int round = 0; round < s_rounds; ++round) {
+                for (const std::string& key : keys) sum += static_cast<uint64_t>(LocalizationKeyHash.find(key) + 1);
+            }
+            Bench::keep(sum);
+        });
+        Bench::run("linear scan (before)", 10, [&]() {
+            uint64_t sum = 0;
+            for (int round = 0; round < s_rounds; ++round) {
+                for (const std::string& key : keys) sum += static_cast<uint64_t>(linearFind(key) + 1);
+            }
+            Bench::keep(sum);
+        });
+    }
+#endif
+}
+
+int main() {
+    // The loaders log every value they pick up; keep that out of the timings
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+
+    auto backend = std::make_unique<MemoryStorageBackend>();
+    MemoryStorageBackend& storage = *backend;
+    FileManager::setStorageBackend(std::move(backend));
+    FileManager::setGamePath(s_gamePath);
+    writeGameConfigs(storage);
+
+    std::printf("Config load (best of N runs; compare before and after a change)\n\n");
+    constexpr int s_repeats = 2000;
+
+    Bench::run("loadLocalization", s_repeats, [&]() {
+        Bench::keep(FileManager::loadLocalization().size());
+    });
+    Bench::run("loadCustomFontSize", s_repeats, [&]() {
+        Bench::keep(FileManager::loadCustomFontSize());
+    });
+    Bench::run("loadDecorAssets", s_repeats, [&]() {
+        Bench::keep(FileManager::loadDecorAssets().size());
+    });
+    Bench::run("startup load (all three)", s_repeats, [&]() {
+        uint64_t sum = FileManager::loadLocalization().size();
+        sum += FileManager::loadCustomFontSize();
+        sum += FileManager::loadDecorAssets().size();
+        Bench::keep(sum);
+    });
+
+    // Saving rewrites the files; restore them after each run so every run
+    // starts from the same state
+    Bench::run("updateAllConfigFiles", s_repeats, [&]() {
+        FileManager::updateAllConfigFiles();
+        writeGameConfigs(storage);
+    });
+
+#if defined(CONFIG_LOAD_BENCH_HAS_KEY_TABLES)
+    benchKeyLookup();
+#endif
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <tests/check.hpp>
+#include <utils/decor_collection.hpp>
+#include <string>
+
+namespace {
+    CustomDecorCollection::Index addNamed(CustomDecorCollection& decor, const std::string& name, uint64_t hash = 0) {
+        CustomeDecorationList item;
+        item.name = name;
+        item.contentHash = hash;
+        return decor.add(std::move(item));
+    }
+
+    std::string addAndName(CustomDecorCollection& decor, const std::string& name) {
+        return decor[addNamed(decor, name)].name;
+    }
+
+    void testClashingNamesGetSuffixes() {
+        CustomDecorCollection decor;
+        CHECK(addAndName(decor, "image") == "image");
+        CHECK(addAndName(decor, "image") == "image_new");
+        CHECK(addAndName(decor, "image") == "image_new2");
+        CHECK(addAndName(decor, "image") == "image_new3");
+
+        // A renamed duplicate is flagged, the original is not
+        CHECK(decor[0].operations == 0);
+        CHECK(decor[1].hasOperation(CustomeDecorationOperationEnum::Rename));
+
+        // Suffixed names clash on their own base
+        CHECK(addAndName(decor, "image_new") == "image_new_new");
+
+        // Invalid characters are replaced before the clash check
+        CHECK(addAndName(decor, "a/b") == "a_b");
+        CHECK(addAndName(decor, "a:b") == "a_b_new");
+        CHECK(addAndName(decor, "") == "unknown");
+    }
+
+    void testFreedSuffixesAreReused() {
+        CustomDecorCollection decor;
+        for (int i = 0; i < 5; ++i) addNamed(decor, "image");   // image, image_new .. image_new4
+
+        // Like the baseline scan, the lowest free suffix is picked again
+        decor.erase(2);                                         // image_new2
+        CHECK(addAndName(decor, "image") == "image_new2");
+        CHECK(addAndName(decor, "image") == "image_new5");
+
+        decor.erase(1);                                         // image_new
+        decor.erase(3);                                         // image_new3
+        CHECK(addAndName(decor, "image") == "image_new");
+        CHECK(addAndName(decor, "image") == "image_new3");
+        CHECK(addAndName(decor, "image") == "image_new6");
+
+        // Renaming away frees the old name too
+        const CustomDecorCollection::Index index = decor.slotCount() - 1;  // image_new6
+        decor.rename(4, "other");                               // image_new4
+        CHECK(decor[4].name == "other");
+        CHECK(addAndName(decor, "image") == "image_new4");
+        CHECK(decor[index].name == "image_new6");
+
+        // Still the same after compaction drops the tombstones
+        decor.compact();
+        CHECK(decor.size() == decor.slotCount());
+        decor.eraseIf([](const CustomeDecorationList& item) { return item.name == "image_new5"; });
+        CHECK(addAndName(decor, "image") == "image_new5");
+        CHECK(addAndName(decor, "image") == "image_new7");
+
+        // Names that only look like suffixes leave the counter alone
+        addNamed(decor, "image_new10x");
+        addNamed(decor, "image_new01");
+        decor.eraseIf([](const CustomeDecorationList& item) { return item.name.size() > 10; });
+        CHECK(addAndName(decor, "image") == "image_new8");
+    }
+
+    void testRenameKeepsNamesUnique() {
+        CustomDecorCollection decor;
+        addNamed(decor, "a");
+        addNamed(decor, "b");
+
+        decor.rename(1, "a");
+        CHECK(decor[1].name == "a_new");
+        CHECK(decor[1].hasOperation(CustomeDecorationOperationEnum::Rename));
+        CHECK(decor.isNameTaken("a_new"));
+        CHECK(!decor.isNameTaken("b"));
+
+        // Renaming to the current name is a no-op
+        decor.rename(0, "a");
+        CHECK(decor[0].operations == 0);
+
+        // Clashing again lands on the suffix the item just gave up
+        decor.rename(1, "a");
+        CHECK(decor[1].name == "a_new");
+    }
+
+    void testErasedIndicesStayValid() {
+        CustomDecorCollection decor;
+        for (int i = 0; i < 10; ++i) addNamed(decor, "d" + std::to_string(i), 100 + i);
+
+        decor.erase(3);
+        decor.erase(3);     // Erasing a tombstone again does nothing
+        CHECK(decor.size() == 9);
+        CHECK(decor.slotCount() == 10);
+        CHECK(!decor.isAlive(3));
+        CHECK(decor[7].name == "d7");
+        CHECK(decor.findByHash(103) == CustomDecorCollection::npos);
+        CHECK(decor.findByHash(107) == 7);
+
+        std::size_t visited = 0;
+        for (const auto& item : decor) {
+            CHECK(item.name != "d3");
+            ++visited;
+        }
+        CHECK(visited == 9);
+
+        decor.compact();
+        CHECK(decor.slotCount() == 9);
+        CHECK(decor[3].name == "d4");
+        CHECK(decor.findByHash(104) == 3);
+        CHECK(!decor.isNameTaken("d3"));
+    }
+
+    void testDuplicateContent() {
+        CustomDecorCollection decor;
+        addNamed(decor, "a", 42);
+        addNamed(decor, "b", 7);
+        addNamed(decor, "c", 42);
+
+        CHECK(decor.findByHash(42) == 0);
+        CHECK(decor.findByHash(42, 0) == 2);
+        CHECK(decor.findByHash(0) == CustomDecorCollection::npos);
+        decor.erase(0);
+        CHECK(decor.findByHash(42) == 2);
+    }
+}
+
+int main() {
+    testClashingNamesGetSuffixes();
+    testFreedSuffixesAreReused();
+    testRenameKeepsNamesUnique();
+    testErasedIndicesStayValid();
+    testDuplicateContent();
+    return Check::result("decor_collection");
+}
@@ -0,0 +1,240 @@
+#include <tests/check.hpp>
+#include <objects/debug_overlay.hpp>
+#include <utils/frame_skip.hpp>
+#include <utils/input_system.hpp>
+#include <utils/latency_tracker.hpp>
+#include <backends/imgui_impl_sdl2.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <SDL.h>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// FrameSkip on a replayed session, through the same steps as Game::play():
+// a window with a button, the mouse moving onto it and clicking, and the
+// debug overlay opened with F3, hovered and closed again. While nothing
+// moves frames must be skipped, with the overlay up too; what the input
+// changes must be drawn. Prints the skip rate of every phase.
+namespace {
+    constexpr const char* s_recordingPath = "frame_skip_test.rec";
+
+    constexpr int s_width = 640;
+    constexpr int s_height = 480;
+
+    // The button's rectangle, and places on the overlay and on nothing
+    const ImVec2 s_windowPos(20.0f, 20.0f);
+    const ImVec2 s_buttonSize(100.0f, 40.0f);
+    constexpr int s_buttonX = 70;
+    constexpr int s_buttonY = 45;
+    constexpr int s_overlayX = s_width - 30;
+    constexpr int s_overlayY = 30;
+    constexpr int s_emptyX = 400;
+    constexpr int s_emptyY = 400;
+
+    // Frames the UI may take to settle after appearing or a change, such as
+    // window auto-sizing and glyphs being added to the font atlas
+    constexpr uint64_t s_settleFrames = 5;
+
+    struct Phase {
+        const char* name;
+        uint64_t first;     // Recorded frame the phase's input is on
+        uint64_t last;
+    };
+
+    const Phase s_phases[] = {
+        { "idle", 1, 60 },
+        { "hover button", 61, 120 },
+        { "click button", 121, 180 },
+        { "mouse away", 181, 240 },
+        { "overlay open", 241, 360 },
+        { "hover overlay", 361, 420 },
+        { "overlay open, mouse away", 421, 480 },
+        { "overlay closed", 481, 540 },
+    };
+    constexpr uint64_t s_lastFrame = 540;
+
+    SDL_Event mouseMotion(Uint32 windowID, int x, int y) {
+        SDL_Event event{};
+        event.type = SDL_MOUSEMOTION;
+        event.motion.windowID = windowID;
+        event.motion.x = x;
+        event.motion.y = y;
+        return event;
+    }
+
+    SDL_Event mouseButton(Uint32 windowID, bool isDown, int x, int y) {
+        SDL_Event event{};
+        event.type = isDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+        event.button.windowID = windowID;
+        event.button.button = SDL_BUTTON_LEFT;
+        event.button.state = isDown ? SDL_PRESSED : SDL_RELEASED;
+        event.button.clicks = 1;
+        event.button.x = x;
+        event.button.y = y;
+        return event;
+    }
+
+    SDL_Event key(Uint32 windowID, bool isDown, SDL_Keycode sym, SDL_Scancode scancode) {
+        SDL_Event event{};
+        event.type = isDown ? SDL_KEYDOWN : SDL_KEYUP;
+        event.key.windowID = windowID;
+        event.key.state = isDown ? SDL_PRESSED : SDL_RELEASED;
+        event.key.keysym.sym = sym;
+        event.key.keysym.scancode = scancode;
+        return event;
+    }
+
+    bool writeRecording(Uint32 windowID) {
+        std::map<uint64_t, std::vector<SDL_Event>> script;
+        script[61] = { mouseMotion(windowID, s_buttonX, s_buttonY) };
+        script[121] = { mouseButton(windowID, true, s_buttonX, s_buttonY) };
+        script[122] = { mouseButton(windowID, false, s_buttonX, s_buttonY) };
+        script[181] = { mouseMotion(windowID, s_emptyX, s_emptyY) };
+        script[241] = { key(windowID, true, SDLK_F3, SDL_SCANCODE_F3) };
+        script[242] = { key(windowID, false, SDLK_F3, SDL_SCANCODE_F3) };
+        script[361] = { mouseMotion(windowID, s_overlayX, s_overlayY) };
+        script[421] = { mouseMotion(windowID, s_emptyX, s_emptyY) };
+        script[481] = { key(windowID, true, SDLK_F3, SDL_SCANCODE_F3) };
+        script[482] = { key(windowID, false, SDLK_F3, SDL_SCANCODE_F3) };
+
+        InputRecording recording;
+        if (!recording.startRecording(s_recordingPath)) return false;
+        while (recording.frame() < s_lastFrame) {
+            recording.beginFrame();
+            for (const SDL_Event& event : script[recording.frame()]) {
+                recording.record(event);
+            }
+        }
+        return recording.finish();
+    }
+
+    // Replays the recording; which frames were drawn, by recorded frame
+    std::vector<bool> replay(SDL_Renderer* renderer, int& clicks, bool& wasOverlayShown) {
+        InputSystem input;
+        DebugOverlay overlay;
+        std::vector<bool> drawn(s_lastFrame + 1, false);
+        if (!input.recording().startReplay(s_recordingPath)) return drawn;
+
+        bool isRunning = true;
+        while (isRunning) {
+            input.processEvents(isRunning);
+            const uint64_t frame = input.recording().frame();
+
+            ImGui_ImplSDLRenderer2_NewFrame();
+            ImGui_ImplSDL2_NewFrame();
+            ImGui::GetIO().DeltaTime = InputRecording::s_frameSeconds;
+            ImGui::NewFrame();
+
+            ImGui::SetNextWindowPos(s_windowPos, ImGuiCond_Always);
+            ImGui::SetNextWindowSize(ImVec2(300.0f, 200.0f), ImGuiCond_Always);
+            const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings;
+            if (ImGui::Begin("##frame_skip", nullptr, flags)) {
+                if (ImGui::Button("Add", s_buttonSize)) {
+                    ++clicks;
+                }
+                ImGui::Text("Clicked %d times", clicks);
+            }
+            ImGui::End();
+            overlay.render();
+            wasOverlayShown = wasOverlayShown || overlay.isVisible();
+
+            ImGui::Render();
+            if (FrameSkip::shouldDraw(ImGui::GetDrawData())) {
+                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, SDL_ALPHA_OPAQUE);
+                SDL_RenderClear(renderer);
+                ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+                LatencyTracker::beginPresent();
+                SDL_RenderPresent(renderer);
+                LatencyTracker::endPresent();
+                if (frame <= s_lastFrame) drawn[frame] = true;
+            }
+            else {
+                LatencyTracker::skipPresent();
+            }
+        }
+        CHECK(input.recording().frame() == s_lastFrame);
+        CHECK(!overlay.isVisible());
+        input.recording().finish();
+        return drawn;
+    }
+
+    void testSkipRate(SDL_Window* window, SDL_Renderer* renderer) {
+        CHECK(writeRecording(SDL_GetWindowID(window)));
+
+        int clicks = 0;
+        bool wasOverlayShown = false;
+        const std::vector<bool> drawn = replay(renderer, clicks, wasOverlayShown);
+        CHECK(clicks == 1);
+        CHECK(wasOverlayShown);
+
+        uint64_t totalDrawn = 0;
+        for (const Phase& phase : s_phases) {
+            uint64_t phaseDrawn = 0;
+            uint64_t settledDrawn = 0;  // After the first s_settleFrames
+            for (uint64_t frame = phase.first; frame <= phase.last; ++frame) {
+                if (!drawn[frame]) continue;
+                ++phaseDrawn;
+                if (frame >= phase.first + s_settleFrames) ++settledDrawn;
+            }
+            totalDrawn += phaseDrawn;
+            const uint64_t frames = phase.last - phase.first + 1;
+            std::printf("%-26s %3llu of %3llu frames drawn, %5.1f%% skipped\n", phase.name,
+                static_cast<unsigned long long>(phaseDrawn), static_cast<unsigned long long>(frames),
+                100.0 * (frames - phaseDrawn) / frames);
+
+            // What the mouse is over counts its own live values in: every frame changes
+            if (phase.first == 361) {
+                CHECK(phaseDrawn == frames);
+                continue;
+            }
+            // Once settled nothing changes on screen, and nothing may be drawn
+            if (settledDrawn != 0) {
+                std::fprintf(stderr, "%s: %llu frame(s) drawn after settling\n", phase.name,
+                    static_cast<unsigned long long>(settledDrawn));
+            }
+            CHECK(settledDrawn == 0);
+            // The change that starts the phase is drawn
+            if (phase.first > 1) {
+                CHECK(phaseDrawn > 0);
+            }
+        }
+        std::printf("%-26s %3llu of %3llu frames drawn, %5.1f%% skipped\n", "total",
+            static_cast<unsigned long long>(totalDrawn), static_cast<unsigned long long>(s_lastFrame),
+            100.0 * (s_lastFrame - totalDrawn) / s_lastFrame);
+    }
+}
+
+int main() {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+
+    // As a --replay run: the dummy video driver and the software renderer
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("frame_skip", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+        s_width, s_height, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, -1, 0) : nullptr;
+    CHECK(renderer != nullptr);
+
+    if (renderer) {
+        ImGui::CreateContext();
+        ImGui::GetIO().IniFilename = nullptr;
+        ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
+        ImGui_ImplSDLRenderer2_Init(renderer);
+
+        testSkipRate(window, renderer);
+
+        ImGui_ImplSDLRenderer2_Shutdown();
+        ImGui_ImplSDL2_Shutdown();
+        ImGui::DestroyContext();
+        SDL_DestroyRenderer(renderer);
+    }
+
+    std::remove(s_recordingPath);
+    if (window) SDL_DestroyWindow(window);
+    SDL_Quit();
+    return Check::result("frame_skip");
+}
@@ -0,0 +1,296 @@
+#include <tests/check.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/input_recording.hpp>
+#include <SDL.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Record then replay: every kind of event the recording keeps must come back
+// field for field, on the frame it was recorded on and in the same order,
+// with the replay ending on the frame the recording did. Event types it
+// leaves out are dropped, and damaged files are refused or cut short.
+namespace {
+    constexpr const char* s_path = "input_recording_test.rec";
+    constexpr const char* s_damagedPath = "input_recording_test_damaged.rec";
+
+    SDL_Event blank(Uint32 type, Uint32 timestamp) {
+        SDL_Event event;
+        std::memset(&event, 0, sizeof(event));
+        event.type = type;
+        event.common.timestamp = timestamp;
+        return event;
+    }
+
+    // One of each kind, with values that take every varint length, negative
+    // numbers, and text filling the whole buffer
+    std::vector<SDL_Event> everyKind(Uint32 timestamp) {
+        std::vector<SDL_Event> events;
+
+        SDL_Event event = blank(SDL_WINDOWEVENT, timestamp);
+        event.window.windowID = 3;
+        event.window.event = SDL_WINDOWEVENT_RESIZED;
+        event.window.data1 = 1920;
+        event.window.data2 = -1080;
+        events.push_back(event);
+
+        for (Uint32 type : { SDL_KEYDOWN, SDL_KEYUP }) {
+            event = blank(type, timestamp += 7);
+            event.key.windowID = 3;
+            event.key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.key.repeat = 1;
+            event.key.keysym.scancode = SDL_SCANCODE_RETURN;
+            event.key.keysym.sym = SDLK_RETURN;
+            event.key.keysym.mod = KMOD_LSHIFT | KMOD_RCTRL;
+            events.push_back(event);
+        }
+
+        event = blank(SDL_TEXTEDITING, timestamp += 1);
+        event.edit.windowID = 3;
+        std::strcpy(event.edit.text, "\xE3\x81\x8B\xE3\x81\xAA");   // Japanese kana, mid-composition
+        event.edit.start = 2;
+        event.edit.length = -1;
+        events.push_back(event);
+
+        event = blank(SDL_TEXTINPUT, timestamp += 1);
+        event.text.windowID = 3;
+        std::memset(event.text.text, 'x', sizeof(event.text.text) - 1);
+        events.push_back(event);
+
+        event = blank(SDL_MOUSEMOTION, timestamp += 300);
+        event.motion.windowID = 3;
+        event.motion.which = 0;
+        event.motion.state = SDL_BUTTON_LMASK;
+        event.motion.x = 100000;
+        event.motion.y = -5;
+        event.motion.xrel = -64;
+        event.motion.yrel = 64;
+        events.push_back(event);
+
+        for (Uint32 type : { SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP }) {
+            event = blank(type, timestamp += 1);
+            event.button.windowID = 3;
+            event.button.which = SDL_TOUCH_MOUSEID;
+            event.button.button = SDL_BUTTON_RIGHT;
+            event.button.state = type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.button.clicks = 2;
+            event.button.x = 640;
+            event.button.y = 480;
+            events.push_back(event);
+        }
+
+        event = blank(SDL_MOUSEWHEEL, timestamp += 1);
+        event.wheel.windowID = 3;
+        event.wheel.which = 1;
+        event.wheel.x = -1;
+        event.wheel.y = 3;
+        event.wheel.direction = SDL_MOUSEWHEEL_FLIPPED;
+        event.wheel.preciseX = -0.75f;
+        event.wheel.preciseY = 3.125f;
+        event.wheel.mouseX = 12;
+        event.wheel.mouseY = 34;
+        events.push_back(event);
+
+        for (Uint32 type : { SDL_FINGERDOWN, SDL_FINGERMOTION, SDL_FINGERUP }) {
+            event = blank(type, timestamp += 16);
+            event.tfinger.touchId = -2;
+            event.tfinger.fingerId = 0x123456789LL;
+            event.tfinger.x = 0.25f;
+            event.tfinger.y = 1.0f / 3.0f;
+            event.tfinger.dx = -0.0f;
+            event.tfinger.dy = 1e-7f;
+            event.tfinger.pressure = 1.0f;
+            event.tfinger.windowID = 3;
+            events.push_back(event);
+        }
+
+        event = blank(SDL_CONTROLLERAXISMOTION, timestamp += 1);
+        event.caxis.which = 4;
+        event.caxis.axis = SDL_CONTROLLER_AXIS_LEFTY;
+        event.caxis.value = -32768;
+        events.push_back(event);
+
+        for (Uint32 type : { SDL_CONTROLLERBUTTONDOWN, SDL_CONTROLLERBUTTONUP }) {
+            event = blank(type, timestamp += 1);
+            event.cbutton.which = 4;
+            event.cbutton.button = SDL_CONTROLLER_BUTTON_DPAD_RIGHT;
+            event.cbutton.state = type == SDL_CONTROLLERBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            events.push_back(event);
+        }
+
+        event = blank(SDL_CONTROLLERDEVICEREMOVED, timestamp += 1);
+        event.cdevice.which = 4;
+        events.push_back(event);
+
+        events.push_back(blank(SDL_QUIT, timestamp += 1));
+        return events;
+    }
+
+    // Frames with events, gaps of one, many (past one varint byte) and no
+    // frames, and an empty tail the replay must also wait out
+    struct Frame {
+        uint64_t number;
+        std::vector<SDL_Event> events;
+    };
+
+    std::vector<Frame> session() {
+        return {
+            { 1, everyKind(1000) },
+            { 2, everyKind(1100) },
+            { 4, { blank(SDL_QUIT, 1200) } },
+            { 300, everyKind(900) },    // The clock going backwards is kept too
+            { 20000, { blank(SDL_QUIT, 70000) } },
+        };
+    }
+    constexpr uint64_t s_lastFrame = 20005;
+
+    // Recorded and replayed events differ only in the timestamp
+    bool isSameEvent(const SDL_Event& recorded, SDL_Event replayed) {
+        replayed.common.timestamp = recorded.common.timestamp;
+        return std::memcmp(&recorded, &replayed, sizeof(SDL_Event)) == 0;
+    }
+
+    bool record(const std::vector<Frame>& frames) {
+        InputRecording recording;
+        if (!recording.startRecording(s_path)) return false;
+
+        // Not kept: these must not reach the file
+        SDL_Event added = blank(SDL_CONTROLLERDEVICEADDED, 5);
+        SDL_Event joystick = blank(SDL_JOYAXISMOTION, 5);
+        SDL_Event user = blank(SDL_USEREVENT, 5);
+
+        std::size_t next = 0;
+        while (recording.frame() < s_lastFrame) {
+            recording.beginFrame();
+            recording.record(added);
+            if (next < frames.size() && frames[next].number == recording.frame()) {
+                for (const SDL_Event& event : frames[next].events) {
+                    recording.record(event);
+                    recording.record(joystick);
+                }
+                ++next;
+            }
+            recording.record(user);
+        }
+        CHECK(recording.mode() == InputRecording::Mode::Recording);
+        const bool ok = recording.finish();
+        CHECK(recording.mode() == InputRecording::Mode::Off);
+        return ok;
+    }
+
+    void testRoundTrip() {
+        const std::vector<Frame> frames = session();
+        CHECK(record(frames));
+
+        InputRecording replay;
+        CHECK(replay.startReplay(s_path));
+        CHECK(replay.mode() == InputRecording::Mode::Replaying);
+
+        std::size_t next = 0;
+        std::size_t mismatches = 0;
+        std::size_t replayed = 0;
+        SDL_Event event;
+        while (!replay.isReplayDone() && replay.frame() <= s_lastFrame) {
+            replay.beginFrame();
+            std::vector<SDL_Event> events;
+            while (replay.nextEvent(event)) {
+                events.push_back(event);
+            }
+            replayed += events.size();
+
+            if (next < frames.size() && frames[next].number == replay.frame()) {
+                const std::vector<SDL_Event>& expected = frames[next].events;
+                if (events.size() != expected.size()) {
+                    std::fprintf(stderr, "frame %llu: %zu events, recorded %zu\n",
+                        static_cast<unsigned long long>(replay.frame()), events.size(), expected.size());
+                    ++mismatches;
+                    continue;
+                }
+                for (std::size_t i = 0; i < events.size(); ++i) {
+                    if (!isSameEvent(expected[i], events[i])) {
+                        std::fprintf(stderr, "frame %llu: event %zu (type 0x%x) differs\n",
+                            static_cast<unsigned long long>(replay.frame()), i, expected[i].type);
+                        ++mismatches;
+                    }
+                }
+                ++next;
+            }
+            else if (!events.empty()) {
+                std::fprintf(stderr, "frame %llu: %zu events, recorded none\n",
+                    static_cast<unsigned long long>(replay.frame()), events.size());
+                ++mismatches;
+            }
+        }
+
+        std::size_t recorded = 0;
+        for (const Frame& frame : frames) recorded += frame.events.size();
+        CHECK(mismatches == 0);
+        CHECK(next == frames.size());
+        CHECK(replayed == recorded);
+        CHECK(replay.isReplayDone());
+        CHECK(replay.frame() == s_lastFrame);
+        CHECK(!replay.nextEvent(event));
+        CHECK(replay.finish());
+        CHECK(replay.mode() == InputRecording::Mode::Off);
+    }
+
+    // Replays `bytes` to the end; the number of events that came back
+    std::size_t replayDamaged(const std::string& bytes, bool& started) {
+        CHECK(FileManager::writeLocalFile(s_damagedPath, bytes));
+        InputRecording replay;
+        started = replay.startReplay(s_damagedPath);
+        std::size_t events = 0;
+        SDL_Event event;
+        while (started && !replay.isReplayDone() && replay.frame() <= s_lastFrame) {
+            replay.beginFrame();
+            while (replay.nextEvent(event)) ++events;
+        }
+        CHECK(!started || replay.isReplayDone());
+        replay.finish();
+        return events;
+    }
+
+    void testDamagedFiles() {
+        std::string bytes;
+        CHECK(FileManager::readLocalFile(s_path, bytes));
+        CHECK(bytes.size() > 16);
+        bool started = false;
+
+        // Wrong magic, an unknown version, and too short for a header
+        std::string wrong = bytes;
+        wrong[0] = 'X';
+        replayDamaged(wrong, started);
+        CHECK(!started);
+        wrong = bytes;
+        wrong[4] = 2;
+        replayDamaged(wrong, started);
+        CHECK(!started);
+        replayDamaged(bytes.substr(0, 6), started);
+        CHECK(!started);
+
+        // Cut short: it plays what is whole, then stops instead of reading on
+        const std::size_t whole = 3 * everyKind(0).size() + 2;
+        for (std::size_t length : { std::size_t(9), bytes.size() / 3, bytes.size() / 2, bytes.size() - 3 }) {
+            CHECK(replayDamaged(bytes.substr(0, length), started) < whole);
+        }
+        // Only the End record missing: every event still plays
+        CHECK(replayDamaged(bytes.substr(0, bytes.size() - 1), started) == whole);
+
+        // A kind past the known ones
+        std::string badKind = bytes.substr(0, 8);
+        badKind.push_back(1);
+        badKind.push_back(100);
+        CHECK(replayDamaged(badKind, started) == 0);
+        CHECK(!started);
+    }
+}
+
+int main() {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_CRITICAL);
+    testRoundTrip();
+    testDamagedFiles();
+    std::remove(s_path);
+    std::remove(s_damagedPath);
+    return Check::result("input_recording");
+}
@@ -0,0 +1,236 @@
+#include <tests/check.hpp>
+#include <utils/input_system.hpp>
+#include <imgui_internal.h>
+#include <SDL.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Controller state reaching ImGui: a replayed session with two pads, frame by
+// frame, and the key events InputSystem queued for ImGui after each frame.
+// Only changes of the merged value may be sent: no event for a repeated
+// state, stick noise within one 1/64 step or inside the dead zone, or a
+// button another pad still holds; removing a pad releases what only it held.
+// A real pad stays plugged in and held throughout, and the SDL backend's
+// NewFrame runs between frames: once InputSystem has taken gamepads over,
+// the backend must add nothing of its own.
+namespace {
+    constexpr const char* s_recordingPath = "input_system_test.rec";
+
+    constexpr SDL_JoystickID s_pad1 = 1;
+    constexpr SDL_JoystickID s_pad2 = 2;
+
+    struct KeyEvent {
+        ImGuiKey key;
+        bool isDown;
+        float value;
+    };
+
+    SDL_Event button(SDL_JoystickID pad, Uint8 which, bool isDown) {
+        SDL_Event event{};
+        event.type = isDown ? SDL_CONTROLLERBUTTONDOWN : SDL_CONTROLLERBUTTONUP;
+        event.cbutton.which = pad;
+        event.cbutton.button = which;
+        event.cbutton.state = isDown ? SDL_PRESSED : SDL_RELEASED;
+        return event;
+    }
+
+    SDL_Event axis(SDL_JoystickID pad, Uint8 which, Sint16 value) {
+        SDL_Event event{};
+        event.type = SDL_CONTROLLERAXISMOTION;
+        event.caxis.which = pad;
+        event.caxis.axis = which;
+        event.caxis.value = value;
+        return event;
+    }
+
+    SDL_Event removed(SDL_JoystickID pad) {
+        SDL_Event event{};
+        event.type = SDL_CONTROLLERDEVICEREMOVED;
+        event.cdevice.which = pad;
+        return event;
+    }
+
+    // One entry per frame: the events handled on it
+    const std::vector<std::vector<SDL_Event>> s_frames = {
+        // 1: pressed
+        { button(s_pad1, SDL_CONTROLLER_BUTTON_A, true) },
+        // 2: the same state again
+        { button(s_pad1, SDL_CONTROLLER_BUTTON_A, true) },
+        // 3: a second pad presses what is already held
+        { button(s_pad2, SDL_CONTROLLER_BUTTON_A, true) },
+        // 4: the first lets go, the second still holds it
+        { button(s_pad1, SDL_CONTROLLER_BUTTON_A, false) },
+        // 5: stick pushed right, 39/64 of the way
+        { axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTX, 20000) },
+        // 6: noise within the same step
+        { axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTX, 20100), axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTX, 19900) },
+        // 7: back inside the dead zone
+        { axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTX, 5000) },
+        // 8: noise inside the dead zone, on both axes
+        { axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTX, -3000), axis(s_pad1, SDL_CONTROLLER_AXIS_LEFTY, 4000) },
+        // 9: the pad holding A goes away
+        { removed(s_pad2) },
+        // 10: pressed and the pad removed on the same frame
+        { button(s_pad1, SDL_CONTROLLER_BUTTON_DPAD_UP, true), removed(s_pad1) },
+        // 11: nothing
+        {},
+    };
+
+    bool writeRecording() {
+        InputRecording recording;
+        if (!recording.startRecording(s_recordingPath)) return false;
+        for (const std::vector<SDL_Event>& frame : s_frames) {
+            recording.beginFrame();
+            for (const SDL_Event& event : frame) {
+                recording.record(event);
+            }
+        }
+        return recording.finish();
+    }
+
+    // What InputSystem queued for ImGui since the last call
+    std::vector<KeyEvent> takeKeyEvents() {
+        std::vector<KeyEvent> events;
+        ImVector<ImGuiInputEvent>& queue = ImGui::GetCurrentContext()->InputEventsQueue;
+        for (const ImGuiInputEvent& event : queue) {
+            if (event.Type == ImGuiInputEventType_Key) {
+                events.push_back({ event.Key.Key, event.Key.Down, event.Key.AnalogValue });
+            }
+        }
+        queue.clear();
+        return events;
+    }
+
+    bool isEvent(const KeyEvent& event, ImGuiKey key, bool isDown, float value) {
+        return event.key == key && event.isDown == isDown && event.value == value;
+    }
+
+    // A virtual pad holding A, which the backend would pick up on its own
+    SDL_Joystick* attachHeldPad(int& index) {
+        SDL_VirtualJoystickDesc desc;
+        SDL_zero(desc);
+        desc.version = SDL_VIRTUAL_JOYSTICK_DESC_VERSION;
+        desc.type = SDL_JOYSTICK_TYPE_GAMECONTROLLER;
+        desc.naxes = SDL_CONTROLLER_AXIS_MAX;
+        desc.nbuttons = SDL_CONTROLLER_BUTTON_MAX;
+        desc.name = "input_system_test pad";
+        index = SDL_JoystickAttachVirtualEx(&desc);
+        if (index < 0) {
+            std::fprintf(stderr, "SDL_JoystickAttachVirtualEx failed: %s\n", SDL_GetError());
+            return nullptr;
+        }
+        if (!SDL_IsGameController(index)) {
+            char guid[33];
+            SDL_JoystickGetGUIDString(SDL_JoystickGetDeviceGUID(index), guid, sizeof(guid));
+            const std::string mapping = std::string(guid) + ",input_system_test pad,a:b0,";
+            SDL_GameControllerAddMapping(mapping.c_str());
+        }
+        SDL_Joystick* joystick = SDL_JoystickOpen(index);
+        if (joystick) {
+            SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, SDL_PRESSED);
+            SDL_JoystickUpdate();
+        }
+        return joystick;
+    }
+
+    // What the backend itself queued on a NewFrame
+    std::vector<KeyEvent> backendKeyEvents() {
+        ImGui_ImplSDL2_NewFrame();
+        InputSystem::markImGuiGamepads(ImGui::GetIO());
+        return takeKeyEvents();
+    }
+
+    // Left to itself the backend opens the pad and sends its state
+    void testBackendSeesPad() {
+        const std::vector<KeyEvent> events = backendKeyEvents();
+        bool isHeld = false;
+        for (const KeyEvent& event : events) {
+            isHeld = isHeld || isEvent(event, ImGuiKey_GamepadFaceDown, true, 1.0f);
+        }
+        CHECK(isHeld);
+    }
+
+    void testPadDiffs() {
+        CHECK(writeRecording());
+
+        InputSystem input;
+        CHECK(input.recording().startReplay(s_recordingPath));
+
+        InputSystem::takeOverImGuiGamepads();
+        CHECK(backendKeyEvents().empty());
+
+        std::vector<std::vector<KeyEvent>> sent;
+        std::size_t backendEvents = 0;
+        bool hasGamepad = true;
+        bool isRunning = true;
+        while (isRunning && sent.size() < s_frames.size() + 2) {
+            input.processEvents(isRunning);
+            sent.push_back(takeKeyEvents());
+            backendEvents += backendKeyEvents().size();
+            hasGamepad = hasGamepad && (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_HasGamepad);
+        }
+        input.recording().finish();
+
+        CHECK(backendEvents == 0);
+        CHECK(hasGamepad);
+
+        CHECK(sent.size() == s_frames.size());
+        if (sent.size() != s_frames.size()) return;
+        for (std::size_t frame = 0; frame < sent.size(); ++frame) {
+            std::printf("frame %zu: %zu event(s)\n", frame + 1, sent[frame].size());
+        }
+
+        CHECK(sent[0].size() == 1 && isEvent(sent[0][0], ImGuiKey_GamepadFaceDown, true, 1.0f));
+        CHECK(sent[1].empty());
+        CHECK(sent[2].empty());
+        CHECK(sent[3].empty());
+        CHECK(sent[4].size() == 1 && isEvent(sent[4][0], ImGuiKey_GamepadLStickRight, true, 39.0f / 64.0f));
+        CHECK(sent[5].empty());
+        CHECK(sent[6].size() == 1 && isEvent(sent[6][0], ImGuiKey_GamepadLStickRight, false, 0.0f));
+        CHECK(sent[7].empty());
+        CHECK(sent[8].size() == 1 && isEvent(sent[8][0], ImGuiKey_GamepadFaceDown, false, 0.0f));
+        CHECK(sent[9].size() == 2 && isEvent(sent[9][0], ImGuiKey_GamepadDpadUp, true, 1.0f)
+              && isEvent(sent[9][1], ImGuiKey_GamepadDpadUp, false, 0.0f));
+        CHECK(sent[10].empty());
+        CHECK(input.controllerCount() == 0);
+    }
+}
+
+int main() {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+
+    // The SDL backend needs a window; the dummy driver gives one without a display
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("input_system", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 64, 64,
+        SDL_WINDOW_HIDDEN);
+    CHECK(window != nullptr);
+
+    int padIndex = -1;
+    SDL_Joystick* pad = attachHeldPad(padIndex);
+    CHECK(pad != nullptr);
+
+    ImGui::CreateContext();
+    // As in Game::play(): the backend only reads pads with gamepad navigation on
+    ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+    if (window && pad && ImGui_ImplSDL2_InitForOther(window)) {
+        testBackendSeesPad();
+        testPadDiffs();
+        ImGui_ImplSDL2_Shutdown();
+    }
+    ImGui::DestroyContext();
+
+    if (pad) {
+        SDL_JoystickClose(pad);
+        SDL_JoystickDetachVirtual(padIndex);
+    }
+
+    std::remove(s_recordingPath);
+    if (window) SDL_DestroyWindow(window);
+    SDL_Quit();
+    return Check::result("input_system");
+}
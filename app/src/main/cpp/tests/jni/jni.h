@@ -0,0 +1,153 @@
+#pragma once
+// Host stand-in for the NDK's <jni.h>, cut down to what utils/jni_bridge
+// uses. Same shape as the real header: JNIEnv is a pointer to a function
+// table and the C++ member functions forward through it, so a test fills in
+// the table with fakes and the bridge code compiles unchanged.
+#include <cstdarg>
+#include <cstdint>
+
+typedef uint8_t  jboolean;
+typedef int8_t   jbyte;
+typedef uint16_t jchar;
+typedef int16_t  jshort;
+typedef int32_t  jint;
+typedef int64_t  jlong;
+typedef float    jfloat;
+typedef double   jdouble;
+typedef jint     jsize;
+
+class _jobject {};
+class _jclass : public _jobject {};
+class _jstring : public _jobject {};
+class _jarray : public _jobject {};
+class _jbyteArray : public _jarray {};
+class _jthrowable : public _jobject {};
+
+typedef _jobject*    jobject;
+typedef _jclass*     jclass;
+typedef _jstring*    jstring;
+typedef _jarray*     jarray;
+typedef _jbyteArray* jbyteArray;
+typedef _jthrowable* jthrowable;
+
+struct _jmethodID;
+typedef struct _jmethodID* jmethodID;
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+#define JNI_OK 0
+#define JNI_ERR (-1)
+
+#define JNI_VERSION_1_6 0x00010006
+
+#define JNIEXPORT __attribute__((visibility("default")))
+#define JNICALL
+
+struct _JNIEnv;
+struct _JavaVM;
+typedef _JNIEnv JNIEnv;
+typedef _JavaVM JavaVM;
+
+struct JNINativeInterface {
+    jclass (*FindClass)(JNIEnv*, const char*);
+    jint (*PushLocalFrame)(JNIEnv*, jint);
+    jobject (*PopLocalFrame)(JNIEnv*, jobject);
+    jobject (*NewGlobalRef)(JNIEnv*, jobject);
+    void (*DeleteGlobalRef)(JNIEnv*, jobject);
+    void (*DeleteLocalRef)(JNIEnv*, jobject);
+    jboolean (*ExceptionCheck)(JNIEnv*);
+    void (*ExceptionClear)(JNIEnv*);
+
+    jmethodID (*GetMethodID)(JNIEnv*, jclass, const char*, const char*);
+    jobject (*CallObjectMethodV)(JNIEnv*, jobject, jmethodID, va_list);
+    jboolean (*CallBooleanMethodV)(JNIEnv*, jobject, jmethodID, va_list);
+    jint (*CallIntMethodV)(JNIEnv*, jobject, jmethodID, va_list);
+    void (*CallVoidMethodV)(JNIEnv*, jobject, jmethodID, va_list);
+
+    jmethodID (*GetStaticMethodID)(JNIEnv*, jclass, const char*, const char*);
+    jobject (*CallStaticObjectMethodV)(JNIEnv*, jclass, jmethodID, va_list);
+    jboolean (*CallStaticBooleanMethodV)(JNIEnv*, jclass, jmethodID, va_list);
+    jint (*CallStaticIntMethodV)(JNIEnv*, jclass, jmethodID, va_list);
+    void (*CallStaticVoidMethodV)(JNIEnv*, jclass, jmethodID, va_list);
+
+    jstring (*NewString)(JNIEnv*, const jchar*, jsize);
+    jsize (*GetStringLength)(JNIEnv*, jstring);
+    const jchar* (*GetStringChars)(JNIEnv*, jstring, jboolean*);
+    void (*ReleaseStringChars)(JNIEnv*, jstring, const jchar*);
+};
+
+#define JNI_STUB_CALL_V(Result, Name, Target)                                   \
+    Result Name(Target target, jmethodID method, ...) {                        \
+        va_list args;                                                           \
+        va_start(args, method);                                                 \
+        Result result = functions->Name##V(this, target, method, args);         \
+        va_end(args);                                                           \
+        return result;                                                          \
+    }
+
+struct _JNIEnv {
+    const JNINativeInterface* functions;
+
+    jclass FindClass(const char* name) { return functions->FindClass(this, name); }
+    jint PushLocalFrame(jint capacity) { return functions->PushLocalFrame(this, capacity); }
+    jobject PopLocalFrame(jobject result) { return functions->PopLocalFrame(this, result); }
+    jobject NewGlobalRef(jobject object) { return functions->NewGlobalRef(this, object); }
+    void DeleteGlobalRef(jobject object) { functions->DeleteGlobalRef(this, object); }
+    void DeleteLocalRef(jobject object) { functions->DeleteLocalRef(this, object); }
+    jboolean ExceptionCheck() { return functions->ExceptionCheck(this); }
+    void ExceptionClear() { functions->ExceptionClear(this); }
+
+    jmethodID GetMethodID(jclass cls, const char* name, const char* signature) {
+        return functions->GetMethodID(this, cls, name, signature);
+    }
+    jmethodID GetStaticMethodID(jclass cls, const char* name, const char* signature) {
+        return functions->GetStaticMethodID(this, cls, name, signature);
+    }
+
+    JNI_STUB_CALL_V(jobject, CallObjectMethod, jobject)
+    JNI_STUB_CALL_V(jboolean, CallBooleanMethod, jobject)
+    JNI_STUB_CALL_V(jint, CallIntMethod, jobject)
+    JNI_STUB_CALL_V(jobject, CallStaticObjectMethod, jclass)
+    JNI_STUB_CALL_V(jboolean, CallStaticBooleanMethod, jclass)
+    JNI_STUB_CALL_V(jint, CallStaticIntMethod, jclass)
+
+    void CallVoidMethod(jobject object, jmethodID method, ...) {
+        va_list args;
+        va_start(args, method);
+        functions->CallVoidMethodV(this, object, method, args);
+        va_end(args);
+    }
+    void CallStaticVoidMethod(jclass cls, jmethodID method, ...) {
+        va_list args;
+        va_start(args, method);
+        functions->CallStaticVoidMethodV(this, cls, method, args);
+        va_end(args);
+    }
+
+    jstring NewString(const jchar* chars, jsize length) { return functions->NewString(this, chars, length); }
+    jsize GetStringLength(jstring string) { return functions->GetStringLength(this, string); }
+    const jchar* GetStringChars(jstring string, jboolean* isCopy) {
+        return functions->GetStringChars(this, string, isCopy);
+    }
+    void ReleaseStringChars(jstring string, const jchar* chars) {
+        functions->ReleaseStringChars(this, string, chars);
+    }
+};
+
+#undef JNI_STUB_CALL_V
+
+struct JNIInvokeInterface {
+    jint (*GetEnv)(JavaVM*, void**, jint);
+};
+
+struct _JavaVM {
+    const JNIInvokeInterface* functions;
+
+    jint GetEnv(void** env, jint version) { return functions->GetEnv(this, env, version); }
+};
+
+extern "C" {
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved);
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void* reserved);
+}
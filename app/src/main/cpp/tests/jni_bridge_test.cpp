@@ -0,0 +1,396 @@
+#include <tests/check.hpp>
+#include <utils/jni_bridge.hpp>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Built with __ANDROID__ against tests/jni/jni.h: a fake JNIEnv function table
+// that hands out opaque handles and keeps count of every local and global
+// reference, frame and ID lookup the bridge makes.
+namespace {
+    struct FakeJvm {
+        JNINativeInterface table{};
+        JNIInvokeInterface invoke{};
+        JNIEnv env{};
+        JavaVM vm{};
+
+        std::set<std::string> missingClasses;
+        std::set<std::string> missingMethods;
+
+        // frames[0] is the implicit frame of a native call
+        std::vector<std::vector<jobject>> frames{ 1 };
+        std::set<jobject> locals;
+        std::set<jobject> globals;
+        std::map<jobject, std::u16string> strings;
+        uintptr_t nextHandle = 0x1000;
+
+        bool isExceptionPending = false;
+        bool failPushFrame = false;
+
+        int findClassCalls = 0;
+        int methodIdCalls = 0;
+        int staticCalls = 0;
+        int instanceCalls = 0;
+        int badDeletes = 0;
+        int pendingChars = 0;
+    };
+
+    FakeJvm* s_jvm = nullptr;
+
+    jobject newLocal() {
+        const jobject handle = reinterpret_cast<jobject>(s_jvm->nextHandle);
+        s_jvm->nextHandle += 16;
+        s_jvm->locals.insert(handle);
+        s_jvm->frames.back().push_back(handle);
+        return handle;
+    }
+
+    void deleteLocal(jobject object) {
+        if (s_jvm->locals.erase(object) == 0) {
+            ++s_jvm->badDeletes;
+            return;
+        }
+        for (auto& frame : s_jvm->frames) {
+            for (auto it = frame.begin(); it != frame.end(); ++it) {
+                if (*it == object) {
+                    frame.erase(it);
+                    return;
+                }
+            }
+        }
+    }
+
+    jmethodID newMethodId(const char* name) {
+        ++s_jvm->methodIdCalls;
+        if (s_jvm->missingMethods.count(name)) {
+            s_jvm->isExceptionPending = true;
+            return nullptr;
+        }
+        const jmethodID id = reinterpret_cast<jmethodID>(s_jvm->nextHandle);
+        s_jvm->nextHandle += 16;
+        return id;
+    }
+
+    void installFakes(FakeJvm& jvm) {
+        JNINativeInterface& t = jvm.table;
+
+        t.FindClass = [](JNIEnv*, const char* name) -> jclass {
+            ++s_jvm->findClassCalls;
+            if (s_jvm->missingClasses.count(name)) {
+                s_jvm->isExceptionPending = true;
+                return nullptr;
+            }
+            return static_cast<jclass>(newLocal());
+        };
+        t.PushLocalFrame = [](JNIEnv*, jint) -> jint {
+            if (s_jvm->failPushFrame) {
+                s_jvm->isExceptionPending = true;   // OutOfMemoryError
+                return JNI_ERR;
+            }
+            s_jvm->frames.emplace_back();
+            return JNI_OK;
+        };
+        t.PopLocalFrame = [](JNIEnv*, jobject) -> jobject {
+            for (jobject object : s_jvm->frames.back()) {
+                s_jvm->locals.erase(object);
+            }
+            s_jvm->frames.pop_back();
+            return nullptr;
+        };
+        t.NewGlobalRef = [](JNIEnv*, jobject object) -> jobject {
+            if (!s_jvm->locals.count(object) && !s_jvm->globals.count(object)) {
+                return nullptr;
+            }
+            const jobject handle = reinterpret_cast<jobject>(s_jvm->nextHandle);
+            s_jvm->nextHandle += 16;
+            s_jvm->globals.insert(handle);
+            return handle;
+        };
+        t.DeleteGlobalRef = [](JNIEnv*, jobject object) {
+            if (s_jvm->globals.erase(object) == 0) ++s_jvm->badDeletes;
+        };
+        t.DeleteLocalRef = [](JNIEnv*, jobject object) { deleteLocal(object); };
+        t.ExceptionCheck = [](JNIEnv*) -> jboolean { return s_jvm->isExceptionPending ? JNI_TRUE : JNI_FALSE; };
+        t.ExceptionClear = [](JNIEnv*) { s_jvm->isExceptionPending = false; };
+
+        t.GetMethodID = [](JNIEnv*, jclass, const char* name, const char*) { return newMethodId(name); };
+        t.GetStaticMethodID = [](JNIEnv*, jclass, const char* name, const char*) { return newMethodId(name); };
+
+        t.CallObjectMethodV = [](JNIEnv*, jobject, jmethodID, va_list) -> jobject { ++s_jvm->instanceCalls; return newLocal(); };
+        t.CallBooleanMethodV = [](JNIEnv*, jobject, jmethodID, va_list) -> jboolean { ++s_jvm->instanceCalls; return JNI_TRUE; };
+        t.CallIntMethodV = [](JNIEnv*, jobject, jmethodID, va_list) -> jint { ++s_jvm->instanceCalls; return 1; };
+        t.CallVoidMethodV = [](JNIEnv*, jobject, jmethodID, va_list) { ++s_jvm->instanceCalls; };
+        t.CallStaticObjectMethodV = [](JNIEnv*, jclass, jmethodID, va_list) -> jobject { ++s_jvm->staticCalls; return newLocal(); };
+        t.CallStaticBooleanMethodV = [](JNIEnv*, jclass, jmethodID, va_list) -> jboolean { ++s_jvm->staticCalls; return JNI_TRUE; };
+        t.CallStaticIntMethodV = [](JNIEnv*, jclass, jmethodID, va_list) -> jint { ++s_jvm->staticCalls; return 1; };
+        t.CallStaticVoidMethodV = [](JNIEnv*, jclass, jmethodID, va_list) { ++s_jvm->staticCalls; };
+
+        t.NewString = [](JNIEnv*, const jchar* chars, jsize length) -> jstring {
+            const jobject handle = newLocal();
+            s_jvm->strings[handle].assign(reinterpret_cast<const char16_t*>(chars), static_cast<std::size_t>(length));
+            return static_cast<jstring>(handle);
+        };
+        t.GetStringLength = [](JNIEnv*, jstring string) -> jsize {
+            return static_cast<jsize>(s_jvm->strings[string].size());
+        };
+        t.GetStringChars = [](JNIEnv*, jstring string, jboolean*) -> const jchar* {
+            ++s_jvm->pendingChars;
+            return reinterpret_cast<const jchar*>(s_jvm->strings[string].data());
+        };
+        t.ReleaseStringChars = [](JNIEnv*, jstring, const jchar*) { --s_jvm->pendingChars; };
+
+        jvm.invoke.GetEnv = [](JavaVM*, void** env, jint) -> jint {
+            *env = &s_jvm->env;
+            return JNI_OK;
+        };
+
+        jvm.env.functions = &jvm.table;
+        jvm.vm.functions = &jvm.invoke;
+        s_jvm = &jvm;
+    }
+
+    void testLocalRef() {
+        FakeJvm jvm;
+        installFakes(jvm);
+        JNIEnv* env = &jvm.env;
+
+        {
+            Jni::LocalRef<jobject> ref(env, newLocal());
+            CHECK(jvm.locals.size() == 1);
+        }
+        CHECK(jvm.locals.empty());
+
+        // Moves hand the reference over; only the final owner deletes it
+        {
+            Jni::LocalRef<jobject> first(env, newLocal());
+            Jni::LocalRef<jobject> second(std::move(first));
+            CHECK(!first);
+            CHECK(second);
+            Jni::LocalRef<jobject> third;
+            third = std::move(second);
+            CHECK(jvm.locals.size() == 1);
+        }
+        CHECK(jvm.locals.empty());
+
+        // Assigning over a held reference releases the old one first
+        {
+            Jni::LocalRef<jobject> held(env, newLocal());
+            held = Jni::LocalRef<jobject>(env, newLocal());
+            CHECK(jvm.locals.size() == 1);
+            held.reset(newLocal());
+            CHECK(jvm.locals.size() == 1);
+        }
+        CHECK(jvm.locals.empty());
+
+        // release() gives up ownership without deleting
+        jobject released = nullptr;
+        {
+            Jni::LocalRef<jobject> ref(env, newLocal());
+            released = ref.release();
+        }
+        CHECK(jvm.locals.count(released) == 1);
+        deleteLocal(released);
+
+        CHECK(jvm.badDeletes == 0);
+    }
+
+    void testLocalFrame() {
+        FakeJvm jvm;
+        installFakes(jvm);
+        JNIEnv* env = &jvm.env;
+
+        {
+            Jni::LocalFrame frame(env);
+            CHECK(frame.isInit());
+            CHECK(jvm.frames.size() == 2);
+            for (int i = 0; i < 10; ++i) newLocal();
+            CHECK(jvm.locals.size() == 10);
+        }
+        CHECK(jvm.frames.size() == 1);
+        CHECK(jvm.locals.empty());
+
+        // A LocalRef released inside the frame is not deleted twice on pop
+        {
+            Jni::LocalFrame frame(env);
+            Jni::LocalRef<jobject> ref(env, newLocal());
+        }
+        CHECK(jvm.locals.empty());
+        CHECK(jvm.badDeletes == 0);
+
+        // A failed push leaves nothing to pop and clears the exception
+        jvm.failPushFrame = true;
+        {
+            Jni::LocalFrame frame(env);
+            CHECK(!frame.isInit());
+            CHECK(!jvm.isExceptionPending);
+        }
+        CHECK(jvm.frames.size() == 1);
+
+        // Without an env nothing is pushed at all
+        {
+            Jni::LocalFrame frame(nullptr);
+            CHECK(!frame.isInit());
+        }
+    }
+
+    void testBindingsAreResolvedOnce() {
+        FakeJvm jvm;
+        installFakes(jvm);
+        JNIEnv* env = &jvm.env;
+
+        CHECK(JNI_OnLoad(&jvm.vm, nullptr) == JNI_VERSION_1_6);
+        CHECK(Jni::isInit());
+
+        // Every class is promoted to a global and its local deleted straight away
+        const Jni::Bindings& b = Jni::bindings();
+        CHECK(jvm.findClassCalls == 7);
+        CHECK(jvm.globals.size() == 7);
+        CHECK(jvm.locals.empty());
+        CHECK(b.fileManager && jvm.globals.count(b.fileManager));
+        CHECK(b.readFileBytes.id && b.readFileBytes.cls == b.fileManager);
+        CHECK(b.getPackageManager.id && b.intentInit.id && b.uriParse.id);
+
+        const int lookups = jvm.methodIdCalls;
+        CHECK(lookups == 17);     // 10 static and 7 instance methods
+
+        // Later init calls and calls through the bindings reuse the cached IDs
+        CHECK(Jni::init(env));
+        CHECK(Jni::env() == env);
+        {
+            Jni::LocalRef<jobject> activity = Jni::activity(env);
+            Jni::LocalFrame frame(env);
+            Jni::LocalRef<jstring> path = Jni::newString(env, "decor/a.png");
+            for (int i = 0; i < 100; ++i) {
+                CHECK(Jni::callStatic<jboolean>(env, b.fdExists, activity.get(), path.get()) == JNI_TRUE);
+            }
+            Jni::callStatic<void>(env, b.pickImageFromGallery);
+            Jni::LocalRef<jobject> pm = Jni::callObject<jobject>(env, activity.get(), b.getPackageManager);
+            CHECK(pm);
+        }
+        CHECK(jvm.findClassCalls == 7);
+        CHECK(jvm.methodIdCalls == lookups);
+        CHECK(jvm.staticCalls == 101);
+        CHECK(jvm.instanceCalls == 1);
+        CHECK(jvm.locals.empty());
+
+        // Unload drops every global again
+        JNI_OnUnload(&jvm.vm, nullptr);
+        CHECK(!Jni::isInit());
+        CHECK(jvm.globals.empty());
+        CHECK(jvm.badDeletes == 0);
+    }
+
+    void testMissingClassesAndMethods() {
+        FakeJvm jvm;
+        installFakes(jvm);
+        jvm.missingClasses.insert("android/net/Uri");
+        jvm.missingMethods.insert("copyFile");
+        JNIEnv* env = &jvm.env;
+
+        // Optional pieces missing: still usable, with those IDs left null
+        CHECK(Jni::init(env));
+        const Jni::Bindings& b = Jni::bindings();
+        CHECK(!jvm.isExceptionPending);
+        CHECK(b.uri == nullptr);
+        CHECK(b.uriParse.id == nullptr);
+        CHECK(b.copyFile.id == nullptr);
+        CHECK(b.writeFileBytes.id != nullptr);
+        CHECK(jvm.globals.size() == 6);
+        CHECK(jvm.locals.empty());
+
+        // Calls through a missing ID return a default instead of reaching JNI
+        const int calls = jvm.staticCalls;
+        Jni::LocalRef<jobject> uri = Jni::callStaticObject<jobject>(env, b.uriParse, static_cast<jstring>(nullptr));
+        CHECK(!uri);
+        {
+            Jni::LocalRef<jobject> activity = Jni::activity(env);
+            CHECK(Jni::callStatic<jboolean>(env, b.copyFile, activity.get(), static_cast<jstring>(nullptr),
+                static_cast<jstring>(nullptr)) == JNI_FALSE);
+        }
+        CHECK(jvm.staticCalls == calls);
+        CHECK(jvm.locals.empty());
+        Jni::shutdown(env);
+        CHECK(jvm.globals.empty());
+
+        // Without the app's own FileManager class the bindings are unusable
+        FakeJvm broken;
+        installFakes(broken);
+        broken.missingClasses.insert("com/ipoleksenko/sense/customizer/FileManager");
+        CHECK(!Jni::init(&broken.env));
+        CHECK(!Jni::isInit());
+        Jni::shutdown(&broken.env);
+        CHECK(broken.globals.empty());
+    }
+
+    void testSignatureCheck() {
+#if !defined(NDEBUG)
+        FakeJvm jvm;
+        installFakes(jvm);
+        JNIEnv* env = &jvm.env;
+        CHECK(Jni::init(env));
+        const Jni::Bindings& b = Jni::bindings();
+
+        // Wrong argument count, wrong argument type and wrong return type
+        // are all refused before the call reaches JNI
+        Jni::LocalRef<jobject> activity = Jni::activity(env);
+        CHECK(Jni::callStatic<jboolean>(env, b.fdExists, activity.get()) == JNI_FALSE);
+        CHECK(Jni::callStatic<jboolean>(env, b.fdExists, activity.get(), jint(1)) == JNI_FALSE);
+        CHECK(Jni::callStatic<jint>(env, b.fdExists, activity.get(), static_cast<jstring>(nullptr)) == 0);
+        CHECK(jvm.staticCalls == 0);
+
+        // An array fits where a jobject is declared, but not the other way round
+        CHECK(Jni::detail::checkSignature<jboolean, jobject, jobject>("f", "([BLjava/lang/String;)Z"));
+        CHECK(!Jni::detail::checkSignature<jboolean, jbyteArray, jobject>("f", "(Ljava/lang/Object;Ljava/lang/String;)Z"));
+        CHECK(Jni::detail::checkSignature<void, jstring, jint>("f", "(Ljava/lang/String;I)V"));
+        CHECK(!Jni::detail::checkSignature<void>("f", "V"));
+        Jni::shutdown(env);
+#endif
+    }
+
+    void testStrings() {
+        FakeJvm jvm;
+        installFakes(jvm);
+        JNIEnv* env = &jvm.env;
+
+        // Embedded NUL, 2-, 3- and 4-byte sequences all survive the round trip
+        const std::string text = std::string("a\0b", 3) + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+        {
+            Jni::LocalRef<jstring> string = Jni::newString(env, text);
+            CHECK(jvm.strings[string.get()].size() == 7);   // The emoji is a surrogate pair
+            CHECK(Jni::toString(env, string.get()) == text);
+        }
+        CHECK(jvm.pendingChars == 0);
+        CHECK(jvm.locals.empty());
+
+        // Malformed input becomes U+FFFD rather than being dropped
+        Jni::LocalRef<jstring> broken = Jni::newString(env, "x\xC3");
+        CHECK(Jni::toString(env, broken.get()) == "x\xEF\xBF\xBD");
+
+        // Bytes that cannot lead a sequence are replaced one by one, and do
+        // not swallow the bytes after them
+        Jni::LocalRef<jstring> invalidLeads = Jni::newString(env, "\xF8\x41\xFF\xC0\x80\xC1\xBFz");
+        CHECK(jvm.strings[invalidLeads.get()] == u"\uFFFD" u"A" u"\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD" u"z");
+        CHECK(Jni::toString(env, nullptr).empty());
+    }
+}
+
+// SDL's Android glue, which the desktop SDL library does not have
+void* SDLCALL SDL_AndroidGetJNIEnv(void) {
+    return s_jvm ? &s_jvm->env : nullptr;
+}
+
+void* SDLCALL SDL_AndroidGetActivity(void) {
+    return s_jvm ? newLocal() : nullptr;
+}
+
+int main() {
+    testLocalRef();
+    testLocalFrame();
+    testBindingsAreResolvedOnce();
+    testMissingClassesAndMethods();
+    testSignatureCheck();
+    testStrings();
+    return Check::result("jni_bridge");
+}
@@ -0,0 +1,72 @@
+set(MODULE_NAME tests)
+set(MODULE_DIR ${SOURCE_DIR}/${MODULE_NAME})
+set(INCLUDE_DIR ${MODULE_DIR}/${MODULE_NAME})
+set(MODULE_TARGET ${PROJECT_NAME}_${MODULE_NAME})
+
+set(MODULE_HEADERS
+    ${INCLUDE_DIR}/check.hpp
+    ${INCLUDE_DIR}/bench.hpp
+    ${INCLUDE_DIR}/alloc_counter.hpp
+)
+
+# Benchmarks are built with the tests but left out of ctest; run them by hand
+# from the build directory, before and after a change, in a Release build.
+add_custom_target(${PROJECT_NAME}_benchmarks)
+
+# <name>_test.cpp becomes ${PROJECT_NAME}_test_<name>, registered with ctest
+function(sense_add_test name)
+    set(target ${PROJECT_NAME}_test_${name})
+    add_executable(${target} ${MODULE_DIR}/${name}_test.cpp ${MODULE_HEADERS} ${ARGN})
+    target_include_directories(${target} PRIVATE ${MODULE_DIR})
+    target_compile_definitions(${target} PRIVATE SDL_MAIN_HANDLED)
+    target_link_libraries(${target} PRIVATE ${PROJECT_NAME}_utils)
+    add_test(NAME ${name} COMMAND ${target} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    set_tests_properties(${name} PROPERTIES TIMEOUT 120)
+endfunction()
+
+# <name>_bench.cpp becomes ${PROJECT_NAME}_bench_<name>
+function(sense_add_bench name)
+    set(target ${PROJECT_NAME}_bench_${name})
+    add_executable(${target} ${MODULE_DIR}/${name}_bench.cpp ${MODULE_HEADERS} ${ARGN})
+    target_include_directories(${target} PRIVATE ${MODULE_DIR})
+    target_compile_definitions(${target} PRIVATE SDL_MAIN_HANDLED)
+    target_link_libraries(${target} PRIVATE ${PROJECT_NAME}_utils)
+    add_dependencies(${PROJECT_NAME}_benchmarks ${target})
+endfunction()
+
+sense_add_test(steam_status)
+sense_add_test(decor_collection)
+sense_add_test(texture_convert)
+sense_add_test(task_scheduler)
+sense_add_test(spsc_ring)
+sense_add_test(input_recording)
+
+# Drives InputSystem through ImGui's SDL backend on a hidden dummy-driver window
+sense_add_test(input_system)
+target_link_libraries(${PROJECT_NAME}_test_input_system PRIVATE imgui-sdl2)
+
+# A replayed session through the game loop's steps, with the debug overlay
+# built in from objects/ rather than linking the whole application
+sense_add_test(frame_skip ${SOURCE_DIR}/objects/debug_overlay.cpp)
+target_include_directories(${PROJECT_NAME}_test_frame_skip PRIVATE ${SOURCE_DIR}/objects)
+target_link_libraries(${PROJECT_NAME}_test_frame_skip PRIVATE imgui-sdl2 imgui-sdlrenderer2)
+
+# These replace operator new to count allocations, as memory tracking does.
+# tab_allocations draws the main window's tabs from the application library.
+if (NOT SENSE_MEMORY_TRACKING)
+    sense_add_test(png_stream)
+    sense_add_test(tab_allocations)
+    target_link_libraries(${PROJECT_NAME}_test_tab_allocations PRIVATE ${PROJECT_NAME}_application)
+endif()
+
+# Builds the Android-only JNI bridge on the host against the stub jni.h, whose
+# JNIEnv function table the test fills in with fakes
+sense_add_test(jni_bridge ${SOURCE_DIR}/utils/jni_bridge.cpp ${MODULE_DIR}/jni/jni.h)
+target_include_directories(${PROJECT_NAME}_test_jni_bridge BEFORE PRIVATE ${MODULE_DIR}/jni)
+target_compile_definitions(${PROJECT_NAME}_test_jni_bridge PRIVATE __ANDROID__)
+
+sense_add_bench(storage_transfer)
+sense_add_bench(config_load)
+sense_add_bench(decor_import)
+sense_add_bench(texture_upload)
+sense_add_bench(task_scheduler)
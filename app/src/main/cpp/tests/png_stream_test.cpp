@@ -0,0 +1,309 @@
+#include <tests/alloc_counter.hpp>
+#include <tests/check.hpp>
+#include <utils/png_stream.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// PngStream against files built here, so every byte of the header and the
+// deflate stream is under the test's control.
+namespace {
+    // ---------- PNG writer ----------
+
+    uint32_t crc32(const uint8_t* data, std::size_t size, uint32_t crc = 0) {
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc ^= data[i];
+            for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        return ~crc;
+    }
+
+    void appendBE32(std::string& out, uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+
+    void appendChunk(std::string& out, const char* type, const std::string& body) {
+        appendBE32(out, static_cast<uint32_t>(body.size()));
+        const std::size_t start = out.size();
+        out.append(type, 4);
+        out += body;
+        appendBE32(out, crc32(reinterpret_cast<const uint8_t*>(out.data() + start), out.size() - start));
+    }
+
+    // `zlib` is the complete IDAT payload
+    std::string makePng(uint32_t width, uint32_t height, uint8_t colorType, uint8_t bitDepth, const std::string& zlib) {
+        std::string png("\x89PNG\r\n\x1A\n", 8);
+        std::string ihdr;
+        appendBE32(ihdr, width);
+        appendBE32(ihdr, height);
+        ihdr += { static_cast<char>(bitDepth), static_cast<char>(colorType), 0, 0, 0 };
+        appendChunk(png, "IHDR", ihdr);
+        appendChunk(png, "IDAT", zlib);
+        appendChunk(png, "IEND", "");
+        return png;
+    }
+
+    // Deflate bit stream, least significant bit first
+    class BitWriter {
+    public:
+        void bits(uint32_t value, int count) {
+            for (int i = 0; i < count; ++i) {
+                if (m_bit == 0) m_bytes.push_back(0);
+                m_bytes.back() = static_cast<char>(m_bytes.back() | (((value >> i) & 1u) << m_bit));
+                m_bit = (m_bit + 1) & 7;
+            }
+        }
+
+        // Huffman codes go most significant bit first
+        void code(uint32_t code, int length) {
+            for (int i = length - 1; i >= 0; --i) bits((code >> i) & 1u, 1);
+        }
+
+        std::string zlib(uint32_t adler) const {
+            std::string out = "\x78\x01";
+            out += m_bytes;
+            appendBE32(out, adler);
+            return out;
+        }
+
+    private:
+        std::string m_bytes;
+        int m_bit = 0;
+    };
+
+    uint32_t adler32(const std::string& data) {
+        uint32_t a = 1, b = 0;
+        for (unsigned char c : data) {
+            a = (a + c) % 65521;
+            b = (b + a) % 65521;
+        }
+        return (b << 16) | a;
+    }
+
+    // Raw scanlines (filter byte included) as stored blocks
+    std::string storedZlib(const std::string& raw) {
+        std::string out = "\x78\x01";
+        std::size_t offset = 0;
+        do {
+            const std::size_t length = std::min<std::size_t>(raw.size() - offset, 65535);
+            const bool last = offset + length == raw.size();
+            out.push_back(last ? 1 : 0);
+            out.push_back(static_cast<char>(length & 0xFF));
+            out.push_back(static_cast<char>(length >> 8));
+            out.push_back(static_cast<char>(~length & 0xFF));
+            out.push_back(static_cast<char>((~length >> 8) & 0xFF));
+            out.append(raw, offset, length);
+            offset += length;
+        } while (offset < raw.size());
+        appendBE32(out, adler32(raw));
+        return out;
+    }
+
+    // `size` zero bytes in one fixed-Huffman block: a literal, then copies of
+    // 258 bytes at distance 1. Tiny for any size, so huge images stay cheap.
+    std::string zerosZlib(uint64_t size) {
+        BitWriter out;
+        out.bits(1, 1);                         // Last block
+        out.bits(1, 2);                         // Fixed codes
+        out.code(0x30, 8);                      // Literal 0
+        uint64_t left = size - 1;
+        for (; left >= 258; left -= 258) {
+            out.code(0xC0 + (285 - 280), 8);    // Length 258
+            out.code(0, 5);                     // Distance 1
+        }
+        for (; left > 0; --left) out.code(0x30, 8);
+        out.code(0, 7);                         // End of block
+
+        // Adler-32 of zeros: a stays 1, b counts the bytes
+        return out.zlib(static_cast<uint32_t>(size % 65521) << 16 | 1);
+    }
+
+    SDL_Surface* makeTarget(int width, int height) {
+        return SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+
+    const uint8_t* pixel(SDL_Surface* surface, int x, int y) {
+        return static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch + x * 4;
+    }
+
+    bool errorContains(const char* text) {
+        return std::strstr(SDL_GetError(), text) != nullptr;
+    }
+
+    // ---------- Tests ----------
+
+    void testBoxFilter() {
+        // 4x2 RGBA: left half red, right half half-transparent blue
+        std::string raw;
+        for (int y = 0; y < 2; ++y) {
+            raw.push_back(0);
+            for (int x = 0; x < 4; ++x) {
+                raw += x < 2 ? std::string("\xFF\x00\x00\xFF", 4) : std::string("\x00\x00\xFF\x80", 4);
+            }
+        }
+        const std::string png = makePng(4, 2, 6, 8, storedZlib(raw));
+
+        int width = 0, height = 0;
+        CHECK(PngStream::previewSize(png.data(), png.size(), 2, 2, width, height));
+        CHECK(width == 2 && height == 1);
+
+        SDL_Surface* target = makeTarget(2, 1);
+        CHECK(PngStream::decodeInto(png.data(), png.size(), target));
+        CHECK(std::memcmp(pixel(target, 0, 0), "\xFF\x00\x00\xFF", 4) == 0);
+        CHECK(std::memcmp(pixel(target, 1, 0), "\x00\x00\xFF\x80", 4) == 0);
+        SDL_FreeSurface(target);
+    }
+
+    void testLargeImageUsesBoundedMemory() {
+        // 16384 x 16384 1-bit grey, all black: 1 GiB once expanded to RGBA
+        constexpr uint32_t s_side = 16384;
+        const std::string png = makePng(s_side, s_side, 0, 1, zerosZlib(uint64_t(s_side) * (s_side / 8 + 1)));
+
+        SDL_Surface* target = makeTarget(256, 256);
+        AllocCounter::resetPeak();
+        const bool decoded = PngStream::decodeInto(png.data(), png.size(), target);
+        const int64_t peak = AllocCounter::peakBytes();
+
+        CHECK(decoded);
+        CHECK(std::memcmp(pixel(target, 0, 0), "\x00\x00\x00\xFF", 4) == 0);
+        CHECK(std::memcmp(pixel(target, 255, 255), "\x00\x00\x00\xFF", 4) == 0);
+        // Per-row buffers and the column map only; nothing sized by the height times the width
+        CHECK(peak < 1024 * 1024);
+        SDL_FreeSurface(target);
+    }
+
+    void testOversizedHeaderIsRejected() {
+        const std::string zlib = zerosZlib(64);
+        for (uint32_t side : { PngStream::s_maxSide + 1, 0x7FFFFFFFu }) {
+            const std::string wide = makePng(side, 1, 6, 16, zlib);
+            const std::string tall = makePng(1, side, 6, 16, zlib);
+
+            int width = 0, height = 0;
+            CHECK(!PngStream::previewSize(wide.data(), wide.size(), 256, 256, width, height));
+            CHECK(errorContains("too large"));
+
+            // Called straight with a target, as TextureUpload::fromImage does
+            SDL_Surface* target = makeTarget(1, 1);
+            AllocCounter::resetPeak();
+            CHECK(!PngStream::decodeInto(wide.data(), wide.size(), target));
+            CHECK(!PngStream::decodeInto(tall.data(), tall.size(), target));
+            CHECK(AllocCounter::peakBytes() < 64 * 1024);
+            CHECK(errorContains("too large"));
+            SDL_FreeSurface(target);
+
+            CHECK(PngStream::loadDownsampled(wide.data(), wide.size(), 256, 256) == nullptr);
+        }
+
+        // The limit itself is accepted
+        const std::string atLimit = makePng(PngStream::s_maxSide, 1, 0, 1, zerosZlib(PngStream::s_maxSide / 8 + 1));
+        SDL_Surface* target = makeTarget(256, 1);
+        CHECK(PngStream::decodeInto(atLimit.data(), atLimit.size(), target));
+        SDL_FreeSurface(target);
+    }
+
+    void testTruncatedStream() {
+        std::string raw;
+        for (int y = 0; y < 64; ++y) {
+            raw.push_back(0);
+            for (int x = 0; x < 64 * 4; ++x) raw.push_back(static_cast<char>(x + y));
+        }
+        const std::string zlib = storedZlib(raw);
+        SDL_Surface* target = makeTarget(16, 16);
+
+        const std::string whole = makePng(64, 64, 6, 8, zlib);
+        CHECK(PngStream::decodeInto(whole.data(), whole.size(), target));
+
+        // Cut inside the deflate data, inside the zlib header, and with no data at all
+        for (std::size_t keep : { zlib.size() / 2, std::size_t(1), std::size_t(0) }) {
+            const std::string cut = makePng(64, 64, 6, 8, zlib.substr(0, keep));
+            CHECK(!PngStream::decodeInto(cut.data(), cut.size(), target));
+        }
+        const std::string half = makePng(64, 64, 6, 8, zlib.substr(0, zlib.size() / 2));
+        PngStream::decodeInto(half.data(), half.size(), target);
+        CHECK(errorContains("truncated"));
+
+        // A complete stream that holds fewer rows than the header promises
+        const std::string shortImage = makePng(64, 65, 6, 8, zlib);
+        CHECK(!PngStream::decodeInto(shortImage.data(), shortImage.size(), target));
+        CHECK(errorContains("ended early"));
+
+        // The file itself cut short: the IDAT chunk runs past the end
+        const std::string clipped = whole.substr(0, whole.size() - 200);
+        CHECK(!PngStream::decodeInto(clipped.data(), clipped.size(), target));
+        SDL_FreeSurface(target);
+    }
+
+    // Dynamic block header: 257 literal/length codes, 1 distance code, all 19 code length codes
+    void dynamicHeader(BitWriter& out, const uint8_t (&codeLengthLengths)[19]) {
+        out.bits(1, 1);
+        out.bits(2, 2);
+        out.bits(0, 5);
+        out.bits(0, 5);
+        out.bits(15, 4);
+        for (uint8_t length : codeLengthLengths) out.bits(length, 3);
+    }
+
+    void testBadHuffmanTables() {
+        SDL_Surface* target = makeTarget(1, 1);
+        auto decodes = [&](const BitWriter& out) {
+            const std::string png = makePng(4, 4, 6, 8, out.zlib(0));
+            return PngStream::decodeInto(png.data(), png.size(), target);
+        };
+
+        // Every code length code one bit long: over-subscribed
+        {
+            BitWriter out;
+            const uint8_t lengths[19] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+            dynamicHeader(out, lengths);
+            CHECK(!decodes(out));
+            CHECK(errorContains("code length table"));
+        }
+
+        // A valid code length code ("0" and "1", one bit each, in the
+        // transmission order 16 17 18 0 8 7 9 6 10 5 11 4 12 3 13 2 14 1 15),
+        // but the literal/length table has no end-of-block code
+        {
+            BitWriter out;
+            const uint8_t lengths[19] = { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0 };
+            dynamicHeader(out, lengths);
+            out.code(1, 1);                             // Literal 0: one bit
+            out.code(1, 1);                             // Literal 1: one bit
+            for (int i = 2; i < 258; ++i) out.code(0, 1);
+            CHECK(!decodes(out));
+            CHECK(errorContains("Huffman table"));
+        }
+
+        // Repeat-previous (16) as the very first length
+        {
+            BitWriter out;
+            const uint8_t lengths[19] = { 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+            dynamicHeader(out, lengths);
+            out.code(1, 1);                             // Symbol 16 (0 gets code 0)
+            out.bits(0, 2);
+            CHECK(!decodes(out));
+            CHECK(errorContains("repeats a missing length"));
+        }
+
+        // Reserved block type 3
+        {
+            BitWriter out;
+            out.bits(1, 1);
+            out.bits(3, 2);
+            CHECK(!decodes(out));
+            CHECK(errorContains("invalid deflate block"));
+        }
+        SDL_FreeSurface(target);
+    }
+}
+
+int main() {
+    testBoxFilter();
+    testLargeImageUsesBoundedMemory();
+    testOversizedHeaderIsRejected();
+    testTruncatedStream();
+    testBadHuffmanTables();
+    return Check::result("png_stream");
+}
@@ -0,0 +1,136 @@
+#include <tests/check.hpp>
+#include <utils/spsc_ring.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// One producer and one consumer thread hammering SpscRing. Items must come
+// out complete and in order, for tiny rings that are full or empty almost all
+// the time as well as roomy ones, and nothing moved through may leak.
+namespace {
+    // Counts live instances, so a payload left behind in a slot shows up
+    struct Payload {
+        static inline std::atomic<int> s_live{ 0 };
+
+        explicit Payload(uint64_t id) : id(id), check(~id) { s_live.fetch_add(1, std::memory_order_relaxed); }
+        ~Payload() { s_live.fetch_sub(1, std::memory_order_relaxed); }
+
+        uint64_t id;
+        uint64_t check;
+    };
+
+    // What game.cpp sends through its ring: an owned buffer plus a tag
+    struct Message {
+        std::unique_ptr<Payload> payload;
+        std::vector<uint8_t> bytes;
+    };
+
+    // Spins until each push and pop succeeds, yielding so a single core
+    // still lets the other side run
+    template <std::size_t Capacity>
+    void stressIntegers(uint64_t count) {
+        SpscRing<uint64_t, Capacity> ring;
+        std::thread producer([&] {
+            for (uint64_t i = 0; i < count; ++i) {
+                uint64_t value = i;
+                while (!ring.tryPush(std::move(value))) std::this_thread::yield();
+            }
+        });
+
+        uint64_t expected = 0;
+        uint64_t outOfOrder = 0;
+        while (expected < count) {
+            uint64_t value = 0;
+            if (!ring.tryPop(value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (value != expected) ++outOfOrder;
+            expected = value + 1;
+        }
+        producer.join();
+
+        CHECK(outOfOrder == 0);
+        CHECK(ring.size() == 0);
+        uint64_t value = 0;
+        CHECK(!ring.tryPop(value));
+    }
+
+    template <std::size_t Capacity>
+    void stressMessages(uint64_t count) {
+        {
+            SpscRing<Message, Capacity> ring;
+            std::thread producer([&] {
+                for (uint64_t i = 0; i < count; ++i) {
+                    Message message;
+                    message.payload = std::make_unique<Payload>(i);
+                    message.bytes.assign(static_cast<std::size_t>(i % 61), static_cast<uint8_t>(i));
+                    while (!ring.tryPush(std::move(message))) std::this_thread::yield();
+                }
+            });
+
+            uint64_t received = 0;
+            uint64_t corrupt = 0;
+            while (received < count) {
+                Message message;
+                if (!ring.tryPop(message)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const bool intact = message.payload && message.payload->id == received &&
+                    message.payload->check == ~received && message.bytes.size() == received % 61 &&
+                    (message.bytes.empty() || message.bytes.back() == static_cast<uint8_t>(received));
+                if (!intact) ++corrupt;
+                ++received;
+            }
+            producer.join();
+            CHECK(corrupt == 0);
+
+            // Popped slots are cleared straight away, not when they are next overwritten
+            CHECK(Payload::s_live.load() == 0);
+        }
+        CHECK(Payload::s_live.load() == 0);
+    }
+
+    void testFullAndEmpty() {
+        SpscRing<Message, 4> ring;
+        Message out;
+        CHECK(!ring.tryPop(out));
+
+        for (uint64_t i = 0; i < 4; ++i) {
+            Message message;
+            message.payload = std::make_unique<Payload>(i);
+            CHECK(ring.tryPush(std::move(message)));
+        }
+        CHECK(ring.size() == 4);
+
+        // A rejected push leaves the item with the caller
+        Message extra;
+        extra.payload = std::make_unique<Payload>(99);
+        CHECK(!ring.tryPush(std::move(extra)));
+        CHECK(extra.payload && extra.payload->id == 99);
+
+        CHECK(ring.tryPop(out) && out.payload->id == 0);
+        CHECK(ring.tryPush(std::move(extra)));
+        CHECK(!extra.payload);
+        for (uint64_t id : { 1, 2, 3, 99 }) {
+            CHECK(ring.tryPop(out) && out.payload && out.payload->id == id);
+        }
+        CHECK(!ring.tryPop(out));
+        out = Message();
+        CHECK(Payload::s_live.load() == 0);
+    }
+}
+
+int main() {
+    testFullAndEmpty();
+    stressIntegers<2>(200000);
+    stressIntegers<16>(1000000);
+    stressIntegers<1024>(4000000);
+    stressMessages<2>(100000);
+    stressMessages<16>(300000);
+    stressMessages<256>(300000);
+    return Check::result("spsc_ring");
+}
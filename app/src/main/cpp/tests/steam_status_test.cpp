@@ -0,0 +1,167 @@
+#include <tests/check.hpp>
+#include <utils/steam_status.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr AppId_t s_appId = 480;
+
+    // What the fake Steam answers; shared with the test after the backend
+    // has been handed to SteamStatus
+    struct FakeSteam {
+        std::atomic<bool> canInit{ false };
+        std::atomic<bool> ownsGame{ false };
+        std::atomic<bool> isInstalled{ false };
+        std::atomic<int> inits{ 0 };
+        std::atomic<int> shutdowns{ 0 };
+
+        std::mutex mutex;
+        std::vector<Clock::time_point> polls;
+
+        std::size_t pollCount() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return polls.size();
+        }
+    };
+
+    class FakeBackend : public SteamBackend {
+    public:
+        explicit FakeBackend(std::shared_ptr<FakeSteam> steam) : m_steam(std::move(steam)) {}
+
+        bool init() override {
+            ++m_steam->inits;
+            const bool canInit = m_steam->canInit.load();
+            if (!canInit) notePoll();   // Otherwise isSubscribedApp() notes this poll
+            return canInit;
+        }
+
+        void shutdown() override { ++m_steam->shutdowns; }
+        void runCallbacks() override {}
+        bool isReady() override { return true; }
+
+        bool isSubscribedApp(AppId_t appId) override {
+            notePoll();     // Once Steam is up, every poll asks this, and init() is no longer called
+            return appId == s_appId && m_steam->ownsGame.load();
+        }
+
+        bool isAppInstalled(AppId_t appId) override {
+            return appId == s_appId && m_steam->isInstalled.load();
+        }
+
+    private:
+        void notePoll() {
+            std::lock_guard<std::mutex> lock(m_steam->mutex);
+            m_steam->polls.push_back(Clock::now());
+        }
+
+        std::shared_ptr<FakeSteam> m_steam;
+    };
+
+    // Scheduling slack allowed on top of each wait
+    constexpr double s_slackMs = 150.0;
+
+    double gapMs(const std::vector<Clock::time_point>& polls, std::size_t index) {
+        return std::chrono::duration<double, std::milli>(polls[index] - polls[index - 1]).count();
+    }
+
+    void testGenerationBumpsOnEveryPoll() {
+        auto steam = std::make_shared<FakeSteam>();
+        SteamStatus status(s_appId, std::make_unique<FakeBackend>(steam));
+
+        CHECK(status.snapshot().generation == 0);
+        status.start();
+        CHECK(Check::eventually([&]() { return status.snapshot().generation >= 1; }));
+
+        // Nothing changed, but the poll still completed
+        const SteamStatus::Snapshot first = status.snapshot();
+        CHECK(!first.steamRunning);
+        CHECK(!first.ownsGame);
+
+        status.requestRefresh();
+        CHECK(Check::eventually([&]() { return status.snapshot().generation > first.generation; },
+            std::chrono::milliseconds(200)));
+        status.stop();
+
+        // Steam never came up, so there is nothing to shut down
+        CHECK(steam->shutdowns == 0);
+    }
+
+    void testBackoffDoublesWhileIdleAndResetsOnChange() {
+        auto steam = std::make_shared<FakeSteam>();
+        SteamStatus status(s_appId, std::make_unique<FakeBackend>(steam));
+        status.start();
+
+        // Polls at 0, 250 and 750 ms: the first wait is the minimum, and it
+        // doubles while nothing changes
+        CHECK(Check::eventually([&]() { return steam->pollCount() >= 3; }));
+        std::vector<Clock::time_point> polls;
+        {
+            std::lock_guard<std::mutex> lock(steam->mutex);
+            polls = steam->polls;
+        }
+        CHECK(gapMs(polls, 1) >= 240.0 && gapMs(polls, 1) < 250.0 + s_slackMs);
+        CHECK(gapMs(polls, 2) >= 480.0 && gapMs(polls, 2) < 500.0 + s_slackMs);
+
+        // The fourth poll (one second later, at 1750 ms) sees Steam; the wait
+        // then snaps back to the minimum instead of doubling again
+        steam->canInit = true;
+        steam->ownsGame = true;
+        CHECK(Check::eventually([&]() { return steam->pollCount() >= 5; }));
+        {
+            std::lock_guard<std::mutex> lock(steam->mutex);
+            polls = steam->polls;
+        }
+        CHECK(gapMs(polls, 3) >= 960.0 && gapMs(polls, 3) < 1000.0 + s_slackMs);
+        CHECK(gapMs(polls, 4) >= 240.0 && gapMs(polls, 4) < 250.0 + s_slackMs);
+        status.stop();
+    }
+
+    void testReconnectsWhenSteamStarts() {
+        auto steam = std::make_shared<FakeSteam>();
+        SteamStatus status(s_appId, std::make_unique<FakeBackend>(steam));
+        status.start();
+        CHECK(Check::eventually([&]() { return status.snapshot().generation >= 1; }));
+        CHECK(!status.snapshot().steamRunning);
+
+        // Steam starts later; a refresh picks it up without waiting out the backoff
+        steam->canInit = true;
+        steam->ownsGame = true;
+        steam->isInstalled = true;
+        const uint32_t before = status.snapshot().generation;
+        status.requestRefresh();
+        CHECK(Check::eventually([&]() { return status.snapshot().generation > before; },
+            std::chrono::milliseconds(200)));
+
+        const SteamStatus::Snapshot connected = status.snapshot();
+        CHECK(connected.steamRunning);
+        CHECK(connected.ownsGame);
+        CHECK(connected.isInstalled);
+
+        // Once connected, init is not retried on every poll
+        const int inits = steam->inits;
+        status.requestRefresh();
+        CHECK(Check::eventually([&]() { return status.snapshot().generation > connected.generation; },
+            std::chrono::milliseconds(200)));
+        CHECK(steam->inits == inits);
+
+        status.stop();
+        CHECK(steam->shutdowns == 1);
+
+        // Restarting reconnects from scratch
+        status.start();
+        CHECK(Check::eventually([&]() { return steam->inits > inits; }));
+        status.stop();
+        CHECK(steam->shutdowns == 2);
+    }
+}
+
+int main() {
+    testGenerationBumpsOnEveryPoll();
+    testBackoffDoublesWhileIdleAndResetsOnChange();
+    testReconnectsWhenSteamStarts();
+    return Check::result("steam_status");
+}
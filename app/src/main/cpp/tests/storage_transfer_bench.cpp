@@ -0,0 +1,101 @@
+#include <tests/bench.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/storage_backend.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Whole-file transfers through FileManager::readTextFile / writeTextFile and
+// the StorageBackend underneath, for config-sized and larger files, on the
+// in-memory backend (split/join and copying only) and on the desktop backend
+// (plus the filesystem).
+namespace {
+    struct Size {
+        const char* name;
+        int lines;
+        int repeats;
+    };
+
+    constexpr Size s_sizes[] = {
+        { "font.cfg-sized (60 lines)", 60, 2000 },
+        { "localization.cfg-sized (3k lines)", 3000, 200 },
+        { "large (100k lines)", 100000, 10 },
+    };
+
+    // Looks like the game's configs: KEY="value" lines with a comment now and then
+    std::vector<std::string> makeConfig(int lineCount) {
+        std::vector<std::string> lines;
+        lines.reserve(static_cast<std::size_t>(lineCount));
+        for (int i = 0; i < lineCount; ++i) {
+            if (i % 20 == 0) {
+                lines.push_back("# Section " + std::to_string(i / 20));
+            } else {
+                lines.push_back("KEY_" + std::to_string(i) + "=\"Some translated text for entry " +
+                    std::to_string(i) + "\"");
+            }
+        }
+        return lines;
+    }
+
+    uint64_t byteCount(const std::vector<std::string>& lines) {
+        uint64_t bytes = 0;
+        for (const auto& line : lines) bytes += line.size() + 1;
+        return bytes;
+    }
+
+    void runTransfers(const char* backendName, const std::string& directory) {
+        std::printf("\n%s backend\n", backendName);
+        for (const Size& size : s_sizes) {
+            const std::vector<std::string> config = makeConfig(size.lines);
+            const uint64_t bytes = byteCount(config);
+            const std::string path = FileManager::joinPath(directory, "bench.cfg");
+            char name[96];
+
+            std::snprintf(name, sizeof(name), "write %s", size.name);
+            Bench::run(name, size.repeats, bytes, [&]() {
+                Bench::keep(FileManager::writeTextFile(path, config));
+            });
+
+            std::snprintf(name, sizeof(name), "read %s", size.name);
+            Bench::run(name, size.repeats, bytes, [&]() {
+                Bench::keep(FileManager::readTextFile(path).size());
+            });
+
+            // What the Save button does per file: read, change one key, write back
+            std::snprintf(name, sizeof(name), "update %s", size.name);
+            Bench::run(name, size.repeats, bytes * 2, [&]() {
+                std::vector<std::string> lines = FileManager::readTextFile(path);
+                FileManager::updateOrAddLine(lines, "KEY_1", "Changed", true);
+                Bench::keep(FileManager::writeTextFile(path, lines));
+            });
+        }
+    }
+}
+
+int main() {
+    std::printf("Storage transfers (best of N runs; compare before and after a change)\n");
+
+    std::printf("\nsplit / join only\n");
+    for (const Size& size : s_sizes) {
+        const std::string bytes = FileManager::joinLines(makeConfig(size.lines));
+        char name[96];
+        std::snprintf(name, sizeof(name), "split %s", size.name);
+        Bench::run(name, size.repeats, bytes.size(), [&]() {
+            Bench::keep(FileManager::splitLines(bytes, true).size());
+        });
+    }
+
+    FileManager::setStorageBackend(std::make_unique<MemoryStorageBackend>());
+    runTransfers("In-memory", "/game");
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sense_storage_bench";
+    std::filesystem::create_directories(directory);
+    FileManager::setStorageBackend(std::make_unique<DesktopStorageBackend>());
+    runTransfers("Desktop (filesystem)", directory.string());
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include <tests/alloc_counter.hpp>
+#include <tests/check.hpp>
+#include <application/game.hpp>
+#include <objects/font_preview.hpp>
+#include <utils/decor_collection.hpp>
+#include <utils/font_loader.hpp>
+#include <utils/task_scheduler.hpp>
+#include <utils/text_fit_analyzer.hpp>
+#include <assets/assets.hpp>
+#include <assets/data.hpp>
+#include <backends/imgui_impl_sdl2.h>
+#include <backends/imgui_impl_sdlrenderer2.h>
+#include <imgui_internal.h>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+// The Localization, Font and Decor tabs as Game::play() draws them, on a
+// hidden dummy-driver window: the frame upkeep, then the tab inside a window.
+// Once a tab has settled a frame must not touch the heap, with key cells
+// open, decor marked for removal and the font loader in every state.
+namespace {
+    constexpr int s_width = 1280;
+    constexpr int s_height = 720;
+
+    // Frames measured per state, after the ones ImGui needs to lay things out
+    constexpr int s_frames = 200;
+    constexpr int s_settleFrames = 5;
+
+    const std::filesystem::path s_gamePath = "tab_allocations_test_game";
+    constexpr int s_decorCount = 3;
+
+    // Longer than any small-string buffer, so a std::string copy would allocate
+    const std::filesystem::path s_fontPath =
+        "/no/such/folder/for/the/tab/allocation/test/Some Font Family - Regular Weight.ttf";
+
+    SDL_Renderer* s_renderer = nullptr;
+
+    // One pass of the game loop with `drawTab` as the window's content; the
+    // content height, to tell what the tab drew
+    template<typename Draw>
+    float drawFrame(Draw&& drawTab) {
+        Game::BeginEditorFrame(s_renderer);
+        ImGui_ImplSDLRenderer2_NewFrame();
+        ImGui_ImplSDL2_NewFrame();
+        ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+
+        float height = 0.0f;
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(static_cast<float>(s_width), static_cast<float>(s_height)));
+        if (ImGui::Begin("##tabs", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings)) {
+            drawTab();
+            height = ImGui::GetCursorPosY();
+        }
+        ImGui::End();
+
+        ImGui::Render();
+        ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), s_renderer);
+        return height;
+    }
+
+    // Allocations over s_frames frames, once the tab has settled
+    template<typename Draw>
+    uint64_t allocationsPerRun(Draw&& drawTab) {
+        for (int i = 0; i < s_settleFrames; ++i) {
+            drawFrame(drawTab);
+        }
+        const uint64_t before = AllocCounter::allocations();
+        for (int i = 0; i < s_frames; ++i) {
+            drawFrame(drawTab);
+        }
+        return AllocCounter::allocations() - before;
+    }
+
+    // Presses the item `label` in the ID scope `scope` of the tab on the
+    // next frame, as a click would
+    template<typename Draw, typename Scope>
+    void activate(Draw&& drawTab, Scope scope, const char* label) {
+        drawFrame([&] {
+            drawTab();
+            ImGui::PushID(scope);
+            ImGui::ActivateItemByID(ImGui::GetID(label));
+            ImGui::PopID();
+        });
+    }
+
+    void testLocalizationTab(TextFitAnalyzer& textFit) {
+        const auto drawTab = [&] { Game::DrawLocalizationTab(textFit, 300.0f); };
+
+        Game::RefreshLocalization(textFit);
+        CHECK(Check::eventually([&] {
+            drawFrame(drawTab);
+            return !textFit.isBusy();
+        }, std::chrono::milliseconds(60000)));
+        const float closedHeight = drawFrame(drawTab);
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        // Open the first two keys' text
+        for (int key = 0; key < 2; ++key) {
+            activate(drawTab, key, LocalizationKeyNames[key].data());
+            drawFrame(drawTab);
+        }
+        CHECK(drawFrame(drawTab) > closedHeight);
+        CHECK(allocationsPerRun(drawTab) == 0);
+    }
+
+    void testFontTab() {
+        // Its own scheduler, so the load stays in Loading until pumped here
+        TaskScheduler scheduler(1);
+        FontLoader loader(scheduler);
+        FontPreview preview(s_renderer);
+        size_t previewKey = static_cast<size_t>(LocalizationKey::A_START);
+        const auto drawTab = [&] { Game::DrawFontTab(loader, preview, previewKey); };
+
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        loader.load(s_fontPath);
+        CHECK(loader.state() == FontLoader::State::Loading);
+        CHECK(allocationsPerRun(drawTab) == 0);
+        CHECK(loader.state() == FontLoader::State::Loading);
+
+        // The file does not exist, so the load finishes as Failed
+        CHECK(Check::eventually([&] {
+            scheduler.runMainThread(std::chrono::microseconds(1000));
+            loader.pump();
+            drawFrame(drawTab);
+            return loader.state() == FontLoader::State::Failed;
+        }));
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        loader.reset();
+        CHECK(allocationsPerRun(drawTab) == 0);
+    }
+
+    bool writeDecor() {
+        std::error_code error;
+        std::filesystem::create_directories(s_gamePath / "decor", error);
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) return false;
+
+        bool ok = true;
+        for (int i = 0; i < s_decorCount && ok; ++i) {
+            // Different pixels, so no two are duplicates
+            SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 40 * i, 80, 160, 255));
+            const std::string path = (s_gamePath / "decor" / ("decor_" + std::to_string(i) + ".png")).string();
+            ok = IMG_SavePNG(surface, path.c_str()) == 0;
+        }
+        SDL_FreeSurface(surface);
+        return ok;
+    }
+
+    void testDecorTab() {
+        CHECK(writeDecor());
+        StandartDecorList = { { "decor_standard_a", true }, { "decor_standard_b", false } };
+        const auto drawTab = [&] { Game::DrawDecorTab(s_renderer, s_gamePath); };
+
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        // The custom decor tab scans the folder the first time it is drawn
+        activate(drawTab, "Decor", "Add Custom Decor");
+        CHECK(Check::eventually([&] {
+            drawFrame(drawTab);
+            return CustomDecorList.size() == static_cast<size_t>(s_decorCount);
+        }));
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        // Restore instead of Remove on the first
+        CustomDecorList[0].addOperation(CustomeDecorationOperationEnum::Remove);
+        CHECK(allocationsPerRun(drawTab) == 0);
+
+        // Drop the textures while the renderer is still there
+        CustomDecorList.clear();
+    }
+}
+
+int main() {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0 || TTF_Init() != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("tab_allocations", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+        s_width, s_height, SDL_WINDOW_HIDDEN);
+    s_renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_TARGETTEXTURE) : nullptr;
+    CHECK(s_renderer != nullptr);
+
+    if (s_renderer) {
+        ImGui::CreateContext();
+        ImGui::GetIO().IniFilename = nullptr;
+        ImGui_ImplSDL2_InitForSDLRenderer(window, s_renderer);
+        ImGui_ImplSDLRenderer2_Init(s_renderer);
+
+        {
+            TextFitAnalyzer textFit;
+            textFit.setFontSizes(FontList.fontSize, FontList.otherTextFontSize);
+            textFit.setFont(Incbin_Data(FONT_FONT_TTF), Incbin_Size(FONT_FONT_TTF));
+            testLocalizationTab(textFit);
+        }
+        testFontTab();
+        testDecorTab();
+
+        ImGui_ImplSDLRenderer2_Shutdown();
+        ImGui_ImplSDL2_Shutdown();
+        ImGui::DestroyContext();
+        SDL_DestroyRenderer(s_renderer);
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(s_gamePath, error);
+    if (window) SDL_DestroyWindow(window);
+    TTF_Quit();
+    SDL_Quit();
+    return Check::result("tab_allocations");
+}
@@ -0,0 +1,130 @@
+#include <tests/bench.hpp>
+#include <utils/task_scheduler.hpp>
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// TaskScheduler overhead, with tasks that do (almost) nothing so only the
+// scheduler is timed. Throughput: many tasks from the render thread, and
+// tasks that fan out from a worker, where stealing spreads the load.
+// Latency: an idle pool woken for one task, and a continuation's round
+// trip back through runMainThread().
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int s_taskCount = 100000;
+
+    double microsecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    void benchThroughput(TaskScheduler& scheduler) {
+        std::printf("\nThroughput, %d tasks per run\n", s_taskCount);
+        std::vector<TaskScheduler::Handle> handles;
+        handles.reserve(s_taskCount);
+
+        const Bench::Result submitted = Bench::run("submit from the render thread", 10, [&]() {
+            std::atomic<uint64_t> sum{ 0 };
+            handles.clear();
+            for (int i = 0; i < s_taskCount; ++i) {
+                handles.push_back(scheduler.submit([&sum, i](const TaskScheduler::Handle&) {
+                    sum.fetch_add(static_cast<uint64_t>(i), std::memory_order_relaxed);
+                }));
+            }
+            for (const TaskScheduler::Handle& handle : handles) handle.wait();
+            Bench::keep(sum.load());
+        });
+        std::printf("  = %.2f M tasks/s\n", s_taskCount / (submitted.bestMs * 1000.0));
+
+        // One task per worker spawns the rest onto its own deque; idle workers steal
+        const unsigned workers = scheduler.workerCount();
+        const Bench::Result spawned = Bench::run("spawned by workers", 10, [&]() {
+            std::atomic<uint64_t> sum{ 0 };
+            std::atomic<int> remaining{ s_taskCount };
+            for (unsigned w = 0; w < workers; ++w) {
+                const int count = s_taskCount / static_cast<int>(workers) +
+                    (w < s_taskCount % workers ? 1 : 0);
+                scheduler.submit([&scheduler, &sum, &remaining, count](const TaskScheduler::Handle&) {
+                    for (int i = 0; i < count; ++i) {
+                        scheduler.submit([&sum, &remaining, i](const TaskScheduler::Handle&) {
+                            sum.fetch_add(static_cast<uint64_t>(i), std::memory_order_relaxed);
+                            remaining.fetch_sub(1, std::memory_order_release);
+                        });
+                    }
+                });
+            }
+            while (remaining.load(std::memory_order_acquire) > 0) std::this_thread::yield();
+            Bench::keep(sum.load());
+        });
+        std::printf("  = %.2f M tasks/s (stolen so far: %llu)\n", s_taskCount / (spawned.bestMs * 1000.0),
+            static_cast<unsigned long long>(scheduler.stats().stolen));
+    }
+
+    void benchLatency(TaskScheduler& scheduler) {
+        constexpr int s_samples = 5000;
+        std::printf("\nLatency, %d samples\n", s_samples);
+
+        // Workers are asleep between samples, so this includes the wake-up
+        std::vector<double> start;
+        std::vector<double> roundTrip;
+        start.reserve(s_samples);
+        roundTrip.reserve(s_samples);
+        for (int i = 0; i < s_samples; ++i) {
+            std::atomic<double> started{ 0.0 };
+            bool continued = false;
+            const Clock::time_point submitted = Clock::now();
+            const TaskScheduler::Handle handle = scheduler.submit(
+                [&](const TaskScheduler::Handle&) { started = microsecondsSince(submitted); },
+                TaskScheduler::Priority::High,
+                [&] { continued = true; });
+            handle.wait();
+            // Polled the way the render loop does, only without the frame in between
+            while (!continued) {
+                scheduler.runMainThread(std::chrono::microseconds(1000));
+            }
+            start.push_back(started.load());
+            roundTrip.push_back(microsecondsSince(submitted));
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        Bench::printPercentiles("submit -> task starts (idle pool)", start);
+        Bench::printPercentiles("submit -> continuation ran", roundTrip);
+
+        // The same on a busy pool: High jumps the queued Normal tasks
+        std::atomic<bool> stop{ false };
+        std::vector<TaskScheduler::Handle> background;
+        for (unsigned w = 0; w < scheduler.workerCount() * 4; ++w) {
+            background.push_back(scheduler.submit([&stop](const TaskScheduler::Handle&) {
+                const Clock::time_point begin = Clock::now();
+                while (!stop.load(std::memory_order_relaxed) && Clock::now() - begin < std::chrono::milliseconds(1)) {}
+            }, TaskScheduler::Priority::Low));
+        }
+        start.clear();
+        for (int i = 0; i < s_samples / 5; ++i) {
+            std::atomic<double> started{ 0.0 };
+            const Clock::time_point submitted = Clock::now();
+            scheduler.submit([&](const TaskScheduler::Handle&) { started = microsecondsSince(submitted); },
+                TaskScheduler::Priority::High).wait();
+            start.push_back(started.load());
+            // Keep the pool busy
+            background.push_back(scheduler.submit([&stop](const TaskScheduler::Handle&) {
+                const Clock::time_point begin = Clock::now();
+                while (!stop.load(std::memory_order_relaxed) && Clock::now() - begin < std::chrono::milliseconds(1)) {}
+            }, TaskScheduler::Priority::Low));
+        }
+        stop = true;
+        for (const TaskScheduler::Handle& handle : background) handle.wait();
+        Bench::printPercentiles("submit -> High task starts (busy pool)", start);
+    }
+}
+
+int main() {
+    TaskScheduler scheduler;
+    std::printf("Task scheduler on %u workers (best of N runs; compare before and after a change)\n",
+        scheduler.workerCount());
+    benchThroughput(scheduler);
+    benchLatency(scheduler);
+    return 0;
+}
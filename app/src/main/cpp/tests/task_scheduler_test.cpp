@@ -0,0 +1,72 @@
+#include <tests/check.hpp>
+#include <utils/task_scheduler.hpp>
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    bool runUntil(TaskScheduler& scheduler, const bool& flag) {
+        return Check::eventually([&] {
+            scheduler.runMainThread(std::chrono::microseconds(1000));
+            return flag;
+        });
+    }
+
+    // A throwing task is logged and counted as run; its worker and its
+    // continuation carry on
+    void testThrowingTasks() {
+        TaskScheduler scheduler(2);
+        bool stdContinued = false;
+        bool otherContinued = false;
+
+        const TaskScheduler::Handle stdThrow = scheduler.submit(
+            [](const TaskScheduler::Handle&) { throw std::runtime_error("expected by the test"); },
+            TaskScheduler::Priority::Normal, [&] { stdContinued = true; });
+        const TaskScheduler::Handle otherThrow = scheduler.submit(
+            [](const TaskScheduler::Handle&) { throw 42; },
+            TaskScheduler::Priority::Normal, [&] { otherContinued = true; });
+
+        stdThrow.wait();
+        otherThrow.wait();
+        CHECK(stdThrow.isDone() && otherThrow.isDone());
+        CHECK(runUntil(scheduler, stdContinued));
+        CHECK(runUntil(scheduler, otherContinued));
+
+        std::atomic<int> ran{ 0 };
+        for (int i = 0; i < 100; ++i) {
+            scheduler.submit([&ran](const TaskScheduler::Handle&) { ran.fetch_add(1); });
+        }
+        CHECK(Check::eventually([&] { return ran.load() == 100; }));
+        CHECK(scheduler.stats().executed == 102);
+    }
+
+    void testCancelledContinuationIsSkipped() {
+        TaskScheduler scheduler(1);
+        std::atomic<bool> release{ false };
+        bool continued = false;
+
+        const TaskScheduler::Handle blocker = scheduler.submit([&release](const TaskScheduler::Handle&) {
+            while (!release.load()) std::this_thread::yield();
+        });
+        const TaskScheduler::Handle queued = scheduler.submit(
+            [](const TaskScheduler::Handle&) {}, TaskScheduler::Priority::Normal, [&] { continued = true; });
+        queued.cancel();
+        release = true;
+        blocker.wait();
+        queued.wait();
+
+        scheduler.runMainThread(std::chrono::microseconds(1000));
+        CHECK(queued.isCancelled());
+        CHECK(!continued);
+    }
+}
+
+int main() {
+    // The throwing tasks log an error each; that is the expected outcome
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_CRITICAL);
+    testThrowingTasks();
+    testCancelledContinuationIsSkipped();
+    return Check::result("task_scheduler");
+}
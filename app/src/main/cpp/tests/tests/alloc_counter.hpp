@@ -0,0 +1,67 @@
+#pragma once
+// Replaces global operator new/delete with counting versions. Include from
+// exactly one file of a test executable. Tests that use it are not built
+// with SENSE_MEMORY_TRACKING, which installs its own replacements.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace AllocCounter {
+    inline std::atomic<uint64_t> s_allocations{ 0 };
+    inline std::atomic<int64_t> s_liveBytes{ 0 };
+    inline std::atomic<int64_t> s_peakLiveBytes{ 0 };
+    inline int64_t s_peakBase = 0;
+
+    // Room in front of every block for its size, keeping the default alignment
+    inline constexpr std::size_t s_headerSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    [[nodiscard]] inline uint64_t allocations() { return s_allocations.load(); }
+    [[nodiscard]] inline int64_t liveBytes() { return s_liveBytes.load(); }
+
+    // Highest live heap since the last resetPeak(), above what was live then
+    inline void resetPeak() {
+        s_peakBase = s_liveBytes.load();
+        s_peakLiveBytes = s_peakBase;
+    }
+    [[nodiscard]] inline int64_t peakBytes() { return s_peakLiveBytes.load() - s_peakBase; }
+
+    inline void* allocate(std::size_t size) noexcept {
+        auto* block = static_cast<unsigned char*>(std::malloc(size + s_headerSize));
+        if (!block) return nullptr;
+        *reinterpret_cast<std::size_t*>(block) = size;
+
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        const int64_t live = s_liveBytes.fetch_add(static_cast<int64_t>(size)) + static_cast<int64_t>(size);
+        int64_t peak = s_peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !s_peakLiveBytes.compare_exchange_weak(peak, live)) {}
+        return block + s_headerSize;
+    }
+
+    inline void release(void* ptr) noexcept {
+        if (!ptr) return;
+        unsigned char* block = static_cast<unsigned char*>(ptr) - s_headerSize;
+        s_liveBytes.fetch_sub(static_cast<int64_t>(*reinterpret_cast<std::size_t*>(block)));
+        std::free(block);
+    }
+
+    inline void* allocateOrThrow(std::size_t size) {
+        void* ptr = allocate(size);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+// Over-aligned forms are left to the library; they pair with its own deletes
+void* operator new(std::size_t size) { return AllocCounter::allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return AllocCounter::allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return AllocCounter::allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return AllocCounter::allocate(size); }
+
+void operator delete(void* ptr) noexcept { AllocCounter::release(ptr); }
+void operator delete[](void* ptr) noexcept { AllocCounter::release(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { AllocCounter::release(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { AllocCounter::release(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { AllocCounter::release(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { AllocCounter::release(ptr); }
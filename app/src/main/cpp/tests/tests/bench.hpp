@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Benchmark timing: runs `work` `repeats` times and prints the best and the
+// median wall time, plus throughput when `bytes` (per run) is given. The best
+// run is the stable number to compare before and after a change.
+namespace Bench {
+
+struct Result {
+    double bestMs = 0.0;
+    double medianMs = 0.0;
+};
+
+template <typename Work>
+Result run(const char* name, int repeats, uint64_t bytes, Work work) {
+    std::vector<double> times;
+    times.reserve(static_cast<std::size_t>(repeats));
+    for (int i = 0; i < repeats; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+        work();
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+    }
+    std::sort(times.begin(), times.end());
+
+    Result result;
+    result.bestMs = times.front();
+    result.medianMs = times[times.size() / 2];
+    if (bytes > 0 && result.bestMs > 0.0) {
+        std::printf("%-44s best %9.3f ms  median %9.3f ms  %8.1f MB/s\n", name, result.bestMs, result.medianMs,
+            bytes / (result.bestMs / 1000.0) / (1024.0 * 1024.0));
+    } else {
+        std::printf("%-44s best %9.3f ms  median %9.3f ms\n", name, result.bestMs, result.medianMs);
+    }
+    return result;
+}
+
+template <typename Work>
+Result run(const char* name, int repeats, Work work) {
+    return run(name, repeats, 0, work);
+}
+
+// Latency distribution of `samples` (microseconds, reordered in place)
+inline void printPercentiles(const char* name, std::vector<double>& samples) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+    std::printf("%-44s p50 %8.1f us  p90 %8.1f us  p99 %8.1f us  max %8.1f us\n",
+        name, at(0.5), at(0.9), at(0.99), samples.back());
+}
+
+// Feed a checksum of each run's output through here, so the optimizer
+// cannot drop work whose result is otherwise unused
+inline volatile uint64_t s_sink = 0;
+
+inline void keep(uint64_t value) {
+    s_sink = s_sink + value;
+}
+
+} // namespace Bench
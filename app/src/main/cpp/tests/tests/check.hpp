@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Minimal assertions for the host tests. A failed CHECK is reported and
+// counted but does not stop the test, so one run shows every failure.
+namespace Check {
+
+inline int s_failures = 0;
+
+inline bool report(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        ++s_failures;
+        std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+    }
+    return passed;
+}
+
+// Polls `condition` until it holds or `timeout` runs out; for threaded code
+template <typename Condition>
+bool eventually(Condition condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Exit code for main()
+inline int result(const char* name) {
+    if (s_failures > 0) {
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, s_failures);
+        return 1;
+    }
+    std::printf("%s: all checks passed\n", name);
+    return 0;
+}
+
+} // namespace Check
+
+#define CHECK(...) ::Check::report(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
@@ -0,0 +1,106 @@
+#include <tests/check.hpp>
+#include <utils/texture.hpp>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Every convertRow() kernel the CPU has must match the scalar reference byte
+// for byte: all colour/alpha pairs for the premultiply rounding, and row
+// lengths and offsets that hit the vector body, the tails and unaligned data.
+namespace {
+    using TextureUpload::Kernel;
+
+    constexpr Kernel s_kernels[] = { Kernel::Scalar, Kernel::Sse2, Kernel::Avx2, Kernel::Neon };
+
+    // round(c * a / 255), computed the slow way
+    uint8_t premultiplied(unsigned c, unsigned a) {
+        return static_cast<uint8_t>((c * a * 2 + 255) / 510);
+    }
+
+    std::vector<uint8_t> reference(const std::vector<uint8_t>& src, bool swapRedBlue, bool premultiply) {
+        std::vector<uint8_t> out(src.size());
+        for (std::size_t i = 0; i < src.size(); i += 4) {
+            const uint8_t a = src[i + 3];
+            uint8_t rgb[3] = { src[i], src[i + 1], src[i + 2] };
+            if (premultiply) {
+                for (uint8_t& c : rgb) c = premultiplied(c, a);
+            }
+            if (swapRedBlue) std::swap(rgb[0], rgb[2]);
+            std::memcpy(&out[i], rgb, 3);
+            out[i + 3] = a;
+        }
+        return out;
+    }
+
+    // Every (colour, alpha) pair once per channel, with the channels disagreeing
+    std::vector<uint8_t> allPairs() {
+        std::vector<uint8_t> pixels;
+        pixels.reserve(256 * 256 * 4);
+        for (unsigned a = 0; a < 256; ++a) {
+            for (unsigned c = 0; c < 256; ++c) {
+                pixels.push_back(static_cast<uint8_t>(c));
+                pixels.push_back(static_cast<uint8_t>(255 - c));
+                pixels.push_back(static_cast<uint8_t>(c ^ 0x5A));
+                pixels.push_back(static_cast<uint8_t>(a));
+            }
+        }
+        return pixels;
+    }
+
+    bool matches(const std::vector<uint8_t>& src, bool swapRedBlue, bool premultiply) {
+        const std::vector<uint8_t> expected = reference(src, swapRedBlue, premultiply);
+
+        std::vector<uint8_t> out(src.size(), 0xCD);
+        TextureUpload::convertRow(src.data(), out.data(), src.size() / 4, swapRedBlue, premultiply);
+        if (out != expected) return false;
+
+        // In place, as fromImage converts the locked texture
+        std::vector<uint8_t> inPlace = src;
+        TextureUpload::convertRow(inPlace.data(), inPlace.data(), inPlace.size() / 4, swapRedBlue, premultiply);
+        return inPlace == expected;
+    }
+
+    void testKernel() {
+        const std::vector<uint8_t> pairs = allPairs();
+        for (int mode = 0; mode < 4; ++mode) {
+            const bool swapRedBlue = mode & 1;
+            const bool premultiply = mode & 2;
+            CHECK(matches(pairs, swapRedBlue, premultiply));
+
+            // Lengths around every vector width, from unaligned addresses, and
+            // nothing written past the end
+            for (std::size_t offset = 0; offset < 4; ++offset) {
+                for (std::size_t count = 0; count <= 40; ++count) {
+                    std::vector<uint8_t> buffer(offset + count * 4 + 16, 0xEE);
+                    const std::size_t first = (offset * 41 + count) * 1531 % (256 * 256 - 40);
+                    std::memcpy(buffer.data() + offset, pairs.data() + first * 4, count * 4);
+                    const std::vector<uint8_t> src(buffer.begin() + offset, buffer.begin() + offset + count * 4);
+
+                    std::vector<uint8_t> out(buffer.size(), 0xCD);
+                    TextureUpload::convertRow(buffer.data() + offset, out.data() + offset, count, swapRedBlue, premultiply);
+                    const std::vector<uint8_t> converted(out.begin() + offset, out.begin() + offset + count * 4);
+                    CHECK(converted == reference(src, swapRedBlue, premultiply));
+                    CHECK(out[offset + count * 4] == 0xCD);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    const Kernel best = TextureUpload::kernel();
+    CHECK(TextureUpload::isKernelSupported(best));
+    CHECK(!TextureUpload::setKernel(static_cast<Kernel>(-1)));
+
+    for (Kernel kernel : s_kernels) {
+        if (!TextureUpload::setKernel(kernel)) {
+            std::printf("%s: not available here, skipped\n", TextureUpload::kernelName(kernel));
+            continue;
+        }
+        std::printf("%s\n", TextureUpload::kernelName(kernel));
+        testKernel();
+    }
+    TextureUpload::setKernel(best);
+    return Check::result("texture_convert");
+}
@@ -0,0 +1,117 @@
+#include <tests/bench.hpp>
+#include <utils/texture.hpp>
+#include <SDL.h>
+#include <cstdio>
+#include <vector>
+
+// Texture uploads: the convertRow() kernels on their own (every instruction
+// set this CPU has, forced in turn), then TextureUpload::fromSurface against
+// SDL_CreateTextureFromSurface on a real renderer. A hidden window's default
+// renderer is used when there is a display, the software renderer otherwise,
+// so compare numbers from the same machine and renderer only.
+namespace {
+    using TextureUpload::Kernel;
+
+    constexpr Kernel s_kernels[] = { Kernel::Scalar, Kernel::Sse2, Kernel::Avx2, Kernel::Neon };
+
+    // Gradients with varied alpha, so premultiplying does real work
+    SDL_Surface* makeSurface(int width, int height) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) return nullptr;
+        for (int y = 0; y < height; ++y) {
+            uint8_t* row = static_cast<uint8_t*>(surface->pixels) + static_cast<std::size_t>(y) * surface->pitch;
+            for (int x = 0; x < width; ++x, row += 4) {
+                row[0] = static_cast<uint8_t>(x);
+                row[1] = static_cast<uint8_t>(y);
+                row[2] = static_cast<uint8_t>(x ^ y);
+                row[3] = static_cast<uint8_t>((x + y) * 7);
+            }
+        }
+        return surface;
+    }
+
+    void benchKernels() {
+        constexpr std::size_t s_pixels = 2048 * 2048;
+        std::vector<uint8_t> src(s_pixels * 4);
+        for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<uint8_t>(i * 131);
+        std::vector<uint8_t> dst(src.size());
+
+        std::printf("\nconvertRow, 2048x2048 (best kernel here: %s)\n",
+            TextureUpload::kernelName(TextureUpload::kernel()));
+        const Kernel best = TextureUpload::kernel();
+        for (Kernel kernel : s_kernels) {
+            if (!TextureUpload::setKernel(kernel)) continue;
+            for (int mode = 1; mode < 4; ++mode) {
+                const bool swapRedBlue = mode & 1;
+                const bool premultiply = mode & 2;
+                char name[96];
+                std::snprintf(name, sizeof(name), "%s%s%s", TextureUpload::kernelName(kernel),
+                    swapRedBlue ? ", swap red/blue" : "", premultiply ? ", premultiply" : "");
+                Bench::run(name, 20, src.size(), [&]() {
+                    TextureUpload::convertRow(src.data(), dst.data(), s_pixels, swapRedBlue, premultiply);
+                    Bench::keep(dst[dst.size() / 2]);
+                });
+            }
+        }
+        TextureUpload::setKernel(best);
+    }
+
+    void benchUploads(SDL_Renderer* renderer) {
+        for (int side : { 256, 1024, 4096 }) {
+            SDL_Surface* surface = makeSurface(side, side);
+            if (!surface) continue;
+            const uint64_t bytes = static_cast<uint64_t>(side) * side * 4;
+            const int repeats = side >= 4096 ? 5 : 30;
+            char name[96];
+
+            std::printf("\n%dx%d RGBA32\n", side, side);
+            std::snprintf(name, sizeof(name), "SDL_CreateTextureFromSurface");
+            Bench::run(name, repeats, bytes, [&]() {
+                SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+                Bench::keep(texture != nullptr);
+                SDL_DestroyTexture(texture);
+            });
+            for (bool premultiply : { false, true }) {
+                std::snprintf(name, sizeof(name), "TextureUpload::fromSurface%s", premultiply ? ", premultiplied" : "");
+                Bench::run(name, repeats, bytes, [&]() {
+                    SDL_Texture* texture = TextureUpload::fromSurface(renderer, surface, premultiply);
+                    Bench::keep(texture != nullptr);
+                    SDL_DestroyTexture(texture);
+                });
+            }
+            SDL_FreeSurface(surface);
+        }
+    }
+}
+
+int main() {
+    std::printf("Texture upload (best of N runs; compare before and after a change)\n");
+    benchKernels();
+
+    // The software renderer needs no display; it draws into this surface
+    SDL_Surface* canvas = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Window* window = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    if (SDL_Init(SDL_INIT_VIDEO) == 0) {
+        window = SDL_CreateWindow("texture_upload", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 64, 64,
+            SDL_WINDOW_HIDDEN);
+        if (window) renderer = SDL_CreateRenderer(window, -1, 0);
+    }
+    if (!renderer && canvas) {
+        renderer = SDL_CreateSoftwareRenderer(canvas);
+    }
+    if (!renderer) {
+        std::printf("\nNo renderer (%s); uploads skipped\n", SDL_GetError());
+    } else {
+        SDL_RendererInfo info;
+        SDL_GetRendererInfo(renderer, &info);
+        std::printf("\nRenderer: %s\n", info.name);
+        benchUploads(renderer);
+        SDL_DestroyRenderer(renderer);
+    }
+
+    if (window) SDL_DestroyWindow(window);
+    if (canvas) SDL_FreeSurface(canvas);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <utils/content_hash.hpp>
+#include <cstring>
+
+namespace {
+    constexpr uint64_t s_prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t s_prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t s_prime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t s_prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t s_prime5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // Unaligned little-endian loads; memcpy compiles to a plain mov
+    inline uint64_t read64(const unsigned char* p) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint32_t read32(const unsigned char* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * s_prime2;
+        acc = rotl(acc, 31);
+        return acc * s_prime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t lane) {
+        acc ^= round(0, lane);
+        return acc * s_prime1 + s_prime4;
+    }
+}
+
+namespace ContentHash {
+
+uint64_t hash(const void* data, std::size_t size, uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t lanes[4] = {
+            seed + s_prime1 + s_prime2,
+            seed + s_prime2,
+            seed,
+            seed - s_prime1
+        };
+
+        const unsigned char* const limit = end - 32;
+        do {
+            for (int i = 0; i < 4; ++i) {
+                lanes[i] = round(lanes[i], read64(p + i * 8));
+            }
+            p += 32;
+        } while (p <= limit);
+
+        h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            h = mergeRound(h, lane);
+        }
+    } else {
+        h = seed + s_prime5;
+    }
+
+    h += static_cast<uint64_t>(size);
+
+    while (p + 8 <= end) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * s_prime1 + s_prime4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read32(p)) * s_prime1;
+        h = rotl(h, 23) * s_prime2 + s_prime3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= static_cast<uint64_t>(*p) * s_prime5;
+        h = rotl(h, 11) * s_prime1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= s_prime2;
+    h ^= h >> 29;
+    h *= s_prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string toHex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        text[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return text;
+}
+
+bool fromHex(const std::string& text, uint64_t& value) {
+    if (text.empty() || text.size() > 16) {
+        return false;
+    }
+
+    uint64_t result = 0;
+    for (char c : text) {
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        result = (result << 4) | static_cast<uint64_t>(digit);
+    }
+    value = result;
+    return true;
+}
+
+} // namespace ContentHash
@@ -0,0 +1,241 @@
+#include <utils/decor_collection.hpp>
+
+namespace {
+    constexpr uint8_t bit(CustomeDecorationOperationEnum op) {
+        return static_cast<uint8_t>(op);
+    }
+
+    constexpr uint8_t s_removeBit = bit(CustomeDecorationOperationEnum::Remove);
+    constexpr uint8_t s_renameBit = bit(CustomeDecorationOperationEnum::Rename);
+}
+
+CustomDecorCollection CustomDecorList;
+
+void CustomeDecorationList::addOperation(CustomeDecorationOperationEnum op) {
+    if (operations & s_removeBit) {
+        if (op == CustomeDecorationOperationEnum::None) {
+            operations = 0;
+            prevOperations = 0;
+            SDL_Log("Cleared operations for removed decor '%s'", name.c_str());
+        }
+        else if (op != CustomeDecorationOperationEnum::Remove && !(prevOperations & bit(op))) {
+            prevOperations |= bit(op);
+            SDL_Log("Queued operation %d for removed decor '%s'", (int)op, name.c_str());
+        }
+        return;
+    }
+
+    if (op == CustomeDecorationOperationEnum::Remove) {
+        prevOperations = operations;
+        operations = s_removeBit;
+        SDL_Log("Marked decor '%s' for removal", name.c_str());
+        return;
+    }
+
+    if (op == CustomeDecorationOperationEnum::None) {
+        operations = 0;
+        SDL_Log("Reset operations for '%s'", name.c_str());
+        return;
+    }
+
+    if (name == originalName && (operations & s_renameBit)) {
+        operations &= static_cast<uint8_t>(~s_renameBit);
+        SDL_Log("Removed rename flag: '%s' reverted to original name", name.c_str());
+        return;
+    }
+
+    if (!(operations & bit(op))) {
+        operations |= bit(op);
+        SDL_Log("Added operation %d for '%s'", (int)op, name.c_str());
+    }
+}
+
+void CustomeDecorationList::restoreFromRemove() {
+    operations = prevOperations;
+    prevOperations = 0;
+}
+
+void CustomeDecorationList::sanitizeFileName(std::string& s) {
+    static const std::string invalidChars = "\\/:*?\"<>|";
+
+    for (char& c : s) {
+        if (invalidChars.find(c) != std::string::npos) {
+            c = '_';
+        }
+    }
+}
+
+std::string CustomDecorCollection::uniqueName(const std::string& base) {
+    if (!isNameTaken(base)) {
+        return base;
+    }
+
+    int& counter = m_nextSuffix[base];
+    if (counter == 0) counter = 1;
+
+    std::string newName;
+    do {
+        newName = base + "_new";
+        if (counter > 1)
+            newName += std::to_string(counter);
+        counter++;
+    } while (isNameTaken(newName));
+
+    SDL_Log("Renamed duplicate '%s' → '%s'", base.c_str(), newName.c_str());
+    return newName;
+}
+
+void CustomDecorCollection::releaseName(const std::string& name) {
+    // Only names uniqueName() can produce: base_new (1) and base_newN (N >= 2)
+    const std::size_t marker = name.rfind("_new");
+    if (marker == std::string::npos || marker == 0) {
+        return;
+    }
+
+    const std::size_t digits = marker + 4;
+    int suffix = 1;
+    if (digits < name.size()) {
+        if (name[digits] == '0' || name.size() - digits > 9) {
+            return;
+        }
+        suffix = 0;
+        for (std::size_t i = digits; i < name.size(); ++i) {
+            if (name[i] < '0' || name[i] > '9') {
+                return;
+            }
+            suffix = suffix * 10 + (name[i] - '0');
+        }
+        if (suffix < 2) {
+            return;
+        }
+    }
+
+    auto it = m_nextSuffix.find(name.substr(0, marker));
+    if (it != m_nextSuffix.end() && suffix < it->second) {
+        it->second = suffix;
+    }
+}
+
+CustomDecorCollection::Index CustomDecorCollection::add(CustomeDecorationList item) {
+    if (item.name.empty()) {
+        item.name = "unknown";
+    }
+    CustomeDecorationList::sanitizeFileName(item.name);
+
+    if (item.originalName.empty()) {
+        item.originalName = item.path.empty() ? item.name : item.path.stem().string();
+    }
+
+    std::string unique = uniqueName(item.name);
+    if (unique != item.name) {
+        item.name = std::move(unique);
+        item.addOperation(CustomeDecorationOperationEnum::Rename);
+    }
+
+    const Index index = m_items.size();
+    m_nameIndex.emplace(item.name, index);
+    if (item.contentHash != 0) {
+        m_hashIndex.emplace(item.contentHash, index);
+    }
+    m_items.push_back(std::move(item));
+    m_alive.push_back(true);
+    return index;
+}
+
+void CustomDecorCollection::rename(Index index, const std::string& newName) {
+    CustomeDecorationList& item = m_items[index];
+
+    std::string name = newName.empty() ? "unknown" : newName;
+    CustomeDecorationList::sanitizeFileName(name);
+    if (name == item.name) {
+        return;
+    }
+
+    m_nameIndex.erase(item.name);
+    releaseName(item.name);
+    item.name = uniqueName(name);
+    m_nameIndex.emplace(item.name, index);
+
+    item.addOperation(CustomeDecorationOperationEnum::Rename);
+}
+
+void CustomDecorCollection::erase(Index index) {
+    if (!isAlive(index)) {
+        return;
+    }
+
+    auto it = m_nameIndex.find(m_items[index].name);
+    if (it != m_nameIndex.end() && it->second == index) {
+        m_nameIndex.erase(it);
+        releaseName(m_items[index].name);
+    }
+
+    auto range = m_hashIndex.equal_range(m_items[index].contentHash);
+    for (auto hashIt = range.first; hashIt != range.second; ++hashIt) {
+        if (hashIt->second == index) {
+            m_hashIndex.erase(hashIt);
+            break;
+        }
+    }
+
+    m_items[index].texture.reset();
+    m_alive[index] = false;
+    ++m_deadCount;
+}
+
+void CustomDecorCollection::compact() {
+    if (m_deadCount == 0) {
+        return;
+    }
+
+    Index out = 0;
+    for (Index i = 0; i < m_items.size(); ++i) {
+        if (!m_alive[i]) continue;
+        if (out != i) {
+            m_items[out] = std::move(m_items[i]);
+        }
+        ++out;
+    }
+
+    m_items.resize(out);
+    m_alive.assign(out, true);
+    m_deadCount = 0;
+
+    m_nameIndex.clear();
+    m_nameIndex.reserve(out);
+    m_hashIndex.clear();
+    for (Index i = 0; i < out; ++i) {
+        m_nameIndex.emplace(m_items[i].name, i);
+        if (m_items[i].contentHash != 0) {
+            m_hashIndex.emplace(m_items[i].contentHash, i);
+        }
+    }
+}
+
+void CustomDecorCollection::clear() {
+    m_items.clear();
+    m_alive.clear();
+    m_deadCount = 0;
+    m_nameIndex.clear();
+    m_hashIndex.clear();
+    m_nextSuffix.clear();
+}
+
+bool CustomDecorCollection::isNameTaken(const std::string& name) const {
+    return m_nameIndex.find(name) != m_nameIndex.end();
+}
+
+CustomDecorCollection::Index CustomDecorCollection::findByHash(uint64_t hash, Index exclude) const {
+    if (hash == 0) {
+        return npos;
+    }
+
+    Index found = npos;
+    auto range = m_hashIndex.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second != exclude && it->second < found) {
+            found = it->second;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,86 @@
+#include <utils/decor_hash_index.hpp>
+#include <utils/content_hash.hpp>
+#include <utils/file_manager.hpp>
+#include <SDL.h>
+#include <sstream>
+#include <vector>
+
+DecorHashIndex::DecorHashIndex(std::filesystem::path indexFile) :
+    m_indexFile(std::move(indexFile))
+{}
+
+bool DecorHashIndex::load() {
+    m_entries.clear();
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(m_indexFile, error)) {
+        return false;
+    }
+
+    std::string bytes;
+    if (!FileManager::readLocalFile(m_indexFile, bytes)) {
+        return false;
+    }
+
+    // <hash> <size> <write time> <file name, may contain spaces>
+    for (const auto& line : FileManager::splitLines(bytes, true)) {
+        std::istringstream fields(line);
+        std::string hashText;
+        Entry entry;
+        if (!(fields >> hashText >> entry.size >> entry.writeTime)) continue;
+        if (!ContentHash::fromHex(hashText, entry.hash)) continue;
+
+        std::string name;
+        std::getline(fields >> std::ws, name);
+        if (name.empty()) continue;
+
+        m_entries[name] = entry;
+    }
+
+    SDL_Log("Loaded %zu decor hashes from %s", m_entries.size(), m_indexFile.string().c_str());
+    return true;
+}
+
+bool DecorHashIndex::save() const {
+    std::vector<std::string> lines;
+    lines.reserve(m_entries.size() + 1);
+    lines.push_back("# hash size write_time name");
+
+    for (const auto& [name, entry] : m_entries) {
+        lines.push_back(ContentHash::toHex(entry.hash) + " " + std::to_string(entry.size) + " " +
+                        std::to_string(entry.writeTime) + " " + name);
+    }
+    return FileManager::writeLocalFile(m_indexFile, FileManager::joinLines(lines));
+}
+
+bool DecorHashIndex::lookup(const std::string& name, uint64_t size, int64_t writeTime, uint64_t& hash) const {
+    auto it = m_entries.find(name);
+    if (it == m_entries.end() || it->second.size != size || it->second.writeTime != writeTime) {
+        return false;
+    }
+    hash = it->second.hash;
+    return true;
+}
+
+void DecorHashIndex::update(const std::string& name, uint64_t size, int64_t writeTime, uint64_t hash) {
+    m_entries[name] = { size, writeTime, hash };
+}
+
+void DecorHashIndex::retainOnly(const std::unordered_set<std::string>& seen) {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (seen.find(it->first) == seen.end()) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int64_t DecorHashIndex::writeTimeOf(const std::filesystem::path& path) {
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return 0;
+    }
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
@@ -0,0 +1,309 @@
+#include <utils/decor_importer.hpp>
+#include <utils/content_hash.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/png_stream.hpp>
+#include <utils/trace.hpp>
+#include <utils/texture.hpp>
+#include <SDL_image.h>
+#include <algorithm>
+
+DecorImporter::DecorImporter(TaskScheduler& scheduler) :
+    m_scheduler(scheduler)
+{}
+
+DecorImporter::~DecorImporter() {
+    cancel();
+}
+
+bool DecorImporter::start(std::vector<std::filesystem::path> files) {
+    if (m_isBusy) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Decor import already running, ignoring new request");
+        return false;
+    }
+    if (files.empty()) {
+        return false;
+    }
+
+    waitTasks();
+
+    m_files = std::move(files);
+    m_decoded = 0;
+    m_failed = 0;
+    m_hashedBytes = 0;
+    m_hashNanoseconds = 0;
+    m_cancelRequested = false;
+    m_optimized = 0;
+    m_bytesIn = 0;
+    m_bytesOut = 0;
+    m_activeOptions = m_pngOptions;
+    m_imported = 0;
+    m_duplicates = 0;
+    m_nextIndex = 0;
+    m_isBusy = true;
+    m_startTime = std::chrono::steady_clock::now();
+
+    // One task per file, so idle workers can steal the rest of a batch of large images
+    m_tasks.reserve(m_files.size());
+    for (std::size_t i = 0; i < m_files.size(); ++i) {
+        m_tasks.push_back(m_scheduler.submit([this, i](const TaskScheduler::Handle&) { decode(i); }));
+    }
+
+    SDL_Log("Importing %zu decor files on %u threads%s", m_files.size(), m_scheduler.workerCount(),
+        m_activeOptions.enabled ? " with PNG optimization" : "");
+    return true;
+}
+
+void DecorImporter::decode(std::size_t index) {
+    TRACE_ZONE("DecorImporter::decode");
+    MemoryTagScope memoryTag(MemoryTag::Decor);
+    if (m_cancelRequested.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Read once; the same bytes feed the header check, the decoder and the optimizer
+    const std::string path = m_files[index].string();
+    std::string bytes;
+    if (!FileManager::readLocalFile(m_files[index], bytes)) {
+        markFailed(index);
+        return;
+    }
+
+    PngOptimizer::PngInfo info;
+    if (!PngOptimizer::readPngInfo(bytes.data(), bytes.size(), info)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Not a valid PNG file: %s", path.c_str());
+        markFailed(index);
+        return;
+    }
+
+    // Oversized images are box-filtered row by row and never exist at full size.
+    // The optimizer stores up to "Max size", which may be more than the renderer
+    // takes, so on that path decode at the size that will be stored instead.
+    int decodeWidth = m_previewWidth;
+    int decodeHeight = m_previewHeight;
+    if (m_activeOptions.enabled) {
+        PngOptimizer::fitWithin(static_cast<int>(info.width), static_cast<int>(info.height),
+            m_activeOptions.maxDimension, decodeWidth, decodeHeight);
+    }
+    const auto decodeStart = std::chrono::steady_clock::now();
+    SDL_Surface* surface = PngStream::loadPreview(bytes.data(), bytes.size(), decodeWidth, decodeHeight);
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to decode %s: %s", path.c_str(), IMG_GetError());
+        markFailed(index);
+        return;
+    }
+    const double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+
+    std::string optimizedBytes;
+    PngOptimizer::Result optimized;
+    if (m_activeOptions.enabled && PngOptimizer::optimize(surface, info, bytes.size(), m_activeOptions, optimized)) {
+        // Decode the new file once: it is the preview, and the timing shows what the game will pay
+        const auto optimizedStart = std::chrono::steady_clock::now();
+        SDL_Surface* optimizedSurface = PngStream::loadPreview(optimized.bytes.data(), optimized.bytes.size(),
+            m_previewWidth, m_previewHeight);
+
+        if (optimizedSurface) {
+            const double optimizedMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - optimizedStart).count();
+            SDL_Log("Optimized %s: %ux%u -> %dx%d, %zu -> %zu bytes, decode %.2f -> %.2f ms (encode %.2f ms)",
+                path.c_str(), info.width, info.height, optimized.width, optimized.height,
+                bytes.size(), optimized.bytes.size(), decodeMs, optimizedMs, optimized.encodeMs);
+
+            SDL_FreeSurface(surface);
+            surface = optimizedSurface;
+            optimizedBytes = std::move(optimized.bytes);
+            m_optimized.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Optimized %s does not decode, keeping the original: %s",
+                path.c_str(), IMG_GetError());
+        }
+    }
+
+    // Kept the source, but decoded it for the optimizer at more than the renderer takes
+    if (surface->w > m_previewWidth || surface->h > m_previewHeight) {
+        SDL_FreeSurface(surface);
+        surface = PngStream::loadPreview(bytes.data(), bytes.size(), m_previewWidth, m_previewHeight);
+        if (!surface) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to decode %s: %s", path.c_str(), IMG_GetError());
+            markFailed(index);
+            return;
+        }
+    }
+
+    // Hash what will actually be stored, so the decor folder index matches
+    const std::string& stored = optimizedBytes.empty() ? bytes : optimizedBytes;
+    const auto hashStart = std::chrono::steady_clock::now();
+    const uint64_t contentHash = ContentHash::hash(stored);
+    m_hashNanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - hashStart).count()), std::memory_order_relaxed);
+    m_hashedBytes.fetch_add(stored.size(), std::memory_order_relaxed);
+    m_bytesIn.fetch_add(bytes.size(), std::memory_order_relaxed);
+    m_bytesOut.fetch_add(stored.size(), std::memory_order_relaxed);
+
+    pushReady({ index, surface, contentHash, std::move(optimizedBytes) });
+    m_decoded.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DecorImporter::pushReady(Decoded decoded) {
+    std::lock_guard<std::mutex> lock(m_readyMutex);
+    m_ready.push_back(std::move(decoded));
+    std::push_heap(m_ready.begin(), m_ready.end(), isLater);
+}
+
+void DecorImporter::markFailed(std::size_t index) {
+    // Still queued, so pump() can move past this file's place in the order
+    m_failed.fetch_add(1, std::memory_order_relaxed);
+    pushReady({ index, nullptr, 0, {} });
+}
+
+std::size_t DecorImporter::pump(SDL_Renderer* renderer, TextureManager& textures, CustomDecorCollection& decor,
+                                std::size_t maxUploads)
+{
+    if (!m_isBusy) {
+        return 0;
+    }
+    TRACE_ZONE("DecorImporter::pump");
+
+    // Only release the run that continues the selection order. Files that
+    // finish early wait in the heap, so names are assigned the same way
+    // however the workers were scheduled.
+    std::vector<Decoded> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_readyMutex);
+        std::size_t uploads = 0;
+        while (uploads < maxUploads && !m_ready.empty() && m_ready.front().index == m_nextIndex) {
+            std::pop_heap(m_ready.begin(), m_ready.end(), isLater);
+            if (m_ready.back().surface) {
+                ++uploads;
+            }
+            batch.push_back(std::move(m_ready.back()));
+            m_ready.pop_back();
+            ++m_nextIndex;
+        }
+    }
+
+    std::size_t added = 0;
+    for (Decoded& decoded : batch) {
+        if (!decoded.surface) {
+            continue;   // Already counted as failed
+        }
+        const std::filesystem::path& path = m_files[decoded.index];
+
+        const CustomDecorCollection::Index existing = decor.findByHash(decoded.contentHash);
+        if (existing != CustomDecorCollection::npos) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Skipping %s: identical to decor '%s'",
+                path.string().c_str(), decor[existing].name.c_str());
+            SDL_FreeSurface(decoded.surface);
+            ++m_duplicates;
+            continue;
+        }
+
+        SDL_Texture* texture = TextureUpload::fromSurface(renderer, decoded.surface, true);
+        SDL_FreeSurface(decoded.surface);
+
+        if (!texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create texture for %s: %s",
+                path.string().c_str(), SDL_GetError());
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        CustomeDecorationList item;
+        item.name = path.stem().string();
+        item.path = path;
+        item.texture = textures.adopt(texture, path, true);
+        item.contentHash = decoded.contentHash;
+        item.pendingBytes = std::move(decoded.optimizedBytes);
+        item.setOperation(CustomeDecorationOperationEnum::Add);
+        decor.add(std::move(item));
+        ++added;
+    }
+    m_imported += added;
+
+    if (m_imported + m_duplicates + m_failed.load(std::memory_order_relaxed) >= m_files.size()) {
+        finish();
+    }
+    return added;
+}
+
+void DecorImporter::finish() {
+    waitTasks();
+    m_isBusy = false;
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+    const Progress summary = progress();
+    SDL_Log("Decor import finished: %zu added, %zu duplicates, %zu failed in %.2f s (hashing %.0f MB/s)",
+        m_imported, m_duplicates, summary.failed, seconds, summary.hashMBps);
+    if (summary.optimized > 0) {
+        SDL_Log("PNG optimizer: %zu files re-encoded, %llu -> %llu bytes",
+            summary.optimized, static_cast<unsigned long long>(summary.bytesIn),
+            static_cast<unsigned long long>(summary.bytesOut));
+    }
+}
+
+void DecorImporter::cancel() {
+    m_cancelRequested = true;
+    for (const TaskScheduler::Handle& task : m_tasks) {
+        task.cancel();
+    }
+    waitTasks();
+
+    std::lock_guard<std::mutex> lock(m_readyMutex);
+    for (const Decoded& decoded : m_ready) {
+        SDL_FreeSurface(decoded.surface);
+    }
+    m_ready.clear();
+
+    if (m_isBusy) {
+        SDL_Log("Decor import cancelled after %zu of %zu files", m_imported, m_files.size());
+        m_isBusy = false;
+    }
+}
+
+void DecorImporter::waitTasks() {
+    for (const TaskScheduler::Handle& task : m_tasks) {
+        task.wait();
+    }
+    m_tasks.clear();
+}
+
+DecorImporter::Progress DecorImporter::progress() const {
+    Progress result;
+    result.total = m_files.size();
+    result.decoded = m_decoded.load(std::memory_order_relaxed);
+    result.imported = m_imported;
+    result.failed = m_failed.load(std::memory_order_relaxed);
+    result.duplicates = m_duplicates;
+    result.optimized = m_optimized.load(std::memory_order_relaxed);
+    result.bytesIn = m_bytesIn.load(std::memory_order_relaxed);
+    result.bytesOut = m_bytesOut.load(std::memory_order_relaxed);
+
+    // Summed over tasks, so this is per-core throughput
+    const uint64_t nanoseconds = m_hashNanoseconds.load(std::memory_order_relaxed);
+    if (nanoseconds > 0) {
+        result.hashMBps = (m_hashedBytes.load(std::memory_order_relaxed) / 1048576.0) / (nanoseconds / 1e9);
+    }
+    return result;
+}
+
+std::vector<std::filesystem::path> DecorImporter::listPngFiles(const std::filesystem::path& folder) {
+    std::vector<std::filesystem::path> files;
+    try {
+        for (const auto& entry : std::filesystem::directory_iterator(folder)) {
+            if (!entry.is_regular_file()) continue;
+
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".png") {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error listing %s: %s", folder.string().c_str(), e.what());
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
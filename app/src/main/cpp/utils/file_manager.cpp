@@ -1,57 +1,18 @@
 #include <utils/file_manager.hpp>
+#include <utils/storage_backend.hpp>
+#include <utils/decor_collection.hpp>
+#include <utils/memory_tracker.hpp>
+#include <utils/trace.hpp>
 #include <assets/data.hpp>
 #include <SDL.h>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <unordered_set>
 #ifdef __ANDROID__
-#include <jni.h>
-#endif
-
-#if defined(__ANDROID__)
-bool callFdExistsJNI(const std::string& path) {
-    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-    jobject activity = (jobject)SDL_AndroidGetActivity();
-    if (!env || !activity) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI environment or activity is null");
-        return false;
-    }
-
-    jclass activityClass = env->GetObjectClass(activity);
-    if (!activityClass) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get activity class");
-        return false;
-    }
-
-    jclass fileManagerClass = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-    if (!fileManagerClass) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FileManager class not found");
-        return false;
-    }
-
-    jmethodID fdExistsMethod = env->GetStaticMethodID(
-            fileManagerClass,
-            "fdExists",
-            "(Landroid/content/Context;Ljava/lang/String;)Z"
-    );
-
-    if (!fdExistsMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "fdExists method not found");
-        return false;
-    }
-
-    jstring jPath = env->NewStringUTF(path.c_str());
-    jboolean result = env->CallStaticBooleanMethod(fileManagerClass, fdExistsMethod, activity, jPath);
-
-    env->DeleteLocalRef(jPath);
-    env->DeleteLocalRef(fileManagerClass);
-    env->DeleteLocalRef(activityClass);
-
-    return (bool)result;
-}
+#include <utils/jni_bridge.hpp>
 #endif
 
 namespace FileManager {
@@ -65,168 +26,160 @@ namespace FileManager {
 
     void setGamePath(std::filesystem::path path) { gamePath = path; };
 
-    std::vector<std::string> readTextFile(const std::string& path) {
-        std::vector<std::string> lines;
-
+    namespace {
+        std::unique_ptr<StorageBackend> makeDefaultStorage() {
 #if defined(__ANDROID__)
-        JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-        jobject activity = (jobject)SDL_AndroidGetActivity();
-
-        if (!env || !activity) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNIEnv or Activity is null!");
-            return {};
-        }
-
-        jclass cls = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-        if (!cls) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot find FileManager class!");
-            return {};
-        }
-
-        jmethodID mid = env->GetStaticMethodID(
-                cls,
-                "readFullText",
-                "(Landroid/content/Context;Ljava/lang/String;)Ljava/lang/String;"
-        );
-        if (!mid) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Method readFullText not found!");
-            env->DeleteLocalRef(cls);
-            return {};
+            return std::make_unique<AndroidStorageBackend>();
+#else
+            return std::make_unique<DesktopStorageBackend>();
+#endif
         }
 
-        jstring jfilename = env->NewStringUTF(path.c_str());
-        jstring jresult = (jstring)env->CallStaticObjectMethod(cls, mid, activity, jfilename);
+        std::unique_ptr<StorageBackend> s_storage;
+    }
 
-        if (jresult) {
-            const char* chars = env->GetStringUTFChars(jresult, nullptr);
-            std::string result(chars);
-            env->ReleaseStringUTFChars(jresult, chars);
-            env->DeleteLocalRef(jresult);
+    void setStorageBackend(std::unique_ptr<StorageBackend> backend) {
+        s_storage = std::move(backend);
+    }
 
-            std::istringstream iss(result);
-            std::string line;
-            while (std::getline(iss, line)) {
-                lines.push_back(line);
-            }
-        } else {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "readFullText returned null for path: %s", path.c_str());
+    StorageBackend& storage() {
+        if (!s_storage) {
+            s_storage = makeDefaultStorage();
         }
+        return *s_storage;
+    }
 
-        env->DeleteLocalRef(jfilename);
-        env->DeleteLocalRef(cls);
-
-#else
-        try {
-            std::ifstream file(path);
-            if (!file.is_open()) {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for reading: %s", path.c_str());
-                return lines;
-            }
-            std::string line;
-            while (std::getline(file, line)) {
-                if (isCommentLine(line)) continue;
-                lines.push_back(line);
-            }
-        }
-        catch (const std::exception& e) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading file %s: %s", path.c_str(), e.what());
+    bool readLocalFile(const std::filesystem::path& path, std::string& bytes) {
+        SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "rb");
+        if (!rw) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for reading: %s", path.string().c_str());
+            return false;
         }
-#endif
-        return lines;
-    }
 
-    bool writeTextFile(const std::string& path, const std::vector<std::string>& lines) {
-#if defined(__ANDROID__)
-        JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-        jobject activity = (jobject)SDL_AndroidGetActivity();
+        const Sint64 size = SDL_RWsize(rw);
+        bool ok = size >= 0;
+        if (ok) {
+            bytes.resize(static_cast<size_t>(size));
+            ok = size == 0 || SDL_RWread(rw, bytes.data(), 1, bytes.size()) == bytes.size();
+        }
+        SDL_RWclose(rw);
 
-        if (!env || !activity) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get JNI environment or SDLActivity");
-            return false;
+        if (!ok) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading file %s: %s", path.string().c_str(), SDL_GetError());
         }
+        return ok;
+    }
 
-        jclass fileManagerClass = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-        if (!fileManagerClass) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot find FileManager class");
+    bool writeLocalFile(const std::filesystem::path& path, const std::string& bytes) {
+        SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "wb");
+        if (!rw) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for writing: %s", path.string().c_str());
             return false;
         }
 
-        jmethodID writeTextFileMethod = env->GetStaticMethodID(
-                fileManagerClass,
-                "writeTextFile",
-                "(Landroid/content/Context;Ljava/lang/String;Ljava/util/List;)Z"
-        );
-        if (!writeTextFileMethod) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot find writeTextFile() method in FileManager");
+        const bool ok = bytes.empty() || SDL_RWwrite(rw, bytes.data(), 1, bytes.size()) == bytes.size();
+        if (SDL_RWclose(rw) != 0 || !ok) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error writing file %s: %s", path.string().c_str(), SDL_GetError());
             return false;
         }
+        return true;
+    }
 
-        jstring jPath = env->NewStringUTF(path.c_str());
-
-        jclass arrayListClass = env->FindClass("java/util/ArrayList");
-        jmethodID arrayListCtor = env->GetMethodID(arrayListClass, "<init>", "()V");
-        jmethodID arrayListAdd = env->GetMethodID(arrayListClass, "add", "(Ljava/lang/Object;)Z");
-        jobject jList = env->NewObject(arrayListClass, arrayListCtor);
+    const std::filesystem::path& prefPath() {
+        static const std::filesystem::path s_prefPath = []() {
+            std::filesystem::path path;
+            if (char* pref = SDL_GetPrefPath("SENSE", "GameCustomizer")) {
+                path = pref;
+                SDL_free(pref);
+            }
+            else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetPrefPath failed: %s", SDL_GetError());
+            }
+            return path;
+        }();
+        return s_prefPath;
+    }
 
-        for (const auto& l : lines) {
-            jstring jLine = env->NewStringUTF(l.c_str());
-            env->CallBooleanMethod(jList, arrayListAdd, jLine);
-            env->DeleteLocalRef(jLine);
-        }
+    std::vector<std::string> splitLines(const std::string& bytes, bool skipComments) {
+        std::vector<std::string> lines;
+        lines.reserve(static_cast<size_t>(std::count(bytes.begin(), bytes.end(), '\n')) + 1);
 
-        jboolean result = env->CallStaticBooleanMethod(fileManagerClass, writeTextFileMethod, activity, jPath, jList);
+        size_t begin = 0;
+        while (begin < bytes.size()) {
+            size_t end = bytes.find('\n', begin);
+            if (end == std::string::npos) end = bytes.size();
 
-        env->DeleteLocalRef(jPath);
-        env->DeleteLocalRef(jList);
-        env->DeleteLocalRef(fileManagerClass);
+            size_t length = end - begin;
+            if (length > 0 && bytes[begin + length - 1] == '\r') --length;
 
-        return result == JNI_TRUE;
+            if (!(skipComments && length > 0 && bytes[begin] == '#')) {
+                lines.emplace_back(bytes, begin, length);
+            }
+            begin = end + 1;
+        }
+        return lines;
+    }
 
-#else
-    try {
-        std::ofstream file(path, std::ios::out | std::ios::trunc);
-        if (!file.is_open()) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for writing: %s", path.c_str());
-            return false;
+    std::string joinLines(const std::vector<std::string>& lines) {
+        size_t total = 0;
+        for (const auto& l : lines) {
+            total += l.size() + 1;
         }
+
+        std::string bytes;
+        bytes.reserve(total);
         for (const auto& l : lines) {
-            file << l << "\n";
+            bytes.append(l);
+            bytes.push_back('\n');
         }
-        return true;
+        return bytes;
     }
-    catch (const std::exception& e) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error writing file %s: %s", path.c_str(), e.what());
-        return false;
-    }
-#endif
+
+    void appendf(std::string& out, const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        va_list retry;
+        va_copy(retry, args);
+
+        char buffer[256];
+        const int length = std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+        va_end(args);
+        if (length > 0 && static_cast<size_t>(length) < sizeof(buffer)) {
+            out.append(buffer, static_cast<size_t>(length));
+        }
+        else if (length > 0) {
+            // Too long for the stack buffer: format again straight into `out`
+            const size_t start = out.size();
+            out.resize(start + static_cast<size_t>(length));
+            std::vsnprintf(&out[start], static_cast<size_t>(length) + 1, fmt, retry);
+        }
+        va_end(retry);
     }
 
-    bool fileExists(const std::string& filePath) {
-        try {
+    std::vector<std::string> readTextFile(const std::string& path) {
+        std::string bytes;
+        if (!storage().readFile(path, bytes)) {
+            return {};
+        }
+
 #if defined(__ANDROID__)
-            return callFdExistsJNI(filePath);
+        return splitLines(bytes, false);
 #else
-            return std::filesystem::is_regular_file(gamePath/filePath);
+        return splitLines(bytes, true);
 #endif
-        }
-        catch (const std::exception& e) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error checking file existence %s: %s", filePath.c_str(), e.what());
-            return false;
-        }
+    }
+
+    bool writeTextFile(const std::string& path, const std::vector<std::string>& lines) {
+        const std::string bytes = joinLines(lines);
+        return storage().writeFile(path, bytes.data(), bytes.size());
+    }
+
+    bool fileExists(const std::string& filePath) {
+        return storage().fileExists(joinPath(gamePath.string(), filePath));
     }
 
     bool dirExists(const std::string& dirPath) {
-        try {
-#if defined(__ANDROID__)
-            return callFdExistsJNI(dirPath);
-#else
-            return std::filesystem::is_directory(gamePath/dirPath);
-#endif
-        }
-        catch (const std::exception& e) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error checking directory existence %s: %s", dirPath.c_str(), e.what());
-            return false;
-        }
+        return storage().dirExists(joinPath(gamePath.string(), dirPath));
     }
 
     std::string extractQuotedValue(const std::string& line) {
@@ -306,52 +259,42 @@ namespace FileManager {
     }
 
     bool createFile(const std::string& fileName) {
-#if defined(__ANDROID__)
-        JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-        jobject activity = (jobject)SDL_AndroidGetActivity();
+        return storage().createFile(joinPath(gamePath.string(), fileName));
+    }
 
-        if (!env || !activity) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI environment or activity is null");
-            return false;
-        }
+    // Splits "KEY=VALUE" at the first '='. Returns false for lines without one.
+    static bool splitKeyValue(const std::string& line, std::string& key, std::string& value) {
+        size_t pos = line.find('=');
+        if (pos == std::string::npos) return false;
 
-        jclass fileManagerClass = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-        if (!fileManagerClass) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FileManager class not found");
-            return false;
-        }
+        key = line.substr(0, pos);
+        value = line.substr(pos + 1);
+        return true;
+    }
 
-        jmethodID createFileMethod = env->GetStaticMethodID(
-                fileManagerClass,
-                "createFile",
-                "(Landroid/content/Context;Ljava/lang/String;)Z"
-        );
-        if (!createFileMethod) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "createFile method not found in FileManager");
-            env->DeleteLocalRef(fileManagerClass);
-            return false;
+    static void rememberUnknown(std::vector<std::pair<std::string, std::string>>& table,
+        const std::string& key, const std::string& value)
+    {
+        for (auto& [entryKey, entryValue] : table) {
+            if (entryKey == key) {
+                entryValue = value;
+                return;
+            }
         }
-
-        jstring jFileName = env->NewStringUTF(fileName.c_str());
-
-        jboolean result = env->CallStaticBooleanMethod(fileManagerClass, createFileMethod, activity, jFileName);
-
-        env->DeleteLocalRef(jFileName);
-        env->DeleteLocalRef(fileManagerClass);
-
-        return result == JNI_TRUE;
-#else
-    try {
-        return std::filesystem::create_directories(gamePath);
-    } catch (const std::exception& e) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error creating directory %s: %s", gamePath.c_str(), e.what());
-        return false;
+        table.emplace_back(key, value);
     }
-#endif
+
+    static bool parseFontSize(const std::string& raw, int& size) {
+        std::string sizeStr = extractValue(raw);
+        if (sizeStr.empty() || !std::all_of(sizeStr.begin(), sizeStr.end(), ::isdigit)) return false;
+        size = std::stoi(sizeStr);
+        return size > 0;
     }
 
     // Localization
     std::map<std::string, std::string> loadLocalization() {
+        TRACE_ZONE("FileManager::loadLocalization");
+        MemoryTagScope memoryTag(MemoryTag::ConfigIO);
         std::map<std::string, std::string> result;
         std::string path = joinPath(gamePath.string(), LOCALIZATION_FILE);
 
@@ -359,24 +302,27 @@ namespace FileManager {
             createFile(LOCALIZATION_FILE);
         }
 
+        UnknownLocalizationEntries.clear();
+
+        std::string key;
+        std::string rawValue;
         for (const auto& line : readTextFile(path)) {
-            size_t pos = line.find('=');
-            if (pos == std::string::npos) continue;
+            if (!splitKeyValue(line, key, rawValue)) continue;
 
-            std::string key = line.substr(0, pos);
-            std::string value = extractQuotedValue(line.substr(pos + 1));
+            std::string value = extractQuotedValue(rawValue);
+            if (value.empty()) continue;
 
-            if (!value.empty()) {
-                std::string unescaped = unescapeString(value);
-                result[key] = unescaped;
+            std::string unescaped = unescapeString(value);
 
-                for (auto& [entryKey, entryValue] : LocalizationList) {
-                    if (entryKey == key) {
-                        std::snprintf(entryValue.data(), entryValue.size(), "%s", unescaped.c_str());
-                        break;
-                    }
-                }
+            const int index = LocalizationKeyHash.find(key);
+            if (index != PerfectHash<LocalizationKeyCount>::NotFound) {
+                LocalizationText& entryValue = LocalizationList[index];
+                std::snprintf(entryValue.data(), entryValue.size(), "%s", unescaped.c_str());
+            } else {
+                rememberUnknown(UnknownLocalizationEntries, key, value);
             }
+
+            result[key] = std::move(unescaped);
         }
 
         return result;
@@ -384,6 +330,8 @@ namespace FileManager {
 
     // Custom font
     bool loadCustomFontSize() {
+        TRACE_ZONE("FileManager::loadCustomFontSize");
+        MemoryTagScope memoryTag(MemoryTag::ConfigIO);
         std::string configPath = joinPath(gamePath.string(), FONT_FILE);
         auto lines = readTextFile(configPath);
 
@@ -391,51 +339,35 @@ namespace FileManager {
             createFile(FONT_FILE);
         }
 
+        UnknownFontEntries.clear();
+
         if (lines.empty()) return false;
 
+        std::string key;
+        std::string rawValue;
         for (const auto& line : lines) {
-            // FONT="..."
-            if (line.find("FONT=") == 0) {
-                std::string fontPath = extractQuotedValue(line.substr(5));
-                if (!fontPath.empty()) {
-                    auto it = std::find_if(FontList.begin(), FontList.end(),
-                        [](const auto& p) { return p.first == "FONT"; });
-                    if (it != FontList.end()) {
-                        std::array<char, 1024> buf{};
-                        strncpy(buf.data(), fontPath.c_str(), buf.size() - 1);
-                        it->second = buf;
-                        SDL_Log("Using custom FONT: %s", fontPath.c_str());
-                    }
-                }
+            if (!splitKeyValue(line, key, rawValue)) continue;
+
+            const int index = FontKeyHash.find(key);
+            if (index == PerfectHash<FontKeyCount>::NotFound) {
+                rememberUnknown(UnknownFontEntries, key, extractValue(rawValue));
+                continue;
             }
-            // FONT_SIZE=...
-            else if (line.find("FONT_SIZE=") == 0) {
-                std::string sizeStr = extractValue(line.substr(10));
-                if (!sizeStr.empty() && std::all_of(sizeStr.begin(), sizeStr.end(), ::isdigit)) {
-                    int size = std::stoi(sizeStr);
-                    if (size > 0) {
-                        auto it = std::find_if(FontList.begin(), FontList.end(),
-                            [](const auto& p) { return p.first == "FONT_SIZE"; });
-                        if (it != FontList.end()) {
-                            it->second = size;
-                            SDL_Log("Using custom FONT_SIZE: %d", size);
-                        }
-                    }
+
+            const FontKey fontKey = static_cast<FontKey>(index);
+            if (fontKey == FontKey::FONT) {
+                std::string fontPath = extractQuotedValue(rawValue);
+                if (!fontPath.empty()) {
+                    FontList.font.fill('\0');
+                    strncpy(FontList.font.data(), fontPath.c_str(), FontList.font.size() - 1);
+                    SDL_Log("Using custom FONT: %s", fontPath.c_str());
                 }
             }
-            // OTHER_TEXT_FONT_SIZE=...
-            else if (line.find("OTHER_TEXT_FONT_SIZE=") == 0) {
-                std::string sizeStr = extractValue(line.substr(21));
-                if (!sizeStr.empty() && std::all_of(sizeStr.begin(), sizeStr.end(), ::isdigit)) {
-                    int size = std::stoi(sizeStr);
-                    if (size > 0) {
-                        auto it = std::find_if(FontList.begin(), FontList.end(),
-                            [](const auto& p) { return p.first == "OTHER_TEXT_FONT_SIZE"; });
-                        if (it != FontList.end()) {
-                            it->second = size;
-                            SDL_Log("Using custom OTHER_TEXT_FONT_SIZE: %d", size);
-                        }
-                    }
+            else if (int* size = FontList.size(fontKey)) {
+                int parsed = 0;
+                if (parseFontSize(rawValue, parsed)) {
+                    *size = parsed;
+                    SDL_Log("Using custom %s: %d", keyName(fontKey), parsed);
                 }
             }
         }
@@ -444,6 +376,8 @@ namespace FileManager {
     }
 
     std::string loadCustomFontPath() {
+        TRACE_ZONE("FileManager::loadCustomFontPath");
+        MemoryTagScope memoryTag(MemoryTag::ConfigIO);
         std::string configPath = joinPath(gamePath.string(), FONT_FILE);
 
         if (!fileExists(FONT_FILE)) {
@@ -451,23 +385,14 @@ namespace FileManager {
         }
 
         auto lines = readTextFile(configPath);
+        std::string key;
+        std::string rawValue;
         for (const auto& line : lines) {
-            if (line.find("FONT=") == 0) {
-                std::string fontPath = extractQuotedValue(line.substr(5));
+            if (splitKeyValue(line, key, rawValue) && FontKeyHash.find(key) == static_cast<int>(FontKey::FONT)) {
+                std::string fontPath = resolveCustomFontPath(extractQuotedValue(rawValue));
                 if (!fontPath.empty()) {
-                    // If path is relative, prepend working directory
-                    if (fontPath[0] == '.' || !std::filesystem::path(fontPath).is_absolute()) {
-                        fontPath = joinPath(gamePath.string(), fontPath);
-                    }
-
-                    if (fileExists(fontPath)) {
-                        SDL_Log("Loading custom font: %s", fontPath.c_str());
-                        return fontPath;
-                    }
-                    else {
-                        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                            "Custom font file not found: %s", fontPath.c_str());
-                    }
+                    SDL_Log("Loading custom font: %s", fontPath.c_str());
+                    return fontPath;
                 }
             }
         }
@@ -475,8 +400,29 @@ namespace FileManager {
         return "";
     }
 
+    std::string resolveCustomFontPath(const std::string& fontPath) {
+        if (fontPath.empty()) {
+            return "";
+        }
+
+        std::string resolved = fontPath;
+        // If path is relative, prepend working directory
+        if (resolved[0] == '.' || !std::filesystem::path(resolved).is_absolute()) {
+            resolved = joinPath(gamePath.string(), resolved);
+        }
+
+        if (!fileExists(resolved)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Custom font file not found: %s", resolved.c_str());
+            return "";
+        }
+        return resolved;
+    }
+
     // Decor assets
     std::vector<DecorAsset> loadDecorAssets() {
+        TRACE_ZONE("FileManager::loadDecorAssets");
+        MemoryTagScope memoryTag(MemoryTag::Decor);
         std::vector<DecorAsset> assets;
         std::string configPath = joinPath(gamePath.string(), DECOR_CFG);
 
@@ -562,44 +508,76 @@ namespace FileManager {
         }
     }
 
+    ConfigChanges ConfigChanges::all() {
+        ConfigChanges changes;
+        changes.localization.set();
+        changes.font.set();
+        changes.unknownLocalization = true;
+        changes.unknownFont = true;
+        changes.decor.reserve(StandartDecorList.size());
+        for (const auto& [name, enabled] : StandartDecorList) {
+            changes.decor.push_back(name);
+        }
+        return changes;
+    }
+
     void updateAllConfigFiles() {
+        TRACE_ZONE("FileManager::updateAllConfigFiles");
+        updateConfigFiles(ConfigChanges::all());
+    }
+
+    void updateConfigFiles(const ConfigChanges& changes) {
+        TRACE_ZONE("FileManager::updateConfigFiles");
+        MemoryTagScope memoryTag(MemoryTag::ConfigIO);
         // --- localization.cfg ---
-        {
+        if (changes.localization.any() || changes.unknownLocalization) {
             std::string path = joinPath(gamePath.string(), LOCALIZATION_FILE);
             std::vector<std::string> lines;
 
             if (fileExists(path))
                 lines = readTextFile(path);
 
-            for (auto& [key, value] : LocalizationList) {
-                auto it = std::find_if(LocalizationStandartList.begin(), LocalizationStandartList.end(),
-                    [&](const auto& pair) { return pair.first == key; });
+            for (size_t i = 0; i < LocalizationKeyCount; ++i) {
+                if (!changes.localization.test(i)) continue;
+                const char* key = LocalizationKeyNames[i].data();
+                LocalizationText& value = LocalizationList[i];
 
-                if (it != LocalizationStandartList.end()) {
-                    if (value[0] == '\0') {
-                        strncpy(value.data(), it->second.data(), value.size() - 1);
-                        SDL_Log("Filled empty localization key '%s' with default value.", key.c_str());
-                    }
+                if (value[0] == '\0') {
+                    strncpy(value.data(), LocalizationStandartList[i].data(), value.size() - 1);
+                    SDL_Log("Filled empty localization key '%s' with default value.", key);
                 }
                 updateOrAddLine(lines, key, std::string(value.data()), true);
             }
 
+            // Values are kept as read (still escaped), so they are written back verbatim
+            if (changes.unknownLocalization) {
+                for (const auto& [key, value] : UnknownLocalizationEntries) {
+                    updateOrAddLine(lines, key, value, true);
+                }
+            }
+
             writeTextFile(path, lines);
             SDL_Log("Updated localization file: %s", path.c_str());
         }
 
         // --- font.cfg ---
-        {
+        if (changes.font.any() || changes.unknownFont) {
             std::string path = joinPath(gamePath.string(), FONT_FILE);
             std::vector<std::string> lines;
             if (fileExists(path))
                 lines = readTextFile(path);
 
-            for (auto& [key, value] : FontList) {
-                if (std::holds_alternative<int>(value))
-                    updateOrAddLine(lines, key, std::to_string(std::get<int>(value)));
-                else
-                    updateOrAddLine(lines, key, std::string(std::get<std::array<char, 1024>>(value).data()), false);
+            if (changes.font.test(static_cast<size_t>(FontKey::FONT)))
+                updateOrAddLine(lines, keyName(FontKey::FONT), std::string(FontList.font.data()), false);
+            if (changes.font.test(static_cast<size_t>(FontKey::FONT_SIZE)))
+                updateOrAddLine(lines, keyName(FontKey::FONT_SIZE), std::to_string(FontList.fontSize));
+            if (changes.font.test(static_cast<size_t>(FontKey::OTHER_TEXT_FONT_SIZE)))
+                updateOrAddLine(lines, keyName(FontKey::OTHER_TEXT_FONT_SIZE), std::to_string(FontList.otherTextFontSize));
+
+            if (changes.unknownFont) {
+                for (const auto& [key, value] : UnknownFontEntries) {
+                    updateOrAddLine(lines, key, value);
+                }
             }
 
             writeTextFile(path, lines);
@@ -607,13 +585,14 @@ namespace FileManager {
         }
 
         // --- decor.cfg ---
-        {
+        if (!changes.decor.empty()) {
             std::string path = joinPath(gamePath.string(), DECOR_CFG);
             std::vector<std::string> lines;
             if (fileExists(path))
                 lines = readTextFile(path);
 
             for (auto& [key, enabled] : StandartDecorList) {
+                if (std::find(changes.decor.begin(), changes.decor.end(), key) == changes.decor.end()) continue;
                 updateOrAddLine(lines, key, enabled ? "true" : "false");
             }
 
@@ -621,35 +600,23 @@ namespace FileManager {
             SDL_Log("Updated decor file: %s", path.c_str());
         }
 
-        SDL_Log("All config files updated successfully.");
+        SDL_Log("Config files updated (%zu entries).", changes.count());
     }
 
     void processCustomDecorations(const std::filesystem::path& gamePath) {
+        TRACE_ZONE("FileManager::processCustomDecorations");
+        MemoryTagScope memoryTag(MemoryTag::Decor);
         const auto decorDir = gamePath / "decor";
         SDL_Log("Scanning decor folder: %s", decorDir.string().c_str());
 
 #if defined(__ANDROID__)
-        JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
-        jobject activity = (jobject)SDL_AndroidGetActivity();
-        jclass fileManagerClass = env->FindClass("com/ipoleksenko/sense/customizer/FileManager");
-
-        jmethodID copyFileMethod = env->GetStaticMethodID(
-                fileManagerClass,
-                "copyFile",
-                "(Landroid/content/Context;Ljava/lang/String;Ljava/lang/String;)Z"
-        );
-
-        jmethodID deleteDecorFileMethod = env->GetStaticMethodID(
-                fileManagerClass,
-                "deleteDecorFile",
-                "(Landroid/content/Context;Ljava/lang/String;)Z"
-        );
-
-        jmethodID renameDecorFileMethod = env->GetStaticMethodID(
-                fileManagerClass,
-                "renameDecorFile",
-                "(Landroid/content/Context;Ljava/lang/String;Ljava/lang/String;)Z"
-                );
+        JNIEnv* env = Jni::env();
+        if (!env) {
+            return;
+        }
+
+        const Jni::Bindings& jni = Jni::bindings();
+        Jni::LocalRef<jobject> activity = Jni::activity(env);
 #else
     if (!std::filesystem::exists(decorDir)) {
         std::filesystem::create_directories(decorDir);
@@ -659,38 +626,46 @@ namespace FileManager {
 
         SDL_Log("CustomDecorList size: %d", (int)CustomDecorList.size());
 
+        // Content already in (or staying in) the decor folder. A new item whose
+        // bytes match is dropped instead of being copied in a second time.
+        std::unordered_set<uint64_t> storedHashes;
+        for (const auto& deco : CustomDecorList) {
+            if (deco.contentHash != 0 &&
+                !deco.hasOperation(CustomeDecorationOperationEnum::Add) &&
+                !deco.hasOperation(CustomeDecorationOperationEnum::Remove)) {
+                storedHashes.insert(deco.contentHash);
+            }
+        }
+
         for (auto& deco : CustomDecorList) {
             std::string ops;
-            for (auto op : deco.operations) {
-                switch (op) {
-                    case CustomeDecorationOperationEnum::Add: ops += "Add "; break;
-                    case CustomeDecorationOperationEnum::Remove: ops += "Remove "; break;
-                    case CustomeDecorationOperationEnum::Rename: ops += "Rename "; break;
-                    case CustomeDecorationOperationEnum::None: ops += "None "; break;
-                }
-            }
+            if (deco.hasOperation(CustomeDecorationOperationEnum::None)) ops += "None ";
+            if (deco.hasOperation(CustomeDecorationOperationEnum::Add)) ops += "Add ";
+            if (deco.hasOperation(CustomeDecorationOperationEnum::Remove)) ops += "Remove ";
+            if (deco.hasOperation(CustomeDecorationOperationEnum::Rename)) ops += "Rename ";
             SDL_Log("🔹 Decor: %s | path=%s | ops=[%s]",
                     deco.name.c_str(), deco.path.string().c_str(), ops.c_str());
 
             // ---------- ADD ----------
-            if (deco.hasOperation(CustomeDecorationOperationEnum::Add)) {
+            if (deco.hasOperation(CustomeDecorationOperationEnum::Add) &&
+                deco.contentHash != 0 && !storedHashes.insert(deco.contentHash).second) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                            "Not copying decor '%s': identical content is already in the decor folder",
+                            deco.name.c_str());
+                deco.setOperation(CustomeDecorationOperationEnum::Remove);
+            }
+            else if (deco.hasOperation(CustomeDecorationOperationEnum::Add)) {
+                TRACE_ZONE("Decor add");
 #if defined(__ANDROID__)
                 try {
-                    jstring jSourcePath = env->NewStringUTF(deco.path.string().c_str());
-                    jstring jTargetName = env->NewStringUTF((deco.name + ".png").c_str());
-
-                    jboolean result = env->CallStaticBooleanMethod(
-                            fileManagerClass,
-                            copyFileMethod,
-                            activity,
-                            jSourcePath,
-                            jTargetName
-                    );
+                    Jni::LocalRef<jstring> jSourcePath = Jni::newString(env, deco.path.string());
+                    Jni::LocalRef<jstring> jTargetName = Jni::newString(env, deco.name + ".png");
 
-                    env->DeleteLocalRef(jSourcePath);
-                    env->DeleteLocalRef(jTargetName);
+                    Jni::callStatic<jboolean>(env, jni.copyFile, activity.get(), jSourcePath.get(), jTargetName.get());
+                    Jni::clearException(env, "copyFile");
 
-                    deco.operations = { CustomeDecorationOperationEnum::None };
+                    deco.setOperation(CustomeDecorationOperationEnum::None);
+                    deco.originalName = deco.name;
                 } catch (...) {
                     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                                  "Exception while calling Java copyFile() for decor: %s",
@@ -699,10 +674,22 @@ namespace FileManager {
 #else
                 try {
                 auto destPath = decorDir / (deco.name + ".png");
-                std::filesystem::copy_file(deco.path, destPath,
-                    std::filesystem::copy_options::overwrite_existing);
+                if (!deco.pendingBytes.empty()) {
+                    // Optimized on import: the source file is left as it was
+                    if (!writeLocalFile(destPath, deco.pendingBytes)) {
+                        continue;
+                    }
+                    deco.pendingBytes.clear();
+                    deco.pendingBytes.shrink_to_fit();
+                }
+                else {
+                    std::filesystem::copy_file(deco.path, destPath,
+                        std::filesystem::copy_options::overwrite_existing);
+                }
                 deco.path = destPath;
-                deco.operations = { CustomeDecorationOperationEnum::None };
+                deco.texture.setSource(destPath);
+                deco.setOperation(CustomeDecorationOperationEnum::None);
+                deco.originalName = deco.name;
                 SDL_Log("Added custom decor: %s", destPath.string().c_str());
             }
             catch (const std::exception& e) {
@@ -713,18 +700,13 @@ namespace FileManager {
 
                 // ---------- REMOVE ----------
             else if (deco.hasOperation(CustomeDecorationOperationEnum::Remove)) {
+                TRACE_ZONE("Decor remove");
 #if defined(__ANDROID__)
                 try {
-                    jstring jFilePath = env->NewStringUTF(deco.path.string().c_str());
-
-                    jboolean deleted = env->CallStaticBooleanMethod(
-                            fileManagerClass,
-                            deleteDecorFileMethod,
-                            activity,
-                            jFilePath
-                    );
+                    Jni::LocalRef<jstring> jFilePath = Jni::newString(env, deco.path.string());
 
-                    env->DeleteLocalRef(jFilePath);
+                    jboolean deleted = Jni::callStatic<jboolean>(env, jni.deleteDecorFile, activity.get(), jFilePath.get());
+                    Jni::clearException(env, "deleteDecorFile");
 
                     if (deleted == JNI_TRUE) {
                         SDL_Log("Deleted decor file via Java: %s", deco.path.string().c_str());
@@ -734,7 +716,7 @@ namespace FileManager {
                                     deco.path.string().c_str());
                     }
 
-                    deco.operations = { CustomeDecorationOperationEnum::Remove };
+                    deco.setOperation(CustomeDecorationOperationEnum::Remove);
                 } catch (...) {
                     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                                  "Exception while calling Java deleteDecorFile() for decor: %s",
@@ -746,7 +728,7 @@ namespace FileManager {
                     std::filesystem::remove(deco.path);
                     SDL_Log("🗑Removed custom decor: %s", deco.path.string().c_str());
                 }
-                deco.operations = { CustomeDecorationOperationEnum::Remove };
+                deco.setOperation(CustomeDecorationOperationEnum::Remove);
             }
             catch (const std::exception& e) {
                 SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to remove decor: %s", e.what());
@@ -756,21 +738,15 @@ namespace FileManager {
 
                 // ---------- RENAME ----------
             else if (deco.hasOperation(CustomeDecorationOperationEnum::Rename)) {
+                TRACE_ZONE("Decor rename");
 #if defined(__ANDROID__)
                 try {
-                    jstring jOldFilePath = env->NewStringUTF(deco.path.string().c_str());
-                    jstring jNewFileName = env->NewStringUTF((deco.name + ".png").c_str());
-
-                    jboolean renamed = env->CallStaticBooleanMethod(
-                            fileManagerClass,
-                            renameDecorFileMethod,
-                            activity,
-                            jOldFilePath,
-                            jNewFileName
-                    );
+                    Jni::LocalRef<jstring> jOldFilePath = Jni::newString(env, deco.path.string());
+                    Jni::LocalRef<jstring> jNewFileName = Jni::newString(env, deco.name + ".png");
 
-                    env->DeleteLocalRef(jOldFilePath);
-                    env->DeleteLocalRef(jNewFileName);
+                    jboolean renamed = Jni::callStatic<jboolean>(
+                            env, jni.renameDecorFile, activity.get(), jOldFilePath.get(), jNewFileName.get());
+                    Jni::clearException(env, "renameDecorFile");
 
                     if (renamed == JNI_TRUE) {
                         deco.path = decorDir / (deco.name + ".png");
@@ -781,7 +757,8 @@ namespace FileManager {
                                     deco.name.c_str());
                     }
 
-                    deco.operations = { CustomeDecorationOperationEnum::None };
+                    deco.setOperation(CustomeDecorationOperationEnum::None);
+                    deco.originalName = deco.name;
                 } catch (...) {
                     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                                  "Exception while calling Java renameDecorFile() for decor: %s",
@@ -793,9 +770,11 @@ namespace FileManager {
                 if (std::filesystem::exists(deco.path)) {
                     std::filesystem::rename(deco.path, newPath);
                     deco.path = newPath;
+                    deco.texture.setSource(newPath);
                     SDL_Log("Renamed decor to: %s", newPath.string().c_str());
                 }
-                deco.operations = { CustomeDecorationOperationEnum::None };
+                deco.setOperation(CustomeDecorationOperationEnum::None);
+                deco.originalName = deco.name;
             }
             catch (const std::exception& e) {
                 SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to rename decor: %s", e.what());
@@ -804,22 +783,13 @@ namespace FileManager {
             }
         }
 
-#if defined(__ANDROID__)
-        env->DeleteLocalRef(fileManagerClass);
-#endif
+        // Dropping the item releases its texture handle
+        const size_t removed = CustomDecorList.eraseIf([](const CustomeDecorationList& d) {
+            return d.hasOperation(CustomeDecorationOperationEnum::Remove);
+        });
 
-        auto before = CustomDecorList.size();
-        CustomDecorList.erase(
-                std::remove_if(CustomDecorList.begin(), CustomDecorList.end(),
-                               [](const CustomeDecorationList& d) {
-                                   return d.hasOperation(CustomeDecorationOperationEnum::Remove);
-                               }),
-                CustomDecorList.end()
-        );
-        auto after = CustomDecorList.size();
-
-        if (after != before) {
-            SDL_Log("Removed %zu decorations from list (now %zu left).", before - after, after);
+        if (removed != 0) {
+            SDL_Log("Removed %zu decorations from list (now %zu left).", removed, CustomDecorList.size());
         }
 
         SDL_Log("Custom decorations processed.");
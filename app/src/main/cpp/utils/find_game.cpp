@@ -1,140 +1,67 @@
 #include <utils/find_game.hpp>
+#include <utils/trace.hpp>
 
 namespace fs = std::filesystem;
 
 #if defined(__ANDROID__)
+#include <utils/jni_bridge.hpp>
+
 FindGame::FindGame() = default;
 FindGame::~FindGame() = default;
 
-#include <jni.h>
-#include <SDL.h>
-#include <filesystem>
-
-namespace fs = std::filesystem;
-
 fs::path FindGame::getGamePath() {
+    TRACE_ZONE("FindGame::getGamePath");
     const std::string packageName = "com.ipoleksenko.sense";
 
-    JNIEnv* env = (JNIEnv*)SDL_AndroidGetJNIEnv();
+    JNIEnv* env = Jni::env();
     if (!env) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNIEnv is null!");
-        return {};
-    }
-
-    jclass activityThreadClass = env->FindClass("android/app/ActivityThread");
-    if (!activityThreadClass) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find ActivityThread class");
-        return {};
-    }
-
-    jmethodID currentApplicationMethod =
-            env->GetStaticMethodID(activityThreadClass, "currentApplication", "()Landroid/app/Application;");
-    if (!currentApplicationMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find currentApplication()");
-        env->DeleteLocalRef(activityThreadClass);
         return {};
     }
 
-    jobject appInstance = env->CallStaticObjectMethod(activityThreadClass, currentApplicationMethod);
-    if (!appInstance) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get Application instance");
-        env->DeleteLocalRef(activityThreadClass);
-        return {};
-    }
-
-    jclass contextClass = env->GetObjectClass(appInstance);
-    jmethodID getPackageManagerMethod =
-            env->GetMethodID(contextClass, "getPackageManager", "()Landroid/content/pm/PackageManager;");
-    if (!getPackageManagerMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find getPackageManager()");
-        env->DeleteLocalRef(contextClass);
-        env->DeleteLocalRef(activityThreadClass);
-        return {};
-    }
+    const Jni::Bindings& jni = Jni::bindings();
+    fs::path basePath;
+    {
+        Jni::LocalFrame frame(env);
 
-    jobject packageManager = env->CallObjectMethod(appInstance, getPackageManagerMethod);
-    if (!packageManager) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get PackageManager");
-        env->DeleteLocalRef(contextClass);
-        env->DeleteLocalRef(activityThreadClass);
-        return {};
-    }
-
-    jclass pmClass = env->GetObjectClass(packageManager);
-    jmethodID getPackageInfoMethod =
-            env->GetMethodID(pmClass, "getPackageInfo", "(Ljava/lang/String;I)Landroid/content/pm/PackageInfo;");
-    if (!getPackageInfoMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find getPackageInfo()");
-        env->DeleteLocalRef(pmClass);
-        env->DeleteLocalRef(packageManager);
-        env->DeleteLocalRef(contextClass);
-        env->DeleteLocalRef(activityThreadClass);
-        return {};
-    }
-
-    jstring pkgName = env->NewStringUTF(packageName.c_str());
-    env->CallObjectMethod(packageManager, getPackageInfoMethod, pkgName, 0);
-
-    bool installed = true;
-    if (env->ExceptionCheck()) {
-        env->ExceptionClear();
-        installed = false;
-    }
+        jobject appInstance = Jni::callStatic<jobject>(env, jni.currentApplication);
+        if (!appInstance) {
+            Jni::clearException(env, "currentApplication");
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get Application instance");
+            return {};
+        }
 
-    env->DeleteLocalRef(pkgName);
-    env->DeleteLocalRef(pmClass);
-    env->DeleteLocalRef(packageManager);
-    env->DeleteLocalRef(contextClass);
-    env->DeleteLocalRef(activityThreadClass);
+        jobject packageManager = Jni::call<jobject>(env, appInstance, jni.getPackageManager);
+        if (!packageManager) {
+            Jni::clearException(env, "getPackageManager");
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get PackageManager");
+            return {};
+        }
 
-    if (!installed) {
-        SDL_Log("Package %s not installed", packageName.c_str());
-        return {};
-    }
+        jstring pkgName = env->NewStringUTF(packageName.c_str());
+        Jni::call<jobject>(env, packageManager, jni.getPackageInfo, pkgName, jint(0));
 
-    jobject activity = (jobject)SDL_AndroidGetActivity();
-    if (!activity) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get SDL activity");
-        return {};
-    }
+        if (Jni::clearException(env, "getPackageInfo")) {
+            SDL_Log("Package %s not installed", packageName.c_str());
+            return {};
+        }
 
-    jclass activityClass = env->GetObjectClass(activity);
-    jmethodID getExternalFilesDirMethod =
-            env->GetMethodID(activityClass, "getExternalFilesDir", "(Ljava/lang/String;)Ljava/io/File;");
-    if (!getExternalFilesDirMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find getExternalFilesDir()");
-        env->DeleteLocalRef(activityClass);
-        return {};
-    }
+        jobject activity = static_cast<jobject>(SDL_AndroidGetActivity());
+        if (!activity) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get SDL activity");
+            return {};
+        }
 
-    jobject dirObj = env->CallObjectMethod(activity, getExternalFilesDirMethod, nullptr);
-    if (!dirObj) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "getExternalFilesDir() returned null");
-        env->DeleteLocalRef(activityClass);
-        return {};
-    }
+        jobject dirObj = Jni::call<jobject>(env, activity, jni.getExternalFilesDir, nullptr);
+        if (!dirObj) {
+            Jni::clearException(env, "getExternalFilesDir");
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "getExternalFilesDir() returned null");
+            return {};
+        }
 
-    jclass fileClass = env->FindClass("java/io/File");
-    jmethodID getAbsolutePathMethod =
-            env->GetMethodID(fileClass, "getAbsolutePath", "()Ljava/lang/String;");
-    if (!getAbsolutePathMethod) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find getAbsolutePath()");
-        env->DeleteLocalRef(fileClass);
-        env->DeleteLocalRef(dirObj);
-        env->DeleteLocalRef(activityClass);
-        return {};
+        jstring jPath = static_cast<jstring>(Jni::call<jobject>(env, dirObj, jni.getAbsolutePath));
+        basePath = Jni::toString(env, jPath);
     }
 
-    jstring jPath = (jstring)env->CallObjectMethod(dirObj, getAbsolutePathMethod);
-    const char* cPath = env->GetStringUTFChars(jPath, nullptr);
-    fs::path basePath = cPath;
-
-    env->ReleaseStringUTFChars(jPath, cPath);
-    env->DeleteLocalRef(jPath);
-    env->DeleteLocalRef(fileClass);
-    env->DeleteLocalRef(dirObj);
-    env->DeleteLocalRef(activityClass);
-
     std::string base = basePath.string();
     size_t pos = base.find("/Android/data/");
     if (pos == std::string::npos) {
@@ -192,6 +119,7 @@ bool FindGame::initSteam() {
 }
 
 fs::path FindGame::getGamePath() {
+    TRACE_ZONE("FindGame::getGamePath");
     if (!initSteam()) {
         return {};
     }
@@ -0,0 +1,94 @@
+#include <utils/font_loader.hpp>
+#include <utils/memory_tracker.hpp>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <chrono>
+
+namespace {
+    constexpr std::size_t s_pageSize = 4096;
+    constexpr int s_probeSize = 16;
+}
+
+std::mutex& FontLoader::libraryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+FontLoader::FontLoader(TaskScheduler& scheduler) :
+    m_scheduler(scheduler)
+{}
+
+FontLoader::~FontLoader() {
+    // The task only holds its own file, so it can finish on its own
+    m_task.cancel();
+}
+
+void FontLoader::load(std::filesystem::path path) {
+    m_task.cancel();
+
+    m_path = std::move(path);
+    m_font.reset();
+    m_state = State::Loading;
+
+    auto file = std::make_shared<MappedFile>();
+    m_task = m_scheduler.submit(
+        [file, path = m_path](const TaskScheduler::Handle&) { open(*file, path); },
+        TaskScheduler::Priority::High,
+        [this, file] {
+            if (file->isOpen()) {
+                m_font = file;
+                m_state = State::Ready;
+            }
+            else {
+                m_state = State::Failed;
+            }
+            m_isChanged = true;
+        });
+}
+
+void FontLoader::reset() {
+    m_task.cancel();
+    m_task = TaskScheduler::Handle();
+    m_path.clear();
+    m_font.reset();
+    m_state = State::Idle;
+}
+
+bool FontLoader::pump() {
+    const bool changed = m_isChanged;
+    m_isChanged = false;
+    return changed;
+}
+
+void FontLoader::open(MappedFile& file, const std::filesystem::path& path) {
+    MemoryTagScope memoryTag(MemoryTag::Text);
+    const auto start = std::chrono::steady_clock::now();
+
+    bool ok = file.open(path) && file.size() > 0;
+    if (ok) {
+        // Read every page in now, so the first glyph lookups on the render
+        // thread do not wait on the disk
+        volatile unsigned char sink = 0;
+        for (std::size_t offset = 0; offset < file.size(); offset += s_pageSize) {
+            sink = file.data()[offset];
+        }
+        static_cast<void>(sink);
+
+        std::lock_guard<std::mutex> lock(libraryMutex());
+        TTF_Font* probe = TTF_OpenFontRW(SDL_RWFromConstMem(file.data(), static_cast<int>(file.size())), SDL_TRUE, s_probeSize);
+        ok = probe != nullptr;
+        if (probe) {
+            TTF_CloseFont(probe);
+        }
+    }
+
+    if (ok) {
+        SDL_Log("Loaded font %s (%.1f MB%s) in %.1f ms", path.string().c_str(), file.size() / 1048576.0,
+            file.isMapped() ? ", mapped" : "",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot use font %s: %s", path.string().c_str(), TTF_GetError());
+        file.close();
+    }
+}
@@ -0,0 +1,117 @@
+#include <utils/frame_arena.hpp>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+FrameArena::FrameArena(std::size_t capacity) {
+    addBlock(capacity);
+}
+
+void FrameArena::addBlock(std::size_t minSize) {
+    const std::size_t size = std::max(minSize, m_blocks.empty() ? std::size_t(0) : m_blocks.back().size * 2);
+    if (!m_blocks.empty()) {
+        m_used += m_offset;
+    }
+    m_blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+    m_offset = 0;
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    Block* block = &m_blocks.back();
+    std::size_t start = (m_offset + alignment - 1) & ~(alignment - 1);
+    if (start + size > block->size) {
+        addBlock(size + alignment);
+        block = &m_blocks.back();
+        start = 0;
+    }
+
+    m_offset = start + size;
+    m_highWater = std::max(m_highWater, used());
+    return block->data.get() + start;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list copy;
+    va_copy(copy, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, copy);
+    va_end(copy);
+
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+
+    char* text = allocateArray<char>(static_cast<std::size_t>(length) + 1);
+    std::vsnprintf(text, static_cast<std::size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return text;
+}
+
+const char* FrameArena::pathString(const std::filesystem::path& path) {
+    using Char = std::filesystem::path::value_type;
+    if constexpr (std::is_same_v<Char, char>) {
+        return path.c_str();
+    }
+    else {
+        // UTF-16 (Windows): at most 3 bytes per code unit
+        const auto& native = path.native();
+        char* text = allocateArray<char>(native.size() * 3 + 1);
+        char* out = text;
+        for (std::size_t i = 0; i < native.size(); ++i) {
+            uint32_t c = static_cast<uint32_t>(native[i]);
+            if (c >= 0xD800 && c < 0xDC00 && i + 1 < native.size()) {
+                const uint32_t low = static_cast<uint32_t>(native[i + 1]);
+                if (low >= 0xDC00 && low < 0xE000) {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                    ++i;
+                }
+            }
+
+            if (c < 0x80) {
+                *out++ = static_cast<char>(c);
+            }
+            else if (c < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (c >> 6));
+                *out++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c < 0x10000) {
+                *out++ = static_cast<char>(0xE0 | (c >> 12));
+                *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else {
+                // Two code units in, four bytes out: still within the bound
+                *out++ = static_cast<char>(0xF0 | (c >> 18));
+                *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        *out = '\0';
+        return text;
+    }
+}
+
+void FrameArena::reset() {
+    // A frame overflowed: replace the chain with one block that fits it
+    if (m_blocks.size() > 1) {
+        const std::size_t size = capacity();
+        m_blocks.clear();
+        m_used = 0;
+        addBlock(size);
+    }
+    m_offset = 0;
+}
+
+std::size_t FrameArena::capacity() const {
+    std::size_t total = 0;
+    for (const Block& block : m_blocks) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,142 @@
+#include <utils/frame_skip.hpp>
+#include <utils/content_hash.hpp>
+#include <atomic>
+#include <cstring>
+
+namespace {
+    std::atomic<bool> s_isRedrawRequested{ true };
+
+    // Render thread only
+    uint64_t s_lastFingerprint = 0;
+    const ImDrawList* s_excludedList = nullptr;  // This frame's only
+    FrameSkip::Stats s_stats;
+
+    // The fields of a draw command that decide what it puts on screen,
+    // without the padding a raw ImDrawCmd would bring along
+    struct CommandKey {
+        float clipRect[4];
+        uint64_t texture;
+        uint64_t callback;
+        uint32_t vtxOffset;
+        uint32_t idxOffset;
+        uint32_t elemCount;
+        uint32_t reserved;
+    };
+
+    template <typename T>
+    uint64_t bitsOf(const T& value) {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "Pointer-sized values only");
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+
+    // ImGui 1.92 textures are created and updated by the renderer backend
+    // from the draw data; a pending change has to reach it
+    bool hasPendingTextureWork(const ImDrawData* drawData) {
+#if IMGUI_VERSION_NUM >= 19200
+        if (drawData->Textures) {
+            for (const ImTextureData* texture : *drawData->Textures) {
+                if (texture->Status != ImTextureStatus_OK) {
+                    return true;
+                }
+            }
+        }
+#else
+        (void)drawData;
+#endif
+        return false;
+    }
+
+    uint64_t fingerprint(const ImDrawData* drawData) {
+        const float display[6] = {
+            drawData->DisplayPos.x, drawData->DisplayPos.y,
+            drawData->DisplaySize.x, drawData->DisplaySize.y,
+            drawData->FramebufferScale.x, drawData->FramebufferScale.y,
+        };
+        uint64_t hash = ContentHash::hash(display, sizeof(display), static_cast<uint64_t>(drawData->CmdListsCount));
+
+        for (const ImDrawList* list : drawData->CmdLists) {
+            // Still counted in CmdListsCount, so showing or hiding it is a change
+            if (list == s_excludedList) {
+                continue;
+            }
+            hash = ContentHash::hash(list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert), hash);
+            hash = ContentHash::hash(list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+            for (const ImDrawCmd& command : list->CmdBuffer) {
+                const CommandKey key = {
+                    { command.ClipRect.x, command.ClipRect.y, command.ClipRect.z, command.ClipRect.w },
+                    bitsOf(command.GetTexID()),
+                    bitsOf(command.UserCallback),
+                    command.VtxOffset,
+                    command.IdxOffset,
+                    command.ElemCount,
+                    0,
+                };
+                hash = ContentHash::hash(&key, sizeof(key), hash);
+            }
+        }
+        return hash;
+    }
+}
+
+namespace FrameSkip {
+
+void requestRedraw() {
+    s_isRedrawRequested.store(true, std::memory_order_relaxed);
+}
+
+void noteEvent(const SDL_Event& event) {
+    switch (event.type) {
+    case SDL_WINDOWEVENT:
+        switch (event.window.event) {
+        case SDL_WINDOWEVENT_SHOWN:
+        case SDL_WINDOWEVENT_EXPOSED:
+        case SDL_WINDOWEVENT_RESIZED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+        case SDL_WINDOWEVENT_RESTORED:
+            requestRedraw();
+            break;
+        default:
+            break;
+        }
+        break;
+    case SDL_RENDER_TARGETS_RESET:
+    case SDL_RENDER_DEVICE_RESET:
+        requestRedraw();
+        break;
+    default:
+        break;
+    }
+}
+
+void excludeDrawList(const ImDrawList* list) {
+    s_excludedList = list;
+}
+
+bool shouldDraw(const ImDrawData* drawData) {
+    const bool isRedrawRequested = s_isRedrawRequested.exchange(false, std::memory_order_relaxed);
+    if (!drawData || hasPendingTextureWork(drawData)) {
+        // Nothing to compare with next time
+        s_lastFingerprint = 0;
+        s_excludedList = nullptr;
+        ++s_stats.drawn;
+        return true;
+    }
+
+    const uint64_t current = fingerprint(drawData);
+    s_excludedList = nullptr;
+    if (!isRedrawRequested && current == s_lastFingerprint) {
+        ++s_stats.skipped;
+        return false;
+    }
+    s_lastFingerprint = current;
+    ++s_stats.drawn;
+    return true;
+}
+
+Stats stats() {
+    return s_stats;
+}
+
+} // namespace FrameSkip
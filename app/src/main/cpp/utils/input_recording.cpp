@@ -0,0 +1,440 @@
+#include <utils/input_recording.hpp>
+#include <utils/file_manager.hpp>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    // Header: magic and format version. Then one record per event: frames
+    // since the previous record, the kind, the timestamp delta and the
+    // kind's fields. An End record closes the file on the last frame.
+    constexpr char s_magic[4] = { 'S', 'N', 'I', 'R' };
+    constexpr uint32_t s_version = 1;
+    constexpr std::size_t s_headerSize = 8;
+
+    enum Kind : uint8_t {
+        End,
+        Quit,
+        Window,
+        KeyDown,
+        KeyUp,
+        TextEditing,
+        TextInput,
+        MouseMotion,
+        MouseButtonDown,
+        MouseButtonUp,
+        MouseWheel,
+        FingerDown,
+        FingerUp,
+        FingerMotion,
+        ControllerAxis,
+        ControllerButtonDown,
+        ControllerButtonUp,
+        ControllerRemoved,
+        KindCount
+    };
+
+    constexpr Uint32 s_eventTypes[KindCount] = {
+        0,
+        SDL_QUIT,
+        SDL_WINDOWEVENT,
+        SDL_KEYDOWN,
+        SDL_KEYUP,
+        SDL_TEXTEDITING,
+        SDL_TEXTINPUT,
+        SDL_MOUSEMOTION,
+        SDL_MOUSEBUTTONDOWN,
+        SDL_MOUSEBUTTONUP,
+        SDL_MOUSEWHEEL,
+        SDL_FINGERDOWN,
+        SDL_FINGERUP,
+        SDL_FINGERMOTION,
+        SDL_CONTROLLERAXISMOTION,
+        SDL_CONTROLLERBUTTONDOWN,
+        SDL_CONTROLLERBUTTONUP,
+        SDL_CONTROLLERDEVICEREMOVED,
+    };
+
+    bool kindOf(Uint32 type, uint8_t& kind) {
+        for (uint8_t i = Quit; i < KindCount; ++i) {
+            if (s_eventTypes[i] == type) {
+                kind = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Integers are LEB128 varints, signed ones zigzag-encoded first, so the
+    // small values most fields hold take a byte or two
+    class RecordWriter {
+    public:
+        explicit RecordWriter(std::string& bytes) : m_bytes(bytes) {}
+
+        void varint(uint64_t value) {
+            while (value >= 0x80) {
+                m_bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            m_bytes.push_back(static_cast<char>(value));
+        }
+
+        template <typename T>
+        void field(T& value) {
+            static_assert(std::is_integral_v<T>, "RecordWriter fields are integers");
+            if constexpr (std::is_signed_v<T>) {
+                const int64_t wide = value;
+                varint((static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63));
+            }
+            else {
+                varint(value);
+            }
+        }
+
+        void field(float& value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            for (int shift = 0; shift < 32; shift += 8) m_bytes.push_back(static_cast<char>(bits >> shift));
+        }
+
+        // NUL-terminated text of an SDL text event
+        template <std::size_t N>
+        void text(char (&value)[N]) {
+            const void* nul = std::memchr(value, '\0', N - 1);
+            const std::size_t length = nul ? static_cast<const char*>(nul) - value : N - 1;
+            m_bytes.push_back(static_cast<char>(length));
+            m_bytes.append(value, length);
+        }
+
+    private:
+        std::string& m_bytes;
+    };
+
+    // Reads in place. Past the end or on a malformed value every read yields
+    // 0 and ok() turns false.
+    class RecordReader {
+    public:
+        RecordReader(const std::string& bytes, std::size_t& pos) : m_bytes(bytes), m_pos(pos) {}
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (!have(1)) return 0;
+                const uint8_t byte = static_cast<uint8_t>(m_bytes[m_pos++]);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return value;
+            }
+            m_ok = false;
+            return 0;
+        }
+
+        template <typename T>
+        void field(T& value) {
+            static_assert(std::is_integral_v<T>, "RecordReader fields are integers");
+            const uint64_t raw = varint();
+            if constexpr (std::is_signed_v<T>) {
+                value = static_cast<T>(static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1));
+            }
+            else {
+                value = static_cast<T>(raw);
+            }
+        }
+
+        void field(float& value) {
+            uint32_t bits = 0;
+            if (have(4)) {
+                for (int i = 0; i < 4; ++i) {
+                    bits |= static_cast<uint32_t>(static_cast<uint8_t>(m_bytes[m_pos + i])) << (8 * i);
+                }
+                m_pos += 4;
+            }
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+
+        template <std::size_t N>
+        void text(char (&value)[N]) {
+            std::memset(value, 0, sizeof(value));
+            const std::size_t length = have(1) ? static_cast<uint8_t>(m_bytes[m_pos++]) : 0;
+            if (length >= sizeof(value)) {
+                m_ok = false;
+                return;
+            }
+            if (have(length)) {
+                std::memcpy(value, m_bytes.data() + m_pos, length);
+                m_pos += length;
+            }
+        }
+
+        [[nodiscard]] bool ok() const { return m_ok; }
+
+    private:
+        bool have(std::size_t bytes) {
+            if (!m_ok || m_bytes.size() - m_pos < bytes) {
+                m_ok = false;
+                return false;
+            }
+            return true;
+        }
+
+        const std::string& m_bytes;
+        std::size_t& m_pos;
+        bool m_ok = true;
+    };
+
+    // The fields kept for each kind, shared by writing and reading so the two
+    // cannot drift apart
+    template <typename Stream>
+    void fields(Stream& stream, uint8_t kind, SDL_Event& event) {
+        switch (kind) {
+        case Window:
+            stream.field(event.window.windowID);
+            stream.field(event.window.event);
+            stream.field(event.window.data1);
+            stream.field(event.window.data2);
+            break;
+        case KeyDown:
+        case KeyUp: {
+            stream.field(event.key.windowID);
+            stream.field(event.key.state);
+            stream.field(event.key.repeat);
+            // SDL_Scancode/SDL_Keycode are enums and a typedef of Sint32
+            int32_t scancode = event.key.keysym.scancode;
+            int32_t sym = event.key.keysym.sym;
+            stream.field(scancode);
+            stream.field(sym);
+            event.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+            event.key.keysym.sym = static_cast<SDL_Keycode>(sym);
+            stream.field(event.key.keysym.mod);
+            break;
+        }
+        case TextEditing:
+            stream.field(event.edit.windowID);
+            stream.text(event.edit.text);
+            stream.field(event.edit.start);
+            stream.field(event.edit.length);
+            break;
+        case TextInput:
+            stream.field(event.text.windowID);
+            stream.text(event.text.text);
+            break;
+        case MouseMotion:
+            stream.field(event.motion.windowID);
+            stream.field(event.motion.which);
+            stream.field(event.motion.state);
+            stream.field(event.motion.x);
+            stream.field(event.motion.y);
+            stream.field(event.motion.xrel);
+            stream.field(event.motion.yrel);
+            break;
+        case MouseButtonDown:
+        case MouseButtonUp:
+            stream.field(event.button.windowID);
+            stream.field(event.button.which);
+            stream.field(event.button.button);
+            stream.field(event.button.state);
+            stream.field(event.button.clicks);
+            stream.field(event.button.x);
+            stream.field(event.button.y);
+            break;
+        case MouseWheel:
+            stream.field(event.wheel.windowID);
+            stream.field(event.wheel.which);
+            stream.field(event.wheel.x);
+            stream.field(event.wheel.y);
+            stream.field(event.wheel.direction);
+            stream.field(event.wheel.preciseX);
+            stream.field(event.wheel.preciseY);
+            stream.field(event.wheel.mouseX);
+            stream.field(event.wheel.mouseY);
+            break;
+        case FingerDown:
+        case FingerUp:
+        case FingerMotion:
+            stream.field(event.tfinger.touchId);
+            stream.field(event.tfinger.fingerId);
+            stream.field(event.tfinger.x);
+            stream.field(event.tfinger.y);
+            stream.field(event.tfinger.dx);
+            stream.field(event.tfinger.dy);
+            stream.field(event.tfinger.pressure);
+            stream.field(event.tfinger.windowID);
+            break;
+        case ControllerAxis:
+            stream.field(event.caxis.which);
+            stream.field(event.caxis.axis);
+            stream.field(event.caxis.value);
+            break;
+        case ControllerButtonDown:
+        case ControllerButtonUp:
+            stream.field(event.cbutton.which);
+            stream.field(event.cbutton.button);
+            stream.field(event.cbutton.state);
+            break;
+        case ControllerRemoved:
+            stream.field(event.cdevice.which);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+bool InputRecording::startRecording(std::filesystem::path path)
+{
+    finish();
+
+    m_bytes.assign(s_magic, sizeof(s_magic));
+    for (int shift = 0; shift < 32; shift += 8) m_bytes.push_back(static_cast<char>(s_version >> shift));
+
+    m_path = std::move(path);
+    m_mode = Mode::Recording;
+    m_frame = 0;
+    m_recordFrame = 0;
+    m_timestamp = 0;
+    m_eventCount = 0;
+    SDL_Log("Recording input to %s", m_path.string().c_str());
+    return true;
+}
+
+bool InputRecording::startReplay(const std::filesystem::path& path)
+{
+    finish();
+
+    std::string bytes;
+    if (!FileManager::readLocalFile(path, bytes)) {
+        return false;
+    }
+    uint32_t version = 0;
+    if (bytes.size() >= s_headerSize) {
+        for (int i = 0; i < 4; ++i) {
+            version |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[4 + i])) << (8 * i);
+        }
+    }
+    if (bytes.size() < s_headerSize || std::memcmp(bytes.data(), s_magic, sizeof(s_magic)) != 0 || version != s_version) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s is not an input recording this build can replay",
+            path.string().c_str());
+        return false;
+    }
+
+    m_bytes = std::move(bytes);
+    m_path = path;
+    m_mode = Mode::Replaying;
+    m_frame = 0;
+    m_recordFrame = 0;
+    m_timestamp = 0;
+    m_eventCount = 0;
+    m_readPos = s_headerSize;
+    m_replayStart = SDL_GetPerformanceCounter();
+    SDL_Log("Replaying input from %s", m_path.string().c_str());
+    return readRecordHeader();
+}
+
+bool InputRecording::finish()
+{
+    bool ok = true;
+    if (m_mode == Mode::Recording) {
+        RecordWriter out(m_bytes);
+        out.varint(m_frame - m_recordFrame);
+        out.varint(End);
+
+        ok = FileManager::writeLocalFile(m_path, m_bytes);
+        if (ok) {
+            SDL_Log("Recorded %zu input events over %llu frames (%zu bytes) to %s", m_eventCount,
+                static_cast<unsigned long long>(m_frame), m_bytes.size(), m_path.string().c_str());
+        }
+    }
+    else if (m_mode == Mode::Replaying) {
+        const double ms = (SDL_GetPerformanceCounter() - m_replayStart) * 1000.0
+                        / static_cast<double>(SDL_GetPerformanceFrequency());
+        SDL_Log("Replayed %zu input events over %llu frames in %.1f ms (%.3f ms per frame)", m_eventCount,
+            static_cast<unsigned long long>(m_frame), ms, m_frame > 0 ? ms / m_frame : 0.0);
+    }
+
+    m_mode = Mode::Off;
+    m_bytes.clear();
+    m_bytes.shrink_to_fit();
+    return ok;
+}
+
+void InputRecording::beginFrame()
+{
+    if (m_mode != Mode::Off) {
+        ++m_frame;
+    }
+}
+
+void InputRecording::record(const SDL_Event& event)
+{
+    uint8_t kind;
+    if (m_mode != Mode::Recording || !kindOf(event.type, kind)) {
+        return;
+    }
+
+    RecordWriter out(m_bytes);
+    out.varint(m_frame - m_recordFrame);
+    out.varint(kind);
+    int64_t timestampDelta = static_cast<int64_t>(event.common.timestamp) - m_timestamp;
+    out.field(timestampDelta);
+
+    SDL_Event copy = event;
+    fields(out, kind, copy);
+
+    m_recordFrame = m_frame;
+    m_timestamp = event.common.timestamp;
+    ++m_eventCount;
+}
+
+bool InputRecording::nextEvent(SDL_Event& event)
+{
+    if (m_mode != Mode::Replaying || m_nextKind == End || m_recordFrame > m_frame) {
+        return false;
+    }
+
+    RecordReader in(m_bytes, m_readPos);
+    int64_t timestampDelta = 0;
+    in.field(timestampDelta);
+
+    SDL_Event replayed;
+    std::memset(&replayed, 0, sizeof(replayed));
+    replayed.type = s_eventTypes[m_nextKind];
+    fields(in, m_nextKind, replayed);
+    if (!in.ok()) {
+        stopReplay("truncated event");
+        return false;
+    }
+    m_timestamp = static_cast<Uint32>(m_timestamp + timestampDelta);
+
+    // Stamped as just dequeued; the recorded time only says when it happened then
+    replayed.common.timestamp = SDL_GetTicks();
+    event = replayed;
+    ++m_eventCount;
+
+    readRecordHeader();
+    return true;
+}
+
+bool InputRecording::isReplayDone() const
+{
+    return m_mode == Mode::Replaying && m_nextKind == End && m_frame >= m_recordFrame;
+}
+
+bool InputRecording::readRecordHeader()
+{
+    RecordReader in(m_bytes, m_readPos);
+    const uint64_t frames = in.varint();
+    const uint64_t kind = in.varint();
+    if (!in.ok() || kind >= KindCount) {
+        stopReplay("malformed record");
+        return false;
+    }
+    m_recordFrame += frames;
+    m_nextKind = static_cast<uint8_t>(kind);
+    return true;
+}
+
+void InputRecording::stopReplay(const char* reason)
+{
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay of %s stops at frame %llu: %s",
+        m_path.string().c_str(), static_cast<unsigned long long>(m_frame), reason);
+    m_nextKind = End;
+    m_recordFrame = m_frame;
+}
@@ -1,78 +1,266 @@
 #include <utils/input_system.hpp>
+#include <utils/latency_tracker.hpp>
+#include <utils/frame_skip.hpp>
+#include <algorithm>
+#include <cmath>
 
+namespace {
+    constexpr ImGuiKey s_navKeys[] = {
+        ImGuiKey_GamepadFaceDown,
+        ImGuiKey_GamepadFaceRight,
+        ImGuiKey_GamepadFaceLeft,
+        ImGuiKey_GamepadFaceUp,
+        ImGuiKey_GamepadDpadUp,
+        ImGuiKey_GamepadDpadDown,
+        ImGuiKey_GamepadDpadLeft,
+        ImGuiKey_GamepadDpadRight,
+        ImGuiKey_GamepadLStickLeft,
+        ImGuiKey_GamepadLStickRight,
+        ImGuiKey_GamepadLStickUp,
+        ImGuiKey_GamepadLStickDown,
+    };
 
-void UpdateGamepadNavigation(ImGuiIO& io, SDL_GameController* controller)
-{
-    if (!controller) return;
-
-    float lx = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTX) / 32767.0f;
-    float ly = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTY) / 32767.0f;
-
-    auto addButton = [&](ImGuiKey key, SDL_GameControllerButton button)
-        {
-            bool pressed = SDL_GameControllerGetButton(controller, button);
-            io.AddKeyEvent(key, pressed);
-        };
-
-    auto addAnalog = [&](ImGuiKey key, float value)
-        {
-            io.AddKeyAnalogEvent(key, fabs(value) > 0.3f, fabs(value));
-        };
-
-    addButton(ImGuiKey_GamepadFaceDown, SDL_CONTROLLER_BUTTON_A); // OK/Enter
-    addButton(ImGuiKey_GamepadFaceRight, SDL_CONTROLLER_BUTTON_B); // Cancel
-    addButton(ImGuiKey_GamepadFaceLeft, SDL_CONTROLLER_BUTTON_X); // Back
-    addButton(ImGuiKey_GamepadFaceUp, SDL_CONTROLLER_BUTTON_Y);
-
-    addButton(ImGuiKey_GamepadDpadUp, SDL_CONTROLLER_BUTTON_DPAD_UP);
-    addButton(ImGuiKey_GamepadDpadDown, SDL_CONTROLLER_BUTTON_DPAD_DOWN);
-    addButton(ImGuiKey_GamepadDpadLeft, SDL_CONTROLLER_BUTTON_DPAD_LEFT);
-    addButton(ImGuiKey_GamepadDpadRight, SDL_CONTROLLER_BUTTON_DPAD_RIGHT);
-
-    addAnalog(ImGuiKey_GamepadLStickLeft, lx < -0.3f ? -lx : 0.0f);
-    addAnalog(ImGuiKey_GamepadLStickRight, lx > 0.3f ? lx : 0.0f);
-    addAnalog(ImGuiKey_GamepadLStickUp, ly < -0.3f ? -ly : 0.0f);
-    addAnalog(ImGuiKey_GamepadLStickDown, ly > 0.3f ? ly : 0.0f);
+    constexpr float s_stickDeadZone = 0.3f;
+
+    // Stick values reach ImGui in 1/64 steps, so noise on a held stick does
+    // not turn into an event per frame
+    constexpr float s_analogSteps = 64.0f;
+}
+
+InputSystem::~InputSystem() {
+    closeControllers();
 }
 
-void ProcessSDLEvents(bool& isRunning, std::vector<SDL_GameController*>& controllers)
+void InputSystem::closeControllers() {
+    for (auto& [id, controller] : m_controllers) {
+        if (controller.handle) {
+            SDL_GameControllerClose(controller.handle);
+        }
+    }
+    m_controllers.clear();
+}
+
+void InputSystem::processEvents(bool& isRunning)
 {
+    m_recording.beginFrame();
+
     SDL_Event event;
+    if (m_recording.mode() == InputRecording::Mode::Replaying) {
+        // Live input would make the run differ from the recording
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                isRunning = false;
+            }
+        }
+        while (m_recording.nextEvent(event)) {
+            handleEvent(event, isRunning);
+        }
+        if (m_recording.isReplayDone()) {
+            isRunning = false;
+        }
+        return;
+    }
+
     while (SDL_PollEvent(&event)) {
-        ImGui_ImplSDL2_ProcessEvent(&event);
+        m_recording.record(event);
+        handleEvent(event, isRunning);
+    }
+}
 
-        switch (event.type) {
-        case SDL_QUIT:
-            isRunning = false;
-            break;
-
-        case SDL_CONTROLLERDEVICEADDED: {
-            int joystick_index = event.cdevice.which;
-            if (SDL_IsGameController(joystick_index)) {
-                SDL_GameController* controller = SDL_GameControllerOpen(joystick_index);
-                if (controller) {
-                    controllers.push_back(controller);
-                    SDL_Log("Controller %d connected: %s", joystick_index, SDL_GameControllerName(controller));
-                }
-            }
-            break;
+void InputSystem::handleEvent(const SDL_Event& event, bool& isRunning)
+{
+    LatencyTracker::noteEvent(event);
+    FrameSkip::noteEvent(event);
+    ImGui_ImplSDL2_ProcessEvent(&event);
+
+    switch (event.type) {
+    case SDL_QUIT:
+        isRunning = false;
+        break;
+
+    case SDL_CONTROLLERDEVICEADDED:
+        addController(event.cdevice.which);
+        break;
+
+    case SDL_CONTROLLERDEVICEREMOVED:
+        removeController(event.cdevice.which);
+        break;
+
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        if (Controller* controller = findController(event.cbutton.which)) {
+            setButton(*controller, event.cbutton.button, event.type == SDL_CONTROLLERBUTTONDOWN);
         }
+        break;
 
-        case SDL_CONTROLLERDEVICEREMOVED: {
-            SDL_JoystickID joyId = event.cdevice.which;
-            for (auto it = controllers.begin(); it != controllers.end(); ++it) {
-                if (SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(*it)) == joyId) {
-                    SDL_GameControllerClose(*it);
-                    SDL_Log("Controller %d disconnected", joyId);
-                    controllers.erase(it);
-                    break;
-                }
-            }
-            break;
+    case SDL_CONTROLLERAXISMOTION:
+        if (Controller* controller = findController(event.caxis.which)) {
+            setAxis(*controller, event.caxis.axis, event.caxis.value);
         }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void InputSystem::updateTextInput(const ImGuiIO& io)
+{
+    // Each call reaches the platform IME, so only transitions are passed on
+    if (m_isTextInputSynced && io.WantTextInput == m_wantsTextInput) {
+        return;
+    }
+    m_isTextInputSynced = true;
+    m_wantsTextInput = io.WantTextInput;
+
+    if (m_wantsTextInput) {
+        SDL_StartTextInput();
+    }
+    else {
+        SDL_StopTextInput();
+    }
+}
+
+void InputSystem::takeOverImGuiGamepads()
+{
+    ImGui_ImplSDL2_SetGamepadMode(ImGui_ImplSDL2_GamepadMode_Manual, nullptr, 0);
+}
+
+void InputSystem::markImGuiGamepads(ImGuiIO& io)
+{
+    io.BackendFlags |= ImGuiBackendFlags_HasGamepad;
+}
 
-        default:
-            break;
+InputSystem::Controller* InputSystem::findController(SDL_JoystickID id)
+{
+    auto it = m_controllers.find(id);
+    if (it != m_controllers.end()) {
+        return &it->second;
+    }
+    // A replayed pad need not be plugged in: its events drive a stand-in
+    if (m_recording.mode() == InputRecording::Mode::Replaying) {
+        return &m_controllers[id];
+    }
+    return nullptr;
+}
+
+void InputSystem::addController(int deviceIndex)
+{
+    if (!SDL_IsGameController(deviceIndex)) {
+        return;
+    }
+    SDL_GameController* handle = SDL_GameControllerOpen(deviceIndex);
+    if (!handle) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot open controller %d: %s", deviceIndex, SDL_GetError());
+        return;
+    }
+
+    const SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(handle));
+    auto [it, isNew] = m_controllers.try_emplace(id);
+    if (!isNew) {
+        // Already open; SDL counts the opens, so this one is released again
+        SDL_GameControllerClose(handle);
+        return;
+    }
+    it->second.handle = handle;
+    SDL_Log("Controller %d connected: %s", id, SDL_GameControllerName(handle));
+
+    // Whatever is held while it connects counts from now on
+    for (Uint8 button = 0; button < SDL_CONTROLLER_BUTTON_MAX; ++button) {
+        if (SDL_GameControllerGetButton(handle, static_cast<SDL_GameControllerButton>(button))) {
+            setButton(it->second, button, true);
         }
     }
+    setAxis(it->second, SDL_CONTROLLER_AXIS_LEFTX, SDL_GameControllerGetAxis(handle, SDL_CONTROLLER_AXIS_LEFTX));
+    setAxis(it->second, SDL_CONTROLLER_AXIS_LEFTY, SDL_GameControllerGetAxis(handle, SDL_CONTROLLER_AXIS_LEFTY));
+}
+
+void InputSystem::removeController(SDL_JoystickID id)
+{
+    auto it = m_controllers.find(id);
+    if (it == m_controllers.end()) {
+        return;
+    }
+    if (it->second.handle) {
+        SDL_GameControllerClose(it->second.handle);
+    }
+    m_controllers.erase(it);
+    SDL_Log("Controller %d disconnected", id);
+
+    // Release anything only this controller was holding
+    for (std::size_t input = 0; input < s_navInputCount; ++input) {
+        publish(static_cast<NavInput>(input));
+    }
+}
+
+void InputSystem::setButton(Controller& controller, Uint8 button, bool isPressed)
+{
+    NavInput input;
+    switch (button) {
+    case SDL_CONTROLLER_BUTTON_A:          input = NavInput::FaceDown; break;
+    case SDL_CONTROLLER_BUTTON_B:          input = NavInput::FaceRight; break;
+    case SDL_CONTROLLER_BUTTON_X:          input = NavInput::FaceLeft; break;
+    case SDL_CONTROLLER_BUTTON_Y:          input = NavInput::FaceUp; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_UP:    input = NavInput::DpadUp; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_DOWN:  input = NavInput::DpadDown; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_LEFT:  input = NavInput::DpadLeft; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT: input = NavInput::DpadRight; break;
+    default: return;
+    }
+    setValue(controller, input, isPressed ? 1.0f : 0.0f);
+}
+
+void InputSystem::setAxis(Controller& controller, Uint8 axis, Sint16 value)
+{
+    const float position = std::max(-1.0f, value / 32767.0f);
+    const float negative = position < -s_stickDeadZone ? -position : 0.0f;
+    const float positive = position > s_stickDeadZone ? position : 0.0f;
+
+    switch (axis) {
+    case SDL_CONTROLLER_AXIS_LEFTX:
+        setValue(controller, NavInput::StickLeft, negative);
+        setValue(controller, NavInput::StickRight, positive);
+        break;
+    case SDL_CONTROLLER_AXIS_LEFTY:
+        setValue(controller, NavInput::StickUp, negative);
+        setValue(controller, NavInput::StickDown, positive);
+        break;
+    default:
+        break;
+    }
+}
+
+void InputSystem::setValue(Controller& controller, NavInput input, float value)
+{
+    float& current = controller.values[static_cast<std::size_t>(input)];
+    if (current == value) {
+        return;
+    }
+    current = value;
+    publish(input);
+}
+
+void InputSystem::publish(NavInput input)
+{
+    const std::size_t index = static_cast<std::size_t>(input);
+
+    // Several controllers at once: the one pushed furthest wins
+    float merged = 0.0f;
+    for (const auto& [id, controller] : m_controllers) {
+        merged = std::max(merged, controller.values[index]);
+    }
+    merged = std::round(merged * s_analogSteps) / s_analogSteps;
+
+    if (merged == m_sent[index]) {
+        return;
+    }
+    m_sent[index] = merged;
+
+    ImGuiIO& io = ImGui::GetIO();
+    if (input >= NavInput::StickLeft) {
+        io.AddKeyAnalogEvent(s_navKeys[index], merged > 0.0f, merged);
+    }
+    else {
+        io.AddKeyEvent(s_navKeys[index], merged > 0.0f);
+    }
 }
@@ -0,0 +1,350 @@
+#include <utils/jni_bridge.hpp>
+
+#if defined(__ANDROID__)
+#include <cstdint>
+#include <cstring>
+
+namespace Jni {
+
+namespace {
+    Bindings s_bindings;
+    bool s_isInit = false;
+
+    jclass findClass(JNIEnv* env, const char* name) {
+        LocalRef<jclass> local(env, env->FindClass(name));
+        if (!local) {
+            clearException(env, name);
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI class not found: %s", name);
+            return nullptr;
+        }
+        return static_cast<jclass>(env->NewGlobalRef(local.get()));
+    }
+
+    StaticMethod staticMethod(JNIEnv* env, jclass cls, const char* name, const char* signature) {
+        StaticMethod result;
+        result.cls = cls;
+        result.name = name;
+        result.signature = signature;
+
+        if (cls) {
+            result.id = env->GetStaticMethodID(cls, name, signature);
+            if (!result.id) {
+                clearException(env, name);
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI static method not found: %s%s", name, signature);
+            }
+        }
+        return result;
+    }
+
+    Method method(JNIEnv* env, jclass cls, const char* name, const char* signature) {
+        Method result;
+        result.name = name;
+        result.signature = signature;
+
+        if (cls) {
+            result.id = env->GetMethodID(cls, name, signature);
+            if (!result.id) {
+                clearException(env, name);
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI method not found: %s%s", name, signature);
+            }
+        }
+        return result;
+    }
+
+    // Skips one field descriptor and returns its code ('L' for objects, '[' for arrays).
+    char nextTypeCode(const char*& cursor) {
+        const char code = *cursor;
+        if (code == '[') {
+            while (*cursor == '[') ++cursor;
+            if (*cursor == 'L') {
+                while (*cursor && *cursor != ';') ++cursor;
+            }
+            if (*cursor) ++cursor;
+            return '[';
+        }
+        if (code == 'L') {
+            while (*cursor && *cursor != ';') ++cursor;
+            if (*cursor) ++cursor;
+            return 'L';
+        }
+        if (*cursor) ++cursor;
+        return code;
+    }
+
+    bool typeMatches(char expected, char actual) {
+        // A jobject may stand in for any reference type, arrays included
+        return expected == actual || (expected == 'L' && actual == '[');
+    }
+}
+
+bool init(JNIEnv* env) {
+    if (s_isInit) {
+        return true;
+    }
+
+    Bindings& b = s_bindings;
+
+    b.fileManager = findClass(env, "com/ipoleksenko/sense/customizer/FileManager");
+    b.activityThread = findClass(env, "android/app/ActivityThread");
+    b.context = findClass(env, "android/content/Context");
+    b.packageManager = findClass(env, "android/content/pm/PackageManager");
+    b.file = findClass(env, "java/io/File");
+    b.uri = findClass(env, "android/net/Uri");
+    b.intent = findClass(env, "android/content/Intent");
+
+    b.readFileBytes = staticMethod(env, b.fileManager, "readFileBytes",
+        "(Landroid/content/Context;Ljava/lang/String;)[B");
+    b.writeFileBytes = staticMethod(env, b.fileManager, "writeFileBytes",
+        "(Landroid/content/Context;Ljava/lang/String;Ljava/nio/ByteBuffer;)Z");
+    b.fdExists = staticMethod(env, b.fileManager, "fdExists",
+        "(Landroid/content/Context;Ljava/lang/String;)Z");
+    b.createFile = staticMethod(env, b.fileManager, "createFile",
+        "(Landroid/content/Context;Ljava/lang/String;)Z");
+    b.copyFile = staticMethod(env, b.fileManager, "copyFile",
+        "(Landroid/content/Context;Ljava/lang/String;Ljava/lang/String;)Z");
+    b.deleteDecorFile = staticMethod(env, b.fileManager, "deleteDecorFile",
+        "(Landroid/content/Context;Ljava/lang/String;)Z");
+    b.renameDecorFile = staticMethod(env, b.fileManager, "renameDecorFile",
+        "(Landroid/content/Context;Ljava/lang/String;Ljava/lang/String;)Z");
+    b.pickImageFromGallery = staticMethod(env, b.fileManager, "pickImageFromGallery", "()V");
+
+    b.currentApplication = staticMethod(env, b.activityThread, "currentApplication",
+        "()Landroid/app/Application;");
+    b.uriParse = staticMethod(env, b.uri, "parse",
+        "(Ljava/lang/String;)Landroid/net/Uri;");
+
+    b.getPackageManager = method(env, b.context, "getPackageManager",
+        "()Landroid/content/pm/PackageManager;");
+    b.getExternalFilesDir = method(env, b.context, "getExternalFilesDir",
+        "(Ljava/lang/String;)Ljava/io/File;");
+    b.startActivity = method(env, b.context, "startActivity",
+        "(Landroid/content/Intent;)V");
+    b.getPackageInfo = method(env, b.packageManager, "getPackageInfo",
+        "(Ljava/lang/String;I)Landroid/content/pm/PackageInfo;");
+    b.getLaunchIntentForPackage = method(env, b.packageManager, "getLaunchIntentForPackage",
+        "(Ljava/lang/String;)Landroid/content/Intent;");
+    b.getAbsolutePath = method(env, b.file, "getAbsolutePath",
+        "()Ljava/lang/String;");
+    b.intentInit = method(env, b.intent, "<init>",
+        "(Ljava/lang/String;Landroid/net/Uri;)V");
+
+    s_isInit = b.fileManager != nullptr;
+    SDL_Log("JNI bindings %s", s_isInit ? "resolved" : "incomplete");
+    return s_isInit;
+}
+
+void shutdown(JNIEnv* env) {
+    Bindings& b = s_bindings;
+    for (jclass cls : { b.fileManager, b.activityThread, b.context, b.packageManager,
+                        b.file, b.uri, b.intent }) {
+        if (cls) env->DeleteGlobalRef(cls);
+    }
+    s_bindings = Bindings();
+    s_isInit = false;
+}
+
+bool isInit() {
+    return s_isInit;
+}
+
+const Bindings& bindings() {
+    return s_bindings;
+}
+
+JNIEnv* env() {
+    JNIEnv* env = static_cast<JNIEnv*>(SDL_AndroidGetJNIEnv());
+    if (!env) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNIEnv is null!");
+        return nullptr;
+    }
+    if (!s_isInit) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI bindings were not resolved in JNI_OnLoad");
+        return nullptr;
+    }
+    return env;
+}
+
+LocalRef<jobject> activity(JNIEnv* env) {
+    return LocalRef<jobject>(env, static_cast<jobject>(SDL_AndroidGetActivity()));
+}
+
+LocalRef<jstring> newString(JNIEnv* env, const std::string& value) {
+    std::u16string utf16;
+    utf16.reserve(value.size());
+
+    const auto* bytes = reinterpret_cast<const unsigned char*>(value.data());
+    const std::size_t size = value.size();
+    std::size_t i = 0;
+
+    while (i < size) {
+        uint32_t cp = bytes[i];
+        std::size_t length = 1;
+
+        // 0x80-0xC1 (continuations, overlong 2-byte leads) and 0xF8-0xFF
+        // never start a sequence: one U+FFFD for the byte alone
+        if (cp >= 0xF0 && cp < 0xF8)      { cp &= 0x07; length = 4; }
+        else if (cp >= 0xE0 && cp < 0xF0) { cp &= 0x0F; length = 3; }
+        else if (cp >= 0xC2 && cp < 0xE0) { cp &= 0x1F; length = 2; }
+        else if (cp >= 0x80)              { cp = 0xFFFD; }
+
+        if (length > 1) {
+            if (i + length > size) {
+                cp = 0xFFFD;
+                length = size - i;
+            } else {
+                for (std::size_t k = 1; k < length; ++k) {
+                    if ((bytes[i + k] & 0xC0) != 0x80) {
+                        cp = 0xFFFD;
+                        length = k;
+                        break;
+                    }
+                    cp = (cp << 6) | (bytes[i + k] & 0x3F);
+                }
+            }
+        }
+        i += length;
+
+        if (cp >= 0x10000 && cp <= 0x10FFFF) {
+            cp -= 0x10000;
+            utf16.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+            utf16.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+        } else {
+            utf16.push_back(static_cast<char16_t>(cp > 0x10FFFF ? 0xFFFD : cp));
+        }
+    }
+
+    return LocalRef<jstring>(env, env->NewString(reinterpret_cast<const jchar*>(utf16.data()),
+                                                 static_cast<jsize>(utf16.size())));
+}
+
+std::string toString(JNIEnv* env, jstring value) {
+    if (!value) {
+        return {};
+    }
+
+    const jsize length = env->GetStringLength(value);
+    const jchar* chars = env->GetStringChars(value, nullptr);
+    if (!chars) {
+        return {};
+    }
+
+    std::string result;
+    result.reserve(static_cast<std::size_t>(length));
+
+    for (jsize i = 0; i < length; ++i) {
+        uint32_t cp = chars[i];
+        if (cp >= 0xD800 && cp < 0xDC00 && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] < 0xE000) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (chars[i + 1] - 0xDC00);
+            ++i;
+        } else if (cp >= 0xD800 && cp < 0xE000) {
+            cp = 0xFFFD; // Unpaired surrogate
+        }
+
+        if (cp < 0x80) {
+            result.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            result.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    env->ReleaseStringChars(value, chars);
+    return result;
+}
+
+bool clearException(JNIEnv* env, const char* what) {
+    if (!env->ExceptionCheck()) {
+        return false;
+    }
+
+    env->ExceptionClear();
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Java exception in %s", what);
+    return true;
+}
+
+LocalFrame::LocalFrame(JNIEnv* env, jint capacity) :
+    m_env(env),
+    m_isInit(env && env->PushLocalFrame(capacity) == JNI_OK)
+{
+    if (env && !m_isInit) {
+        clearException(env, "PushLocalFrame");
+    }
+}
+
+LocalFrame::~LocalFrame() {
+    if (m_isInit) {
+        m_env->PopLocalFrame(nullptr);
+    }
+}
+
+namespace detail {
+    bool checkSignature(const char* name, const char* signature, const char* codes, std::size_t count, char ret) {
+        const char* cursor = signature;
+        if (*cursor != '(') {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed JNI signature for %s: %s", name, signature);
+            return false;
+        }
+        ++cursor;
+
+        std::size_t index = 0;
+        while (*cursor && *cursor != ')') {
+            const char actual = nextTypeCode(cursor);
+            if (index >= count || !typeMatches(codes[index], actual)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "JNI argument %zu of %s does not match %s", index, name, signature);
+                return false;
+            }
+            ++index;
+        }
+
+        if (*cursor != ')' || index != count) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "JNI call to %s passes %zu arguments, %s expects %zu", name, count, signature, index);
+            return false;
+        }
+        ++cursor;
+
+        const char actualReturn = nextTypeCode(cursor);
+        if (!typeMatches(ret, actualReturn)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "JNI return type of %s does not match %s", name, signature);
+            return false;
+        }
+        return true;
+    }
+}
+
+} // namespace Jni
+
+extern "C"
+JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM* vm, void*)
+{
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK || !env) {
+        return JNI_ERR;
+    }
+
+    Jni::init(env);
+    return JNI_VERSION_1_6;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+JNI_OnUnload(JavaVM* vm, void*)
+{
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK && env) {
+        Jni::shutdown(env);
+    }
+}
+#endif
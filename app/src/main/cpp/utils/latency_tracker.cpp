@@ -0,0 +1,182 @@
+#include <utils/latency_tracker.hpp>
+#include <utils/file_manager.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Pending {
+        InputKind kind;
+        Uint64 happened;    // Performance counter
+        Uint64 dequeued;
+    };
+
+    // Inputs dequeued since the last present. Bounded in case nothing presents.
+    constexpr std::size_t s_maxPending = 256;
+    std::vector<Pending> s_pending;
+    Uint64 s_presentStart = 0;
+    LatencyTracker::Snapshot s_snapshot;
+
+    double toMs(Uint64 ticks) {
+        return ticks * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+
+    bool classify(const SDL_Event& event, InputKind& kind) {
+        switch (event.type) {
+        case SDL_MOUSEBUTTONDOWN:
+            // Touches also arrive as synthesized mouse events; count them once
+            if (event.button.which == SDL_TOUCH_MOUSEID) return false;
+            kind = InputKind::Mouse;
+            return true;
+        case SDL_MOUSEWHEEL:
+            if (event.wheel.which == SDL_TOUCH_MOUSEID) return false;
+            kind = InputKind::Mouse;
+            return true;
+        case SDL_KEYDOWN:
+            if (event.key.repeat) return false;
+            kind = InputKind::Keyboard;
+            return true;
+        case SDL_TEXTINPUT:
+            kind = InputKind::Keyboard;
+            return true;
+        case SDL_FINGERDOWN:
+            kind = InputKind::Touch;
+            return true;
+        case SDL_CONTROLLERBUTTONDOWN:
+            kind = InputKind::Gamepad;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void appendHistogram(std::string& out, const char* name, const LatencyTracker::Histogram& histogram, bool isLast) {
+        FileManager::appendf(out, "    \"%s\": { \"count\": %llu, \"mean_ms\": %.2f, \"p50_ms\": %.0f, \"p95_ms\": %.0f, "
+                     "\"p99_ms\": %.0f, \"max_ms\": %.2f, \"buckets_ms\": [",
+            name, static_cast<unsigned long long>(histogram.count), histogram.meanMs(),
+            histogram.percentile(0.50), histogram.percentile(0.95), histogram.percentile(0.99), histogram.maxMs);
+
+        // Trailing empty buckets are left out
+        std::size_t used = histogram.buckets.size();
+        while (used > 0 && histogram.buckets[used - 1] == 0) --used;
+        for (std::size_t i = 0; i < used; ++i) {
+            FileManager::appendf(out, i == 0 ? "%u" : ",%u", histogram.buckets[i]);
+        }
+        FileManager::appendf(out, "] }%s\n", isLast ? "" : ",");
+    }
+}
+
+namespace LatencyTracker {
+
+void Histogram::add(double ms) {
+    const std::size_t bucket = std::min(static_cast<std::size_t>(std::max(0.0, ms)), s_bucketCount - 1);
+    ++buckets[bucket];
+    ++count;
+    sumMs += ms;
+    maxMs = std::max(maxMs, ms);
+}
+
+double Histogram::percentile(double fraction) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    const uint64_t rank = static_cast<uint64_t>(fraction * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return static_cast<double>(i + 1);
+        }
+    }
+    return static_cast<double>(buckets.size());
+}
+
+const char* kindName(InputKind kind) {
+    switch (kind) {
+    case InputKind::Mouse: return "Mouse";
+    case InputKind::Keyboard: return "Keyboard";
+    case InputKind::Touch: return "Touch";
+    case InputKind::Gamepad: return "Gamepad";
+    default: return "Unknown";
+    }
+}
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Queue: return "Queue";
+    case Stage::Frame: return "Frame";
+    case Stage::Present: return "Present";
+    default: return "Unknown";
+    }
+}
+
+void noteEvent(const SDL_Event& event) {
+    InputKind kind;
+    if (!classify(event, kind)) {
+        return;
+    }
+
+    // SDL stamps events in milliseconds; the age is moved onto the
+    // performance counter so the later stages keep their resolution
+    const Uint64 now = SDL_GetPerformanceCounter();
+    const Uint32 ageMs = event.common.timestamp != 0 ? SDL_GetTicks() - event.common.timestamp : 0;
+    const Uint64 age = static_cast<Uint64>(ageMs) * SDL_GetPerformanceFrequency() / 1000;
+
+    if (s_pending.size() >= s_maxPending) {
+        s_pending.erase(s_pending.begin());
+    }
+    s_pending.push_back({ kind, age < now ? now - age : 0, now });
+}
+
+void beginPresent() {
+    s_presentStart = SDL_GetPerformanceCounter();
+}
+
+void endPresent() {
+    const Uint64 presented = SDL_GetPerformanceCounter();
+    ++s_snapshot.presents;
+
+    for (const Pending& input : s_pending) {
+        s_snapshot.total[static_cast<std::size_t>(input.kind)].add(toMs(presented - input.happened));
+        s_snapshot.stages[static_cast<std::size_t>(Stage::Queue)].add(toMs(input.dequeued - input.happened));
+        s_snapshot.stages[static_cast<std::size_t>(Stage::Frame)].add(toMs(s_presentStart - input.dequeued));
+        s_snapshot.stages[static_cast<std::size_t>(Stage::Present)].add(toMs(presented - s_presentStart));
+    }
+    s_pending.clear();
+}
+
+void skipPresent() {
+    s_pending.clear();
+}
+
+const Snapshot& snapshot() {
+    return s_snapshot;
+}
+
+void reset() {
+    s_snapshot = Snapshot();
+    s_pending.clear();
+}
+
+bool writeReport(const std::filesystem::path& path) {
+    std::string json = "{\n";
+    FileManager::appendf(json, "  \"presents\": %llu,\n", static_cast<unsigned long long>(s_snapshot.presents));
+    json += "  \"input_to_present\": {\n";
+    for (std::size_t kind = 0; kind < s_kindCount; ++kind) {
+        appendHistogram(json, kindName(static_cast<InputKind>(kind)), s_snapshot.total[kind], kind + 1 == s_kindCount);
+    }
+    json += "  },\n  \"stages\": {\n";
+    for (std::size_t stage = 0; stage < s_stageCount; ++stage) {
+        appendHistogram(json, stageName(static_cast<Stage>(stage)), s_snapshot.stages[stage], stage + 1 == s_stageCount);
+    }
+    json += "  }\n}\n";
+
+    if (!FileManager::writeLocalFile(path, json)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write latency report %s", path.string().c_str());
+        return false;
+    }
+    SDL_Log("Latency report written to %s", path.string().c_str());
+    return true;
+}
+
+} // namespace LatencyTracker
@@ -0,0 +1,746 @@
+#include <utils/localization_packs.hpp>
+#include <utils/memory_tracker.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace {
+    using LocalizationTable = std::array<LocalizationText, LocalizationKeyCount>;
+
+    constexpr char s_magic[4] = { 'S', 'L', 'P', '1' };
+    constexpr std::size_t s_headerSize = 16;
+    constexpr std::size_t s_slotSize = sizeof(LocalizationText);
+    constexpr std::size_t s_maxValue = s_slotSize - 1;
+    constexpr std::size_t s_chunkSize = 64 * 1024;
+    constexpr std::size_t s_maxLine = 64 * 1024;
+    constexpr const char* s_extension = ".pack";
+
+    static_assert(sizeof(LocalizationTable) == s_slotSize * LocalizationKeyCount);
+
+    // Buffered byte source over SDL_RWops; holds one chunk of the file at a time
+    class ChunkReader {
+    public:
+        explicit ChunkReader(SDL_RWops* rw) :
+            m_rw(rw),
+            m_buffer(new char[s_chunkSize])
+        {}
+
+        int peek() {
+            if (m_pos == m_end && !refill()) {
+                return -1;
+            }
+            return static_cast<unsigned char>(m_buffer[m_pos]);
+        }
+
+        int get() {
+            const int c = peek();
+            if (c >= 0) ++m_pos;
+            return c;
+        }
+
+        void skipBom() {
+            if (peek() != 0xEF) return;
+            if (m_end - m_pos >= 3 && static_cast<unsigned char>(m_buffer[m_pos + 1]) == 0xBB
+                && static_cast<unsigned char>(m_buffer[m_pos + 2]) == 0xBF) {
+                m_pos += 3;
+            }
+        }
+
+        // One line without its terminator, cut to `maxLength`. False at the end of the input.
+        bool readLine(std::string& line, std::size_t maxLength) {
+            line.clear();
+            int c = get();
+            if (c < 0) {
+                return false;
+            }
+            for (; c >= 0 && c != '\n'; c = get()) {
+                if (line.size() < maxLength) line.push_back(static_cast<char>(c));
+            }
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return true;
+        }
+
+    private:
+        bool refill() {
+            m_pos = 0;
+            m_end = SDL_RWread(m_rw, m_buffer.get(), 1, s_chunkSize);
+            return m_end > 0;
+        }
+
+        SDL_RWops* m_rw;
+        std::unique_ptr<char[]> m_buffer;
+        std::size_t m_pos = 0;
+        std::size_t m_end = 0;
+    };
+
+    bool writeHeader(SDL_RWops* rw) {
+        return SDL_RWwrite(rw, s_magic, 1, sizeof(s_magic)) == sizeof(s_magic)
+            && SDL_WriteLE32(rw, static_cast<Uint32>(LocalizationKeyCount)) == 1
+            && SDL_WriteLE32(rw, static_cast<Uint32>(s_slotSize)) == 1
+            && SDL_WriteLE32(rw, 0) == 1;
+    }
+
+    // Key count stored in the pack, or -1 if it is not one
+    int readHeader(SDL_RWops* rw) {
+        char magic[sizeof(s_magic)];
+        if (SDL_RWread(rw, magic, 1, sizeof(magic)) != sizeof(magic) || std::memcmp(magic, s_magic, sizeof(magic)) != 0) {
+            return -1;
+        }
+        const Uint32 keyCount = SDL_ReadLE32(rw);
+        const Uint32 slotSize = SDL_ReadLE32(rw);
+        SDL_ReadLE32(rw);
+        return slotSize == s_slotSize ? static_cast<int>(keyCount) : -1;
+    }
+
+    // Drops a multi-byte UTF-8 sequence cut off by truncation
+    void trimPartialUtf8(std::string& text) {
+        std::size_t lead = text.size();
+        for (std::size_t back = 0; back < 4 && lead > 0; ++back) {
+            const auto c = static_cast<unsigned char>(text[--lead]);
+            if ((c & 0xC0) != 0x80) {
+                const std::size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+                if (lead + length > text.size()) text.resize(lead);
+                return;
+            }
+        }
+    }
+
+    // Appends to a value, counting it as truncated once it no longer fits a slot
+    void appendCapped(std::string& text, char c, bool& truncated) {
+        if (text.size() < s_maxValue) {
+            text.push_back(c);
+        }
+        else {
+            truncated = true;
+        }
+    }
+
+    std::string_view trim(std::string_view text) {
+        const auto first = text.find_first_not_of(" \t");
+        if (first == std::string_view::npos) return {};
+        return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+    }
+
+    // Writes values of one language into their slots in place
+    class PackWriter {
+    public:
+        ~PackWriter() {
+            if (m_rw) SDL_RWclose(m_rw);
+        }
+
+        bool open(const std::filesystem::path& path) {
+            m_rw = SDL_RWFromFile(path.string().c_str(), "r+b");
+            if (m_rw && readHeader(m_rw) == static_cast<int>(LocalizationKeyCount)) {
+                return true;
+            }
+            if (m_rw) SDL_RWclose(m_rw);
+
+            // New (or outdated) pack: every slot starts empty
+            m_rw = SDL_RWFromFile(path.string().c_str(), "w+b");
+            if (!m_rw || !writeHeader(m_rw)) {
+                return false;
+            }
+            const LocalizationText empty{};
+            for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+                if (SDL_RWwrite(m_rw, empty.data(), 1, empty.size()) != empty.size()) return false;
+            }
+            return true;
+        }
+
+        bool write(std::size_t index, std::string_view value) {
+            LocalizationText slot{};
+            std::memcpy(slot.data(), value.data(), std::min(value.size(), s_maxValue));
+            return SDL_RWseek(m_rw, static_cast<Sint64>(s_headerSize + index * s_slotSize), RW_SEEK_SET) >= 0
+                && SDL_RWwrite(m_rw, slot.data(), 1, slot.size()) == slot.size();
+        }
+
+    private:
+        SDL_RWops* m_rw = nullptr;
+    };
+
+    // Output through SDL_RWops, flushed in chunks
+    class ChunkWriter {
+    public:
+        explicit ChunkWriter(SDL_RWops* rw) : m_rw(rw) { m_buffer.reserve(s_chunkSize); }
+
+        void append(std::string_view text) {
+            m_buffer.append(text.data(), text.size());
+            if (m_buffer.size() >= s_chunkSize) flush();
+        }
+
+        bool flush() {
+            if (!m_buffer.empty() && SDL_RWwrite(m_rw, m_buffer.data(), 1, m_buffer.size()) != m_buffer.size()) {
+                m_failed = true;
+            }
+            m_buffer.clear();
+            return !m_failed;
+        }
+
+    private:
+        SDL_RWops* m_rw;
+        std::string m_buffer;
+        bool m_failed = false;
+    };
+
+    void appendCsvField(ChunkWriter& out, std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out.append(text);
+            return;
+        }
+        out.append("\"");
+        for (std::size_t pos = 0; pos < text.size();) {
+            const std::size_t quote = std::min(text.find('"', pos), text.size());
+            out.append(text.substr(pos, quote - pos));
+            if (quote < text.size()) out.append("\"\"");
+            pos = quote + 1;
+        }
+        out.append("\"");
+    }
+
+    void appendPoString(ChunkWriter& out, std::string_view text) {
+        out.append("\"");
+        for (char c : text) {
+            switch (c) {
+            case '\\': out.append("\\\\"); break;
+            case '"':  out.append("\\\""); break;
+            case '\n': out.append("\\n"); break;
+            case '\t': out.append("\\t"); break;
+            case '\r': break;
+            default:   out.append(std::string_view(&c, 1)); break;
+            }
+        }
+        out.append("\"\n");
+    }
+
+    // Appends the quoted PO string in `line` (C escapes) to `target`
+    void readPoString(std::string_view line, std::string& target, bool& truncated) {
+        const std::size_t open = line.find('"');
+        const std::size_t close = line.rfind('"');
+        if (open == std::string_view::npos || close <= open) {
+            return;
+        }
+
+        for (std::size_t i = open + 1; i < close; ++i) {
+            char c = line[i];
+            if (c == '\\' && i + 1 < close) {
+                switch (line[++i]) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                default:  c = line[i]; break;
+                }
+            }
+            appendCapped(target, c, truncated);
+        }
+    }
+
+    bool startsWith(std::string_view text, std::string_view prefix) {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+
+    // Keys a language has no text for keep the game's default
+    void makeResident(const LocalizationTable& texts) {
+        for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+            LocalizationList[i] = texts[i][0] != '\0' ? texts[i] : LocalizationStandartList[i];
+        }
+    }
+}
+
+bool LocalizationPacks::isValidLanguage(std::string_view language) {
+    if (language.empty() || language.size() > 32) {
+        return false;
+    }
+    return std::all_of(language.begin(), language.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+    });
+}
+
+std::filesystem::path LocalizationPacks::packPath(const std::string& language) const {
+    return m_directory / (language + s_extension);
+}
+
+void LocalizationPacks::addLanguage(const std::string& language) {
+    auto it = std::lower_bound(m_languages.begin(), m_languages.end(), language);
+    if (it == m_languages.end() || *it != language) {
+        m_languages.insert(it, language);
+    }
+}
+
+bool LocalizationPacks::open(std::filesystem::path directory, const std::string& activeLanguage) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    m_directory.clear();
+    m_languages.clear();
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec || !isValidLanguage(activeLanguage)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot use localization packs in %s: %s",
+            directory.string().c_str(), ec ? ec.message().c_str() : "invalid language");
+        return false;
+    }
+    m_directory = std::move(directory);
+
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+        const std::filesystem::path& file = entry.path();
+        if (file.extension() == s_extension && isValidLanguage(file.stem().string())) {
+            addLanguage(file.stem().string());
+        }
+    }
+
+    m_active = activeLanguage;
+    m_dirty = true;
+    addLanguage(m_active);
+    SDL_Log("Localization packs: %zu language(s) in %s", m_languages.size(), m_directory.string().c_str());
+    return flush();
+}
+
+bool LocalizationPacks::readPack(const std::string& language, LocalizationTable& texts) const {
+    SDL_RWops* rw = SDL_RWFromFile(packPath(language).string().c_str(), "rb");
+    if (!rw) {
+        return false;
+    }
+
+    const int keyCount = readHeader(rw);
+    // Packs from a build with other keys still load the keys both know
+    const std::size_t count = keyCount < 0 ? 0 : std::min<std::size_t>(keyCount, LocalizationKeyCount);
+    const bool ok = keyCount >= 0 && SDL_RWread(rw, texts.data(), s_slotSize, count) == count;
+    SDL_RWclose(rw);
+
+    if (!ok) {
+        SDL_SetError("%s is not a valid localization pack", packPath(language).string().c_str());
+        return false;
+    }
+    for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+        if (i >= count) texts[i].fill('\0');
+        texts[i].back() = '\0';
+    }
+    return true;
+}
+
+bool LocalizationPacks::writePack(const std::string& language, const LocalizationTable& texts) {
+    // Written beside the pack and renamed over it, so a failed write keeps the old one
+    const std::filesystem::path path = packPath(language);
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+
+    SDL_RWops* rw = SDL_RWFromFile(temp.string().c_str(), "wb");
+    if (!rw) {
+        return false;
+    }
+    const bool written = writeHeader(rw) && SDL_RWwrite(rw, texts.data(), s_slotSize, texts.size()) == texts.size();
+    const bool closed = SDL_RWclose(rw) == 0;
+
+    std::error_code ec;
+    if (written && closed) {
+        std::filesystem::rename(temp, path, ec);
+    }
+    if (!written || !closed || ec) {
+        std::filesystem::remove(temp, ec);
+        SDL_SetError("Could not write %s", path.string().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LocalizationPacks::flush() {
+    if (!m_dirty || !isOpen()) {
+        return true;
+    }
+    if (!writePack(m_active, LocalizationList)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not save language '%s': %s", m_active.c_str(), SDL_GetError());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool LocalizationPacks::activate(const std::string& language) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    if (language == m_active) {
+        return true;
+    }
+    if (!flush()) {
+        return false;
+    }
+
+    auto texts = std::make_unique<LocalizationTable>();
+    if (!readPack(language, *texts)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load language '%s': %s", language.c_str(), SDL_GetError());
+        return false;
+    }
+
+    makeResident(*texts);
+    m_active = language;
+    SDL_Log("Switched localization to '%s'", language.c_str());
+    return true;
+}
+
+bool LocalizationPacks::finishImport(const ImportResult& result) {
+    for (const std::string& language : result.languages) {
+        addLanguage(language);
+    }
+
+    // The import went to the pack on disk; bring the resident copy up to date
+    if (std::find(result.languages.begin(), result.languages.end(), m_active) != result.languages.end()) {
+        auto texts = std::make_unique<LocalizationTable>();
+        if (!readPack(m_active, *texts)) {
+            return false;
+        }
+        makeResident(*texts);
+    }
+
+    SDL_Log("Imported %zu value(s) in %zu language(s); %zu unknown key(s), %zu truncated",
+        result.values, result.languages.size(), result.unknownKeys, result.truncated);
+    return true;
+}
+
+bool LocalizationPacks::importCsv(const std::filesystem::path& path, ImportResult& result) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    result = ImportResult();
+    if (!isOpen() || !flush()) {
+        return false;
+    }
+
+    SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "rb");
+    if (!rw) {
+        return false;
+    }
+    ChunkReader reader(rw);
+    reader.skipBom();
+
+    std::vector<std::unique_ptr<PackWriter>> writers;    // Per column; null for the key column
+    std::string field;
+    bool truncated = false;
+    std::size_t row = 0;
+    std::size_t column = 0;
+    int keyIndex = PerfectHash<LocalizationKeyCount>::NotFound;
+    bool failed = false;
+
+    auto endField = [&]() {
+        if (truncated) trimPartialUtf8(field);
+
+        if (row == 0) {
+            std::unique_ptr<PackWriter> writer;
+            const std::string language(trim(field));
+            if (column > 0 && isValidLanguage(language)) {
+                writer = std::make_unique<PackWriter>();
+                if (writer->open(packPath(language))) {
+                    result.languages.push_back(language);
+                }
+                else {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot write language '%s': %s", language.c_str(), SDL_GetError());
+                    writer.reset();
+                }
+            }
+            else if (column > 0) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Skipping CSV column %zu: '%s' is not a language code", column, language.c_str());
+            }
+            writers.push_back(std::move(writer));
+        }
+        else if (column == 0) {
+            const std::string_view key = trim(field);
+            keyIndex = LocalizationKeyHash.find(key);
+            if (keyIndex == PerfectHash<LocalizationKeyCount>::NotFound && !key.empty()) {
+                ++result.unknownKeys;
+            }
+        }
+        else if (keyIndex != PerfectHash<LocalizationKeyCount>::NotFound && column < writers.size() && writers[column]) {
+            if (writers[column]->write(static_cast<std::size_t>(keyIndex), field)) {
+                ++result.values;
+                if (truncated) ++result.truncated;
+            }
+            else {
+                failed = true;
+            }
+        }
+
+        field.clear();
+        truncated = false;
+        ++column;
+    };
+
+    auto endRow = [&]() {
+        endField();
+        ++row;
+        column = 0;
+        keyIndex = PerfectHash<LocalizationKeyCount>::NotFound;
+    };
+
+    bool inQuotes = false;
+    for (;;) {
+        const int c = reader.get();
+        if (inQuotes) {
+            if (c < 0) {
+                // Unterminated quote: keep what was read
+                endRow();
+                break;
+            }
+            if (c == '"') {
+                if (reader.peek() == '"') {
+                    reader.get();
+                    appendCapped(field, '"', truncated);
+                }
+                else {
+                    inQuotes = false;
+                }
+            }
+            else {
+                appendCapped(field, static_cast<char>(c), truncated);
+            }
+            continue;
+        }
+
+        if (c < 0) {
+            if (column > 0 || !field.empty()) endRow();
+            break;
+        }
+        switch (c) {
+        case '"':
+            if (field.empty()) inQuotes = true;
+            else appendCapped(field, '"', truncated);
+            break;
+        case ',':
+            endField();
+            break;
+        case '\r':
+            if (reader.peek() != '\n') endRow();
+            break;
+        case '\n':
+            endRow();
+            break;
+        default:
+            appendCapped(field, static_cast<char>(c), truncated);
+            break;
+        }
+    }
+
+    SDL_RWclose(rw);
+    writers.clear();
+
+    if (failed) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Writing imported values failed: %s", SDL_GetError());
+    }
+    return finishImport(result) && !failed;
+}
+
+bool LocalizationPacks::importPo(const std::filesystem::path& path, ImportResult& result) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    result = ImportResult();
+    if (!isOpen() || !flush()) {
+        return false;
+    }
+
+    SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "rb");
+    if (!rw) {
+        return false;
+    }
+    ChunkReader reader(rw);
+    reader.skipBom();
+
+    std::string context;
+    std::string id;
+    std::string text;
+    std::string* target = nullptr;
+    bool hasText = false;
+    bool truncated = false;
+    bool ignored = false;
+    bool failed = false;
+
+    std::string headerLanguage;
+    std::unique_ptr<PackWriter> writer;
+
+    auto finishEntry = [&]() {
+        if (context.empty() && id.empty()) {
+            // Header entry: "Language: xx\n" among its fields
+            const std::size_t pos = text.find("Language:");
+            if (pos != std::string::npos) {
+                const std::size_t end = text.find('\n', pos);
+                headerLanguage = std::string(trim(std::string_view(text).substr(pos + 9, end == std::string::npos ? std::string::npos : end - pos - 9)));
+            }
+        }
+        else if (!writer && !failed) {
+            const std::string language = isValidLanguage(headerLanguage) ? headerLanguage : path.stem().string();
+            writer = std::make_unique<PackWriter>();
+            if (!isValidLanguage(language) || !writer->open(packPath(language))) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No usable language for %s", path.string().c_str());
+                failed = true;
+            }
+            else {
+                result.languages.push_back(language);
+            }
+        }
+
+        if (writer && !failed && (!context.empty() || !id.empty())) {
+            const int index = LocalizationKeyHash.find(trim(context.empty() ? id : context));
+            if (index == PerfectHash<LocalizationKeyCount>::NotFound) {
+                ++result.unknownKeys;
+            }
+            else if (!text.empty()) {
+                if (truncated) trimPartialUtf8(text);
+                if (writer->write(static_cast<std::size_t>(index), text)) {
+                    ++result.values;
+                    if (truncated) ++result.truncated;
+                }
+                else {
+                    failed = true;
+                }
+            }
+        }
+
+        context.clear();
+        id.clear();
+        text.clear();
+        target = nullptr;
+        hasText = false;
+        truncated = false;
+    };
+
+    std::string line;
+    while (!failed && reader.readLine(line, s_maxLine)) {
+        const std::string_view view = trim(line);
+        if (view.empty()) {
+            if (hasText) finishEntry();
+            continue;
+        }
+        if (view[0] == '#') {
+            continue;
+        }
+
+        if (startsWith(view, "msgctxt")) {
+            if (hasText) finishEntry();
+            target = &context;
+        }
+        else if (startsWith(view, "msgid_plural")) {
+            target = nullptr;
+        }
+        else if (startsWith(view, "msgid")) {
+            if (hasText) finishEntry();
+            target = &id;
+        }
+        else if (startsWith(view, "msgstr[")) {
+            // Only the singular form is used
+            target = startsWith(view, "msgstr[0]") ? &text : nullptr;
+            hasText = true;
+        }
+        else if (startsWith(view, "msgstr")) {
+            target = &text;
+            hasText = true;
+        }
+        else if (view[0] != '"') {
+            continue;
+        }
+
+        if (target) {
+            readPoString(view, *target, target == &text ? truncated : ignored);
+        }
+    }
+    if (hasText && !failed) {
+        finishEntry();
+    }
+
+    SDL_RWclose(rw);
+    writer.reset();
+    return finishImport(result) && !failed;
+}
+
+bool LocalizationPacks::exportCsv(const std::filesystem::path& path) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    if (!isOpen() || !flush()) {
+        return false;
+    }
+
+    // One open pack per language; rows read one slot from each
+    std::vector<SDL_RWops*> packs;
+    std::vector<std::string> languages;
+    for (const std::string& language : m_languages) {
+        SDL_RWops* pack = SDL_RWFromFile(packPath(language).string().c_str(), "rb");
+        if (pack && readHeader(pack) == static_cast<int>(LocalizationKeyCount)) {
+            packs.push_back(pack);
+            languages.push_back(language);
+        }
+        else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Skipping language '%s' in export", language.c_str());
+            if (pack) SDL_RWclose(pack);
+        }
+    }
+
+    SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "wb");
+    bool ok = rw != nullptr;
+    if (ok) {
+        ChunkWriter out(rw);
+        out.append("key");
+        for (const std::string& language : languages) {
+            out.append(",");
+            appendCsvField(out, language);
+        }
+        out.append("\n");
+
+        LocalizationText slot{};
+        for (std::size_t i = 0; i < LocalizationKeyCount && ok; ++i) {
+            out.append(LocalizationKeyNames[i]);
+            for (SDL_RWops* pack : packs) {
+                ok = SDL_RWseek(pack, static_cast<Sint64>(s_headerSize + i * s_slotSize), RW_SEEK_SET) >= 0
+                    && SDL_RWread(pack, slot.data(), 1, slot.size()) == slot.size();
+                slot.back() = '\0';
+                out.append(",");
+                appendCsvField(out, ok ? std::string_view(slot.data()) : std::string_view());
+            }
+            out.append("\n");
+        }
+        ok = out.flush() && ok;
+        ok = SDL_RWclose(rw) == 0 && ok;
+    }
+
+    for (SDL_RWops* pack : packs) {
+        SDL_RWclose(pack);
+    }
+
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not export %s: %s", path.string().c_str(), SDL_GetError());
+        return false;
+    }
+    SDL_Log("Exported %zu language(s) to %s", languages.size(), path.string().c_str());
+    return true;
+}
+
+bool LocalizationPacks::exportPo(const std::string& language, const std::filesystem::path& path) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    if (!isOpen() || !flush()) {
+        return false;
+    }
+
+    auto texts = std::make_unique<LocalizationTable>();
+    if (!readPack(language, *texts)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not load language '%s': %s", language.c_str(), SDL_GetError());
+        return false;
+    }
+
+    SDL_RWops* rw = SDL_RWFromFile(path.string().c_str(), "wb");
+    if (!rw) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not export %s: %s", path.string().c_str(), SDL_GetError());
+        return false;
+    }
+
+    // msgctxt carries the key, msgid the game's default text as the source string
+    ChunkWriter out(rw);
+    out.append("msgid \"\"\nmsgstr \"\"\n\"Language: ");
+    out.append(language);
+    out.append("\\n\"\n\"Content-Type: text/plain; charset=UTF-8\\n\"\n");
+    for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+        out.append("\nmsgctxt ");
+        appendPoString(out, LocalizationKeyNames[i]);
+        out.append("msgid ");
+        appendPoString(out, LocalizationStandartList[i].data());
+        out.append("msgstr ");
+        appendPoString(out, (*texts)[i].data());
+    }
+    const bool ok = out.flush() && SDL_RWclose(rw) == 0;
+
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not export %s: %s", path.string().c_str(), SDL_GetError());
+        return false;
+    }
+    SDL_Log("Exported language '%s' to %s", language.c_str(), path.string().c_str());
+    return true;
+}
@@ -0,0 +1,104 @@
+#include <utils/mapped_file.hpp>
+#include <utils/file_manager.hpp>
+#include <SDL.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Maps `path` read-only. Null (and `size` 0) when it cannot be mapped or is empty.
+    const unsigned char* mapFile(const std::filesystem::path& path, std::size_t& size) {
+        size = 0;
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+
+        LARGE_INTEGER fileSize{};
+        const void* view = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            // The view keeps the mapping alive after both handles are closed
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+
+        if (view) size = static_cast<std::size_t>(fileSize.QuadPart);
+        return static_cast<const unsigned char*>(view);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat info{};
+        void* view = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+
+        if (view == MAP_FAILED) {
+            return nullptr;
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        return static_cast<const unsigned char*>(view);
+#endif
+    }
+
+    void unmapFile(const unsigned char* data, std::size_t size) {
+#if defined(_WIN32)
+        (void)size;
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path) {
+    close();
+
+    m_data = mapFile(path, m_size);
+    if (m_data) {
+        m_isMapped = true;
+        return true;
+    }
+
+    // Not mappable (or empty): read it instead
+    if (!FileManager::readLocalFile(path, m_fallback)) {
+        SDL_SetError("Could not open %s", path.string().c_str());
+        return false;
+    }
+    m_size = m_fallback.size();
+    m_isEmpty = m_fallback.empty();
+    m_data = m_isEmpty ? nullptr : reinterpret_cast<const unsigned char*>(m_fallback.data());
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_isMapped) {
+        unmapFile(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+    m_isEmpty = false;
+    m_fallback.clear();
+    m_fallback.shrink_to_fit();
+}
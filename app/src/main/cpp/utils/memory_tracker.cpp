@@ -0,0 +1,314 @@
+#include <utils/memory_tracker.hpp>
+#include <utils/file_manager.hpp>
+#include <SDL.h>
+#include <imgui.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    using MemoryTracker::s_tagCount;
+
+    // One per thread, on its own cache line, so counting never contends.
+    // Threads past the last slot share it; the counters are atomic either way.
+    struct alignas(64) ThreadCounters {
+        std::atomic<uint64_t> allocations[s_tagCount];
+        std::atomic<uint64_t> frees[s_tagCount];
+        std::atomic<uint64_t> bytesAllocated[s_tagCount];
+        std::atomic<uint64_t> bytesFreed[s_tagCount];
+    };
+
+    constexpr std::size_t s_slotCount = 64;
+    ThreadCounters s_slots[s_slotCount];
+    std::atomic<std::size_t> s_nextSlot{ 0 };
+    thread_local ThreadCounters* s_threadSlot = nullptr;
+
+    // Render thread only
+    MemoryTracker::Snapshot s_snapshot;
+    uint64_t s_lastAllocations = 0;
+    uint64_t s_lastBytes = 0;
+
+    [[maybe_unused]] ThreadCounters& threadCounters() {
+        if (!s_threadSlot) {
+            const std::size_t index = s_nextSlot.fetch_add(1, std::memory_order_relaxed);
+            s_threadSlot = &s_slots[std::min(index, s_slotCount - 1)];
+        }
+        return *s_threadSlot;
+    }
+
+#if defined(SENSE_MEMORY_TRACKING)
+    // Stored right before every tracked block, so frees are charged to the
+    // tag that allocated and need no size from the caller
+    struct alignas(16) Header {
+        uint64_t size;
+        uint32_t offset;    // From the malloc() pointer to the user pointer
+        uint8_t tag;
+    };
+    static_assert(sizeof(Header) == 16);
+
+    void* trackedAlloc(std::size_t size, std::size_t alignment, MemoryTag tag) {
+        alignment = std::max(alignment, sizeof(Header));
+        auto* raw = static_cast<unsigned char*>(std::malloc(size + alignment + sizeof(Header)));
+        if (!raw) {
+            return nullptr;
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(Header));
+        auto* user = reinterpret_cast<unsigned char*>((address + alignment - 1) & ~(alignment - 1));
+        auto* header = reinterpret_cast<Header*>(user) - 1;
+        header->size = size;
+        header->offset = static_cast<uint32_t>(user - raw);
+        header->tag = static_cast<uint8_t>(tag);
+
+        ThreadCounters& counters = threadCounters();
+        counters.allocations[header->tag].fetch_add(1, std::memory_order_relaxed);
+        counters.bytesAllocated[header->tag].fetch_add(size, std::memory_order_relaxed);
+        return user;
+    }
+
+    void trackedFree(void* ptr) {
+        if (!ptr) {
+            return;
+        }
+
+        auto* header = static_cast<Header*>(ptr) - 1;
+        ThreadCounters& counters = threadCounters();
+        counters.frees[header->tag].fetch_add(1, std::memory_order_relaxed);
+        counters.bytesFreed[header->tag].fetch_add(header->size, std::memory_order_relaxed);
+        std::free(static_cast<unsigned char*>(ptr) - header->offset);
+    }
+
+    void* trackedNew(std::size_t size, std::size_t alignment) {
+        if (void* ptr = trackedAlloc(size, alignment, MemoryTracker::detail::s_currentTag)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* SDLCALL sdlMalloc(std::size_t size) {
+        return trackedAlloc(size, sizeof(Header), MemoryTracker::detail::s_currentTag);
+    }
+
+    void* SDLCALL sdlCalloc(std::size_t count, std::size_t size) {
+        if (size != 0 && count > SIZE_MAX / size) {
+            return nullptr;
+        }
+        void* ptr = sdlMalloc(count * size);
+        if (ptr) {
+            std::memset(ptr, 0, count * size);
+        }
+        return ptr;
+    }
+
+    void* SDLCALL sdlRealloc(void* ptr, std::size_t size) {
+        if (!ptr) {
+            return sdlMalloc(size);
+        }
+
+        const auto* header = static_cast<const Header*>(ptr) - 1;
+        void* grown = trackedAlloc(size, sizeof(Header), static_cast<MemoryTag>(header->tag));
+        if (!grown) {
+            return nullptr;
+        }
+        std::memcpy(grown, ptr, std::min<std::size_t>(size, header->size));
+        trackedFree(ptr);
+        return grown;
+    }
+
+    void SDLCALL sdlFree(void* ptr) {
+        trackedFree(ptr);
+    }
+
+    void* imguiAlloc(std::size_t size, void*) {
+        return trackedAlloc(size, sizeof(Header), MemoryTag::ImGui);
+    }
+
+    void imguiFree(void* ptr, void*) {
+        trackedFree(ptr);
+    }
+#endif
+}
+
+#if defined(SENSE_MEMORY_TRACKING)
+void* operator new(std::size_t size) { return trackedNew(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return trackedNew(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t align) { return trackedNew(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return trackedNew(size, static_cast<std::size_t>(align)); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MemoryTracker::detail::s_currentTag);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, MemoryTracker::detail::s_currentTag);
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, static_cast<std::size_t>(align), MemoryTracker::detail::s_currentTag);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, static_cast<std::size_t>(align), MemoryTracker::detail::s_currentTag);
+}
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+#endif
+
+namespace MemoryTracker {
+
+const char* tagName(MemoryTag tag) {
+    switch (tag) {
+    case MemoryTag::Other:    return "other";
+    case MemoryTag::ConfigIO: return "config_io";
+    case MemoryTag::Decor:    return "decor";
+    case MemoryTag::Text:     return "text";
+    case MemoryTag::ImGui:    return "imgui";
+    default:                  return "unknown";
+    }
+}
+
+void install() {
+#if defined(SENSE_MEMORY_TRACKING)
+    // Blocks SDL handed out before the switch would reach our free() without
+    // a header (SDL's Android glue allocates argv before SDL_main)
+    if (SDL_GetNumAllocations() == 0) {
+        SDL_SetMemoryFunctions(sdlMalloc, sdlCalloc, sdlRealloc, sdlFree);
+    }
+    else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SDL already allocated, its memory is not tracked");
+    }
+    ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree);
+    SDL_Log("Memory tracking enabled");
+#endif
+}
+
+void beginFrame() {
+    ++s_snapshot.frames;
+    if (!isEnabled()) {
+        return;
+    }
+
+    uint64_t totalAllocations = 0;
+    uint64_t totalBytes = 0;
+    uint64_t liveBytes = 0;
+    for (std::size_t tag = 0; tag < s_tagCount; ++tag) {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t allocated = 0;
+        uint64_t freed = 0;
+        for (const ThreadCounters& slot : s_slots) {
+            allocations += slot.allocations[tag].load(std::memory_order_relaxed);
+            frees += slot.frees[tag].load(std::memory_order_relaxed);
+            allocated += slot.bytesAllocated[tag].load(std::memory_order_relaxed);
+            freed += slot.bytesFreed[tag].load(std::memory_order_relaxed);
+        }
+
+        TagStats& stats = s_snapshot.tags[tag];
+        stats.allocations = allocations;
+        stats.frees = frees;
+        stats.bytesAllocated = allocated;
+        // Another thread's free can land before its allocation is summed
+        stats.liveBytes = allocated > freed ? allocated - freed : 0;
+        stats.peakLiveBytes = std::max(stats.peakLiveBytes, stats.liveBytes);
+
+        totalAllocations += allocations;
+        totalBytes += allocated;
+        liveBytes += stats.liveBytes;
+    }
+
+    // The first call covers startup, which is not a frame
+    if (s_snapshot.frames > 1) {
+        s_snapshot.frameAllocations = totalAllocations - s_lastAllocations;
+        s_snapshot.frameBytes = totalBytes - s_lastBytes;
+        s_snapshot.maxFrameAllocations = std::max(s_snapshot.maxFrameAllocations, s_snapshot.frameAllocations);
+    }
+    s_lastAllocations = totalAllocations;
+    s_lastBytes = totalBytes;
+
+    s_snapshot.liveBytes = liveBytes;
+    s_snapshot.peakLiveBytes = std::max(s_snapshot.peakLiveBytes, liveBytes);
+}
+
+void setTextureBytes(uint64_t bytes) {
+    s_snapshot.textureBytes = bytes;
+}
+
+Snapshot snapshot() {
+    Snapshot result = s_snapshot;
+    result.peakRssBytes = peakRssBytes();
+    return result;
+}
+
+uint64_t peakRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+bool writeReport(const std::filesystem::path& path) {
+    const Snapshot stats = snapshot();
+
+    std::string json = "{\n";
+    FileManager::appendf(json, "  \"tracking\": %s,\n", isEnabled() ? "true" : "false");
+    FileManager::appendf(json, "  \"frames\": %llu,\n", static_cast<unsigned long long>(stats.frames));
+    FileManager::appendf(json, "  \"last_frame_allocations\": %llu,\n", static_cast<unsigned long long>(stats.frameAllocations));
+    FileManager::appendf(json, "  \"last_frame_bytes\": %llu,\n", static_cast<unsigned long long>(stats.frameBytes));
+    FileManager::appendf(json, "  \"max_frame_allocations\": %llu,\n", static_cast<unsigned long long>(stats.maxFrameAllocations));
+    FileManager::appendf(json, "  \"live_bytes\": %llu,\n", static_cast<unsigned long long>(stats.liveBytes));
+    FileManager::appendf(json, "  \"peak_live_bytes\": %llu,\n", static_cast<unsigned long long>(stats.peakLiveBytes));
+    FileManager::appendf(json, "  \"peak_rss_bytes\": %llu,\n", static_cast<unsigned long long>(stats.peakRssBytes));
+    FileManager::appendf(json, "  \"texture_bytes\": %llu,\n", static_cast<unsigned long long>(stats.textureBytes));
+    json += "  \"tags\": {\n";
+    for (std::size_t tag = 0; tag < s_tagCount; ++tag) {
+        const TagStats& t = stats.tags[tag];
+        FileManager::appendf(json, "    \"%s\": { \"allocations\": %llu, \"frees\": %llu, \"bytes_allocated\": %llu, "
+                      "\"live_bytes\": %llu, \"peak_live_bytes\": %llu }%s\n",
+            tagName(static_cast<MemoryTag>(tag)),
+            static_cast<unsigned long long>(t.allocations), static_cast<unsigned long long>(t.frees),
+            static_cast<unsigned long long>(t.bytesAllocated), static_cast<unsigned long long>(t.liveBytes),
+            static_cast<unsigned long long>(t.peakLiveBytes), tag + 1 < s_tagCount ? "," : "");
+    }
+    json += "  }\n}\n";
+
+    if (!FileManager::writeLocalFile(path, json)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write memory report %s", path.string().c_str());
+        return false;
+    }
+    SDL_Log("Memory report written to %s", path.string().c_str());
+    return true;
+}
+
+} // namespace MemoryTracker
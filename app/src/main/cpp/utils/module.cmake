@@ -7,18 +7,66 @@ include_directories(${SOURCE_DIR})
 
 set(MODULE_SOURCES
     ${MODULE_DIR}/texture.cpp
+    ${MODULE_DIR}/texture_manager.cpp
+    ${MODULE_DIR}/frame_arena.cpp
+    ${MODULE_DIR}/memory_tracker.cpp
+    ${MODULE_DIR}/trigram_index.cpp
+    ${MODULE_DIR}/localization_packs.cpp
+    ${MODULE_DIR}/mapped_file.cpp
+    ${MODULE_DIR}/preset_store.cpp
+    ${MODULE_DIR}/text_fit_analyzer.cpp
+    ${MODULE_DIR}/font_loader.cpp
+    ${MODULE_DIR}/task_scheduler.cpp
+    ${MODULE_DIR}/latency_tracker.cpp
+    ${MODULE_DIR}/trace.cpp
+    ${MODULE_DIR}/frame_skip.cpp
     ${MODULE_DIR}/icon.cpp
     ${MODULE_DIR}/find_game.cpp
     ${MODULE_DIR}/input_system.cpp
+    ${MODULE_DIR}/input_recording.cpp
     ${MODULE_DIR}/file_manager.cpp
+    ${MODULE_DIR}/decor_collection.cpp
+    ${MODULE_DIR}/decor_importer.cpp
+    ${MODULE_DIR}/decor_hash_index.cpp
+    ${MODULE_DIR}/content_hash.cpp
+    ${MODULE_DIR}/png_optimizer.cpp
+    ${MODULE_DIR}/png_stream.cpp
+    ${MODULE_DIR}/storage_backend.cpp
+    ${MODULE_DIR}/steam_status.cpp
+    ${MODULE_DIR}/jni_bridge.cpp
 )
 
 set(MODULE_HEADERS
     ${INCLUDE_DIR}/texture.hpp
+    ${INCLUDE_DIR}/texture_manager.hpp
+    ${INCLUDE_DIR}/frame_arena.hpp
+    ${INCLUDE_DIR}/memory_tracker.hpp
+    ${INCLUDE_DIR}/trigram_index.hpp
+    ${INCLUDE_DIR}/localization_packs.hpp
+    ${INCLUDE_DIR}/mapped_file.hpp
+    ${INCLUDE_DIR}/preset_store.hpp
+    ${INCLUDE_DIR}/text_fit_analyzer.hpp
+    ${INCLUDE_DIR}/font_loader.hpp
+    ${INCLUDE_DIR}/utf8.hpp
+    ${INCLUDE_DIR}/task_scheduler.hpp
+    ${INCLUDE_DIR}/spsc_ring.hpp
+    ${INCLUDE_DIR}/latency_tracker.hpp
+    ${INCLUDE_DIR}/trace.hpp
+    ${INCLUDE_DIR}/frame_skip.hpp
     ${INCLUDE_DIR}/icon.hpp
     ${INCLUDE_DIR}/find_game.hpp
     ${INCLUDE_DIR}/input_system.hpp
+    ${INCLUDE_DIR}/input_recording.hpp
     ${INCLUDE_DIR}/file_manager.hpp
+    ${INCLUDE_DIR}/decor_collection.hpp
+    ${INCLUDE_DIR}/decor_importer.hpp
+    ${INCLUDE_DIR}/decor_hash_index.hpp
+    ${INCLUDE_DIR}/content_hash.hpp
+    ${INCLUDE_DIR}/png_optimizer.hpp
+    ${INCLUDE_DIR}/png_stream.hpp
+    ${INCLUDE_DIR}/storage_backend.hpp
+    ${INCLUDE_DIR}/steam_status.hpp
+    ${INCLUDE_DIR}/jni_bridge.hpp
 )
 
 add_library(
@@ -44,3 +92,10 @@ if (NOT ANDROID)
     target_link_libraries(${MODULE_TARGET} PUBLIC steam_api)
 endif()
 
+if (SENSE_MEMORY_TRACKING)
+    target_compile_definitions(${MODULE_TARGET} PUBLIC SENSE_MEMORY_TRACKING)
+endif()
+
+if (SENSE_TRACING)
+    target_compile_definitions(${MODULE_TARGET} PUBLIC SENSE_TRACING)
+endif()
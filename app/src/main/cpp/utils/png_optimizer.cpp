@@ -0,0 +1,146 @@
+#include <utils/png_optimizer.hpp>
+#include <SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    constexpr unsigned char s_signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    uint32_t readBE32(const unsigned char* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    // Upper bound for IMG_SavePNG output: stored deflate blocks plus a filter
+    // byte per row, with room for the chunk headers.
+    std::size_t encodeBound(int width, int height) {
+        const std::size_t raw = (static_cast<std::size_t>(width) * 4 + 1) * static_cast<std::size_t>(height);
+        return raw + (raw / 16383 + 1) * 5 + 1024;
+    }
+}
+
+namespace PngOptimizer {
+
+bool readPngInfo(const void* data, std::size_t size, PngInfo& info) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    if (size < sizeof(s_signature) + 25 || std::memcmp(p, s_signature, sizeof(s_signature)) != 0) {
+        return false;
+    }
+
+    std::size_t offset = sizeof(s_signature);
+    bool sawHeader = false;
+    info = PngInfo();
+
+    while (offset + 12 <= size) {
+        const uint32_t length = readBE32(p + offset);
+        const unsigned char* type = p + offset + 4;
+        const std::size_t chunkSize = static_cast<std::size_t>(length) + 12;
+        if (length > size || offset + chunkSize > size) {
+            return false;
+        }
+
+        if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+            const unsigned char* body = type + 4;
+            info.width = readBE32(body);
+            info.height = readBE32(body + 4);
+            info.bitDepth = body[8];
+            info.colorType = body[9];
+            info.interlace = body[12];
+            sawHeader = true;
+        }
+        else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        else if (type[0] & 0x20) {
+            // Lower-case first letter = ancillary chunk
+            info.ancillaryBytes += chunkSize;
+        }
+
+        offset += chunkSize;
+    }
+
+    return sawHeader && info.width > 0 && info.height > 0;
+}
+
+void fitWithin(int width, int height, int maxDimension, int& outWidth, int& outHeight) {
+    outWidth = width;
+    outHeight = height;
+
+    const int longest = std::max(width, height);
+    if (maxDimension <= 0 || longest <= maxDimension) {
+        return;
+    }
+
+    const double scale = static_cast<double>(maxDimension) / longest;
+    outWidth = std::max(1, static_cast<int>(width * scale + 0.5));
+    outHeight = std::max(1, static_cast<int>(height * scale + 0.5));
+}
+
+bool optimize(SDL_Surface* decoded, const PngInfo& info, std::size_t sourceSize,
+              const Options& options, Result& result)
+{
+    result = Result();
+    if (!decoded) {
+        return false;
+    }
+
+    // `decoded` may already be a reduced preview of a larger source
+    int width = 0;
+    int height = 0;
+    fitWithin(decoded->w, decoded->h, options.maxDimension, width, height);
+    const bool downscale = static_cast<uint32_t>(width) != info.width || static_cast<uint32_t>(height) != info.height;
+    const bool stretch = width != decoded->w || height != decoded->h;
+
+    // Nothing to strip or shrink: re-encoding would only cost time
+    if (!downscale && info.ancillaryBytes == 0) {
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_ConvertSurfaceFormat failed: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_Surface* output = rgba;
+    if (stretch) {
+        output = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!output || SDL_SoftStretchLinear(rgba, nullptr, output, nullptr) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Downscale to %dx%d failed: %s", width, height, SDL_GetError());
+            if (output) SDL_FreeSurface(output);
+            SDL_FreeSurface(rgba);
+            return false;
+        }
+        SDL_FreeSurface(rgba);
+    }
+
+    std::string encoded(encodeBound(output->w, output->h), '\0');
+    SDL_RWops* rw = SDL_RWFromMem(encoded.data(), static_cast<int>(encoded.size()));
+    const bool saved = rw && IMG_SavePNG_RW(output, rw, 0) == 0;
+    const Sint64 written = rw ? SDL_RWtell(rw) : -1;
+    if (rw) SDL_RWclose(rw);
+
+    result.width = output->w;
+    result.height = output->h;
+    SDL_FreeSurface(output);
+
+    if (!saved || written <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "IMG_SavePNG_RW failed: %s", IMG_GetError());
+        return false;
+    }
+    encoded.resize(static_cast<std::size_t>(written));
+
+    result.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Same pixels but a bigger file (the source was already well compressed)
+    if (!downscale && encoded.size() >= sourceSize) {
+        return false;
+    }
+
+    result.bytes = std::move(encoded);
+    return true;
+}
+
+} // namespace PngOptimizer
@@ -0,0 +1,792 @@
+#include <utils/png_stream.hpp>
+#include <utils/png_optimizer.hpp>
+#include <utils/trace.hpp>
+#include <SDL_image.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+    uint32_t readBE32(const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    // ---------- IDAT byte source ----------
+
+    // Hands out the payload of consecutive IDAT chunks as one byte stream.
+    class IdatReader {
+    public:
+        IdatReader(const uint8_t* data, std::size_t size, std::size_t firstChunk) :
+            m_data(data), m_size(size), m_next(firstChunk) {}
+
+        bool next(uint8_t& byte) {
+            while (m_remaining == 0) {
+                if (m_next + 12 > m_size) return false;
+                const uint32_t length = readBE32(m_data + m_next);
+                if (std::memcmp(m_data + m_next + 4, "IDAT", 4) != 0) return false;
+                if (length > m_size - m_next - 12) return false;
+
+                m_cursor = m_data + m_next + 8;
+                m_remaining = length;
+                m_next += static_cast<std::size_t>(length) + 12;
+            }
+            byte = *m_cursor++;
+            --m_remaining;
+            return true;
+        }
+
+    private:
+        const uint8_t* m_data;
+        std::size_t m_size;
+        std::size_t m_next;
+        const uint8_t* m_cursor = nullptr;
+        std::size_t m_remaining = 0;
+    };
+
+    // ---------- Box downsampler ----------
+
+    // Accumulates premultiplied RGBA per output pixel. Rows arrive in order
+    // for plain images, so one row of accumulators is enough; Adam7 passes
+    // revisit every output row, so those keep the whole (preview-sized) grid.
+    class BoxDownsampler {
+    public:
+        BoxDownsampler(uint32_t srcWidth, uint32_t srcHeight, SDL_Surface* out, bool wholeGrid) :
+            m_out(out), m_wholeGrid(wholeGrid),
+            m_xMap(srcWidth), m_xCount(out->w, 0), m_yMap(srcHeight), m_yCount(out->h, 0),
+            m_acc(static_cast<std::size_t>(out->w) * (wholeGrid ? out->h : 1) * 4, 0)
+        {
+            for (uint32_t x = 0; x < srcWidth; ++x) {
+                m_xMap[x] = static_cast<uint32_t>(uint64_t(x) * out->w / srcWidth);
+                ++m_xCount[m_xMap[x]];
+            }
+            for (uint32_t y = 0; y < srcHeight; ++y) {
+                m_yMap[y] = static_cast<uint32_t>(uint64_t(y) * out->h / srcHeight);
+                ++m_yCount[m_yMap[y]];
+            }
+        }
+
+        // `rgba` holds `count` pixels that sit at x0, x0 + dx, ... of source row y.
+        void addRow(uint32_t y, const uint8_t* rgba, uint32_t x0, uint32_t dx, uint32_t count) {
+            const uint32_t outY = m_yMap[y];
+            if (!m_wholeGrid && outY != m_rowY) {
+                flushRow(m_rowY, m_acc.data());
+                std::fill(m_acc.begin(), m_acc.end(), 0);
+                m_rowY = outY;
+            }
+
+            uint32_t* row = m_acc.data() + (m_wholeGrid ? static_cast<std::size_t>(outY) * m_out->w * 4 : 0);
+            for (uint32_t i = 0, x = x0; i < count; ++i, x += dx, rgba += 4) {
+                const uint32_t a = rgba[3];
+                uint32_t* acc = row + static_cast<std::size_t>(m_xMap[x]) * 4;
+                acc[0] += (rgba[0] * a + 127) / 255;
+                acc[1] += (rgba[1] * a + 127) / 255;
+                acc[2] += (rgba[2] * a + 127) / 255;
+                acc[3] += a;
+            }
+        }
+
+        void finish() {
+            if (m_wholeGrid) {
+                for (int y = 0; y < m_out->h; ++y) {
+                    flushRow(static_cast<uint32_t>(y), m_acc.data() + static_cast<std::size_t>(y) * m_out->w * 4);
+                }
+            } else {
+                flushRow(m_rowY, m_acc.data());
+            }
+        }
+
+    private:
+        void flushRow(uint32_t outY, const uint32_t* acc) {
+            uint8_t* dst = static_cast<uint8_t*>(m_out->pixels) + static_cast<std::size_t>(outY) * m_out->pitch;
+            for (int x = 0; x < m_out->w; ++x, acc += 4, dst += 4) {
+                const uint64_t samples = uint64_t(m_xCount[x]) * m_yCount[outY];
+                const uint32_t alpha = acc[3];
+                if (samples == 0 || alpha == 0) {
+                    std::memset(dst, 0, 4);
+                    continue;
+                }
+                // Back to straight alpha: colour = sum(c * a) / sum(a)
+                for (int c = 0; c < 3; ++c) {
+                    dst[c] = static_cast<uint8_t>(std::min<uint64_t>(255, (uint64_t(acc[c]) * 255 + alpha / 2) / alpha));
+                }
+                dst[3] = static_cast<uint8_t>((alpha + samples / 2) / samples);
+            }
+        }
+
+        SDL_Surface* m_out;
+        const bool m_wholeGrid;
+        std::vector<uint32_t> m_xMap;
+        std::vector<uint32_t> m_xCount;
+        std::vector<uint32_t> m_yMap;
+        std::vector<uint32_t> m_yCount;
+        std::vector<uint32_t> m_acc;
+        uint32_t m_rowY = 0;
+    };
+
+    // ---------- Scanline assembler ----------
+
+    struct Header {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t bitDepth = 0;
+        uint8_t colorType = 0;
+        bool interlaced = false;
+        std::array<uint8_t, 256 * 4> palette{};   // RGBA, alpha from tRNS
+        bool hasColorKey = false;
+        uint16_t colorKey[3] = {};                // Gray or RGB sample marked transparent by tRNS
+    };
+
+    constexpr uint32_t s_adam7X[7]  = { 0, 4, 0, 2, 0, 1, 0 };
+    constexpr uint32_t s_adam7Y[7]  = { 0, 0, 4, 0, 2, 0, 1 };
+    constexpr uint32_t s_adam7DX[7] = { 8, 8, 4, 4, 2, 2, 1 };
+    constexpr uint32_t s_adam7DY[7] = { 8, 8, 8, 4, 4, 2, 2 };
+
+    // Receives inflated bytes, cuts them into scanlines, undoes the filters
+    // and converts each row to RGBA8 for the downsampler.
+    class ScanlineSink {
+    public:
+        ScanlineSink(const Header& header, BoxDownsampler& downsampler) :
+            m_header(header), m_downsampler(downsampler)
+        {
+            const uint32_t channels = channelCount(header.colorType);
+            m_bitsPerPixel = channels * header.bitDepth;
+            m_filterStride = std::max<uint32_t>(1, m_bitsPerPixel / 8);
+
+            const std::size_t maxRowBytes = (static_cast<std::size_t>(header.width) * m_bitsPerPixel + 7) / 8;
+            m_current.resize(maxRowBytes + 1);
+            m_previous.resize(maxRowBytes + 1);
+            m_rgba.resize(static_cast<std::size_t>(header.width) * 4);
+
+            m_pass = header.interlaced ? 0 : 6;
+            startPass();
+        }
+
+        // Returns false on a corrupt row; further data after the last row is ignored.
+        bool write(const uint8_t* data, std::size_t size) {
+            while (size > 0 && !done()) {
+                const std::size_t take = std::min(size, m_rowSize - m_filled);
+                std::memcpy(m_current.data() + m_filled, data, take);
+                m_filled += take;
+                data += take;
+                size -= take;
+
+                if (m_filled == m_rowSize) {
+                    if (!processRow()) return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool done() const { return m_pass >= 7; }
+
+        static uint32_t channelCount(uint8_t colorType) {
+            switch (colorType) {
+                case 0: return 1;
+                case 2: return 3;
+                case 3: return 1;
+                case 4: return 2;
+                case 6: return 4;
+                default: return 0;
+            }
+        }
+
+    private:
+        void startPass() {
+            const Header& h = m_header;
+            for (; m_pass < 7; ++m_pass) {
+                const uint32_t x0 = h.interlaced ? s_adam7X[m_pass] : 0;
+                const uint32_t y0 = h.interlaced ? s_adam7Y[m_pass] : 0;
+                const uint32_t dx = h.interlaced ? s_adam7DX[m_pass] : 1;
+                const uint32_t dy = h.interlaced ? s_adam7DY[m_pass] : 1;
+                m_passWidth = h.width > x0 ? (h.width - x0 + dx - 1) / dx : 0;
+                m_passHeight = h.height > y0 ? (h.height - y0 + dy - 1) / dy : 0;
+                if (m_passWidth > 0 && m_passHeight > 0) break; // Empty passes have no filter bytes
+            }
+            if (m_pass >= 7) return;
+
+            m_row = 0;
+            m_filled = 0;
+            m_rowSize = (static_cast<std::size_t>(m_passWidth) * m_bitsPerPixel + 7) / 8 + 1;
+            std::fill(m_previous.begin(), m_previous.begin() + m_rowSize, 0);
+        }
+
+        bool processRow() {
+            if (!unfilter()) return false;
+            convertRow();
+
+            const bool interlaced = m_header.interlaced;
+            const uint32_t y = (interlaced ? s_adam7Y[m_pass] : 0) + m_row * (interlaced ? s_adam7DY[m_pass] : 1);
+            m_downsampler.addRow(y, m_rgba.data(),
+                interlaced ? s_adam7X[m_pass] : 0, interlaced ? s_adam7DX[m_pass] : 1, m_passWidth);
+
+            std::swap(m_current, m_previous);
+            m_filled = 0;
+            if (++m_row == m_passHeight) {
+                ++m_pass;
+                startPass();
+            }
+            return true;
+        }
+
+        bool unfilter() {
+            uint8_t* row = m_current.data() + 1;
+            const uint8_t* prior = m_previous.data() + 1;
+            const std::size_t length = m_rowSize - 1;
+            const std::size_t bpp = m_filterStride;
+
+            switch (m_current[0]) {
+                case 0:
+                    break;
+                case 1:
+                    for (std::size_t i = bpp; i < length; ++i) row[i] += row[i - bpp];
+                    break;
+                case 2:
+                    for (std::size_t i = 0; i < length; ++i) row[i] += prior[i];
+                    break;
+                case 3:
+                    for (std::size_t i = 0; i < length; ++i) {
+                        const unsigned left = i >= bpp ? row[i - bpp] : 0;
+                        row[i] += static_cast<uint8_t>((left + prior[i]) >> 1);
+                    }
+                    break;
+                case 4:
+                    for (std::size_t i = 0; i < length; ++i) {
+                        const int a = i >= bpp ? row[i - bpp] : 0;
+                        const int b = prior[i];
+                        const int c = i >= bpp ? prior[i - bpp] : 0;
+                        const int p = a + b - c;
+                        const int pa = std::abs(p - a);
+                        const int pb = std::abs(p - b);
+                        const int pc = std::abs(p - c);
+                        row[i] += static_cast<uint8_t>((pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c));
+                    }
+                    break;
+                default:
+                    SDL_SetError("PNG row uses unknown filter %d", m_current[0]);
+                    return false;
+            }
+            return true;
+        }
+
+        uint16_t sample(const uint8_t* row, uint32_t index) const {
+            const uint8_t depth = m_header.bitDepth;
+            if (depth == 16) return static_cast<uint16_t>((row[index * 2] << 8) | row[index * 2 + 1]);
+            if (depth == 8) return row[index];
+
+            const uint32_t bit = index * depth;
+            const uint32_t shift = 8 - depth - (bit & 7);
+            return static_cast<uint16_t>((row[bit >> 3] >> shift) & ((1u << depth) - 1));
+        }
+
+        uint8_t to8(uint16_t value) const {
+            switch (m_header.bitDepth) {
+                case 1: return value ? 255 : 0;
+                case 2: return static_cast<uint8_t>(value * 85);
+                case 4: return static_cast<uint8_t>(value * 17);
+                case 16: return static_cast<uint8_t>(value >> 8);
+                default: return static_cast<uint8_t>(value);
+            }
+        }
+
+        void convertRow() {
+            const Header& h = m_header;
+            const uint8_t* row = m_current.data() + 1;
+            uint8_t* out = m_rgba.data();
+
+            for (uint32_t x = 0; x < m_passWidth; ++x, out += 4) {
+                switch (h.colorType) {
+                    case 0: {
+                        const uint16_t g = sample(row, x);
+                        out[0] = out[1] = out[2] = to8(g);
+                        out[3] = (h.hasColorKey && g == h.colorKey[0]) ? 0 : 255;
+                        break;
+                    }
+                    case 2: {
+                        const uint16_t r = sample(row, x * 3);
+                        const uint16_t g = sample(row, x * 3 + 1);
+                        const uint16_t b = sample(row, x * 3 + 2);
+                        out[0] = to8(r);
+                        out[1] = to8(g);
+                        out[2] = to8(b);
+                        out[3] = (h.hasColorKey && r == h.colorKey[0] && g == h.colorKey[1] && b == h.colorKey[2]) ? 0 : 255;
+                        break;
+                    }
+                    case 3:
+                        std::memcpy(out, &h.palette[static_cast<std::size_t>(sample(row, x)) * 4], 4);
+                        break;
+                    case 4:
+                        out[0] = out[1] = out[2] = to8(sample(row, x * 2));
+                        out[3] = to8(sample(row, x * 2 + 1));
+                        break;
+                    case 6:
+                        for (uint32_t c = 0; c < 4; ++c) out[c] = to8(sample(row, x * 4 + c));
+                        break;
+                }
+            }
+        }
+
+        const Header& m_header;
+        BoxDownsampler& m_downsampler;
+        uint32_t m_bitsPerPixel = 0;
+        uint32_t m_filterStride = 1;
+
+        std::vector<uint8_t> m_current;
+        std::vector<uint8_t> m_previous;
+        std::vector<uint8_t> m_rgba;
+
+        uint32_t m_pass = 0;
+        uint32_t m_passWidth = 0;
+        uint32_t m_passHeight = 0;
+        uint32_t m_row = 0;
+        std::size_t m_rowSize = 0;
+        std::size_t m_filled = 0;
+    };
+
+    // ---------- Inflate (RFC 1950/1951) ----------
+
+    struct Huffman {
+        static constexpr int FastBits = 10;
+
+        uint16_t count[16] = {};
+        std::array<uint16_t, 288> symbol{};
+        std::array<uint16_t, 1 << FastBits> fast{}; // symbol << 4 | length, 0 = use the slow path
+
+        bool build(const uint8_t* lengths, int n) {
+            std::fill(std::begin(count), std::end(count), 0);
+            for (int i = 0; i < n; ++i) ++count[lengths[i]];
+            count[0] = 0;
+
+            uint16_t offsets[16] = {};
+            int left = 1;
+            for (int len = 1; len < 16; ++len) {
+                left = (left << 1) - count[len];
+                if (left < 0) return false; // Over-subscribed
+                offsets[len] = static_cast<uint16_t>(len > 1 ? offsets[len - 1] + count[len - 1] : 0);
+            }
+            for (int i = 0; i < n; ++i) {
+                if (lengths[i]) symbol[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+            }
+
+            // Canonical codes, bit-reversed because deflate packs them MSB first
+            fast.fill(0);
+            uint32_t code = 0;
+            int index = 0;
+            for (int len = 1; len <= FastBits; ++len) {
+                for (int k = 0; k < count[len]; ++k, ++code, ++index) {
+                    uint32_t reversed = 0;
+                    for (int b = 0; b < len; ++b) reversed |= ((code >> b) & 1u) << (len - 1 - b);
+                    for (uint32_t fill = reversed; fill < fast.size(); fill += 1u << len) {
+                        fast[fill] = static_cast<uint16_t>((symbol[index] << 4) | len);
+                    }
+                }
+                code <<= 1;
+            }
+            return true;
+        }
+    };
+
+    constexpr uint16_t s_lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint8_t s_lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint16_t s_distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint8_t s_distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    constexpr uint8_t s_codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    // Pull-based inflater. Output goes through a 64 KiB buffer that keeps the
+    // last 32 KiB for back-references and hands the rest to the sink.
+    class Inflater {
+    public:
+        Inflater(IdatReader& input, ScanlineSink& sink) : m_input(input), m_sink(sink) {}
+
+        bool run() {
+            const int cmf = static_cast<int>(bits(8));
+            const int flg = static_cast<int>(bits(8));
+            if (m_overrun || (cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+                SDL_SetError("PNG image data is not a zlib stream");
+                return false;
+            }
+
+            bool last = false;
+            while (!last && !m_sink.done()) {
+                last = bits(1) != 0;
+                const uint32_t type = bits(2);
+                bool ok = false;
+                switch (type) {
+                    case 0: ok = stored(); break;
+                    case 1: ok = fixed(); break;
+                    case 2: ok = dynamic(); break;
+                    default: SDL_SetError("PNG image data has an invalid deflate block"); break;
+                }
+                if (!ok) return false;
+            }
+            return flush();
+        }
+
+    private:
+        static constexpr std::size_t s_windowSize = 32768;
+
+        void refill() {
+            uint8_t byte;
+            while (m_bitCount <= 56) {
+                if (!m_input.next(byte)) {
+                    m_exhausted = true;
+                    return;
+                }
+                m_bitBuffer |= uint64_t(byte) << m_bitCount;
+                m_bitCount += 8;
+            }
+        }
+
+        uint32_t bits(int count) {
+            if (m_bitCount < count) {
+                refill();
+                if (m_bitCount < count) {
+                    m_overrun = true;
+                    return 0;
+                }
+            }
+            const uint32_t value = static_cast<uint32_t>(m_bitBuffer & ((uint64_t(1) << count) - 1));
+            m_bitBuffer >>= count;
+            m_bitCount -= count;
+            return value;
+        }
+
+        int decode(const Huffman& h) {
+            if (m_bitCount < Huffman::FastBits && !m_exhausted) refill();
+
+            const uint16_t entry = h.fast[m_bitBuffer & ((1u << Huffman::FastBits) - 1)];
+            const int length = entry & 15;
+            if (length != 0 && length <= m_bitCount) {
+                m_bitBuffer >>= length;
+                m_bitCount -= length;
+                return entry >> 4;
+            }
+
+            // Long code: walk the canonical table a bit at a time
+            int code = 0, first = 0, index = 0;
+            for (int len = 1; len < 16; ++len) {
+                code |= static_cast<int>(bits(1));
+                if (m_overrun) return -1;
+                const int count = h.count[len];
+                if (code - count < first) return h.symbol[index + (code - first)];
+                index += count;
+                first += count;
+                first <<= 1;
+                code <<= 1;
+            }
+            return -1;
+        }
+
+        bool put(uint8_t byte) {
+            m_window[m_pos++] = byte;
+            if (m_pos == m_window.size()) {
+                if (!flush()) return false;
+                std::memmove(m_window.data(), m_window.data() + s_windowSize, s_windowSize);
+                m_pos = s_windowSize;
+                m_flushed = s_windowSize;
+            }
+            return true;
+        }
+
+        bool flush() {
+            const bool ok = m_sink.write(m_window.data() + m_flushed, m_pos - m_flushed);
+            m_flushed = m_pos;
+            return ok;
+        }
+
+        bool stored() {
+            m_bitBuffer >>= m_bitCount & 7;
+            m_bitCount -= m_bitCount & 7;
+
+            const uint32_t length = bits(16);
+            const uint32_t inverse = bits(16);
+            if (m_overrun || (length ^ 0xFFFF) != inverse) {
+                return corrupt("PNG image data has a corrupt stored block");
+            }
+            for (uint32_t i = 0; i < length; ++i) {
+                const uint8_t byte = static_cast<uint8_t>(bits(8));
+                if (m_overrun) break;
+                if (!put(byte)) return false;
+            }
+            return !m_overrun || corrupt("PNG image data is truncated");
+        }
+
+        bool fixed() {
+            if (!m_fixedReady) {
+                uint8_t lengths[288 + 30];
+                std::fill(lengths, lengths + 144, 8);
+                std::fill(lengths + 144, lengths + 256, 9);
+                std::fill(lengths + 256, lengths + 280, 7);
+                std::fill(lengths + 280, lengths + 288, 8);
+                std::fill(lengths + 288, lengths + 318, 5);
+                m_fixedLength.build(lengths, 288);
+                m_fixedDistance.build(lengths + 288, 30);
+                m_fixedReady = true;
+            }
+            return codes(m_fixedLength, m_fixedDistance);
+        }
+
+        bool dynamic() {
+            const int nlen = static_cast<int>(bits(5)) + 257;
+            const int ndist = static_cast<int>(bits(5)) + 1;
+            const int ncode = static_cast<int>(bits(4)) + 4;
+            if (m_overrun || nlen > 286 || ndist > 30) {
+                SDL_SetError("PNG image data has a corrupt dynamic block");
+                return false;
+            }
+
+            uint8_t lengths[288 + 32] = {};
+            for (int i = 0; i < ncode; ++i) lengths[s_codeLengthOrder[i]] = static_cast<uint8_t>(bits(3));
+            Huffman codeLengths;
+            if (!codeLengths.build(lengths, 19)) {
+                SDL_SetError("PNG image data has a corrupt code length table");
+                return false;
+            }
+
+            std::fill(std::begin(lengths), std::end(lengths), 0);
+            int index = 0;
+            while (index < nlen + ndist) {
+                const int symbol = decode(codeLengths);
+                if (symbol < 0 || m_overrun) {
+                    return corrupt("PNG image data has a corrupt code length");
+                }
+
+                if (symbol < 16) {
+                    lengths[index++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+
+                uint8_t value = 0;
+                int repeat = 0;
+                if (symbol == 16) {
+                    if (index == 0) {
+                        return corrupt("PNG image data repeats a missing length");
+                    }
+                    value = lengths[index - 1];
+                    repeat = 3 + static_cast<int>(bits(2));
+                } else if (symbol == 17) {
+                    repeat = 3 + static_cast<int>(bits(3));
+                } else {
+                    repeat = 11 + static_cast<int>(bits(7));
+                }
+                if (index + repeat > nlen + ndist) {
+                    SDL_SetError("PNG image data has too many code lengths");
+                    return false;
+                }
+                while (repeat--) lengths[index++] = value;
+            }
+
+            Huffman lengthCodes;
+            Huffman distanceCodes;
+            if (lengths[256] == 0 || !lengthCodes.build(lengths, nlen) || !distanceCodes.build(lengths + nlen, ndist)) {
+                SDL_SetError("PNG image data has a corrupt Huffman table");
+                return false;
+            }
+            return codes(lengthCodes, distanceCodes);
+        }
+
+        bool codes(const Huffman& lengthCodes, const Huffman& distanceCodes) {
+            for (;;) {
+                int symbol = decode(lengthCodes);
+                if (symbol < 0 || m_overrun) {
+                    return corrupt("PNG image data has an invalid literal/length code");
+                }
+
+                if (symbol < 256) {
+                    if (!put(static_cast<uint8_t>(symbol))) return false;
+                    continue;
+                }
+                if (symbol == 256) return true;
+
+                symbol -= 257;
+                if (symbol >= 29) {
+                    return corrupt("PNG image data has an invalid length code");
+                }
+                const uint32_t length = s_lengthBase[symbol] + bits(s_lengthExtra[symbol]);
+
+                const int distSymbol = decode(distanceCodes);
+                if (distSymbol < 0 || distSymbol >= 30) {
+                    return corrupt("PNG image data has an invalid distance code");
+                }
+                const std::size_t distance = s_distBase[distSymbol] + bits(s_distExtra[distSymbol]);
+                if (m_overrun || distance > m_pos) {
+                    return corrupt("PNG image data has an invalid distance");
+                }
+
+                for (uint32_t i = 0; i < length; ++i) {
+                    if (!put(m_window[m_pos - distance])) return false;
+                }
+                if (m_sink.done()) return true;
+            }
+        }
+
+        // Sets the SDL error, naming truncation when the input ran out first
+        bool corrupt(const char* message) {
+            SDL_SetError("%s", m_overrun ? "PNG image data is truncated" : message);
+            return false;
+        }
+
+        IdatReader& m_input;
+        ScanlineSink& m_sink;
+
+        uint64_t m_bitBuffer = 0;
+        int m_bitCount = 0;
+        bool m_exhausted = false;
+        bool m_overrun = false;
+
+        std::array<uint8_t, s_windowSize * 2> m_window{};
+        std::size_t m_pos = 0;
+        std::size_t m_flushed = 0;
+
+        bool m_fixedReady = false;
+        Huffman m_fixedLength;
+        Huffman m_fixedDistance;
+    };
+
+    bool validFormat(uint8_t colorType, uint8_t bitDepth) {
+        switch (colorType) {
+            case 0: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+            case 3: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+            case 2: case 4: case 6: return bitDepth == 8 || bitDepth == 16;
+            default: return false;
+        }
+    }
+
+    // Reads IHDR, PLTE and tRNS. Returns the offset of the first IDAT chunk, or 0.
+    std::size_t readHeader(const uint8_t* data, std::size_t size, Header& header) {
+        PngOptimizer::PngInfo info;
+        if (!PngOptimizer::readPngInfo(data, size, info)) {
+            SDL_SetError("Not a PNG file");
+            return 0;
+        }
+        header.width = info.width;
+        header.height = info.height;
+        header.bitDepth = info.bitDepth;
+        header.colorType = info.colorType;
+        header.interlaced = info.interlace == 1;
+        if (!validFormat(header.colorType, header.bitDepth) || info.interlace > 1) {
+            SDL_SetError("Unsupported PNG format (color type %d, depth %d)", header.colorType, header.bitDepth);
+            return 0;
+        }
+        if (header.width > PngStream::s_maxSide || header.height > PngStream::s_maxSide) {
+            SDL_SetError("PNG is too large (%ux%u)", header.width, header.height);
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < 256; ++i) header.palette[i * 4 + 3] = 255;
+
+        std::size_t offset = 8;
+        while (offset + 12 <= size) {
+            const uint32_t length = readBE32(data + offset);
+            const uint8_t* type = data + offset + 4;
+            const uint8_t* body = type + 4;
+
+            if (std::memcmp(type, "IDAT", 4) == 0) {
+                return offset;
+            }
+            if (std::memcmp(type, "PLTE", 4) == 0) {
+                for (uint32_t i = 0; i < std::min<uint32_t>(length / 3, 256); ++i) {
+                    std::memcpy(&header.palette[i * 4], body + i * 3, 3);
+                }
+            }
+            else if (std::memcmp(type, "tRNS", 4) == 0) {
+                if (header.colorType == 3) {
+                    for (uint32_t i = 0; i < std::min<uint32_t>(length, 256); ++i) header.palette[i * 4 + 3] = body[i];
+                } else if (header.colorType == 0 && length >= 2) {
+                    header.colorKey[0] = static_cast<uint16_t>((body[0] << 8) | body[1]);
+                    header.hasColorKey = true;
+                } else if (header.colorType == 2 && length >= 6) {
+                    for (int c = 0; c < 3; ++c) header.colorKey[c] = static_cast<uint16_t>((body[c * 2] << 8) | body[c * 2 + 1]);
+                    header.hasColorKey = true;
+                }
+            }
+            offset += static_cast<std::size_t>(length) + 12; // readPngInfo already bounds-checked the chunks
+        }
+
+        SDL_SetError("PNG file has no image data");
+        return 0;
+    }
+
+    void fitWithin(uint32_t width, uint32_t height, int maxWidth, int maxHeight, int& outWidth, int& outHeight) {
+        const double scale = std::min({ 1.0, double(maxWidth) / width, double(maxHeight) / height });
+        outWidth = std::max(1, static_cast<int>(width * scale + 0.5));
+        outHeight = std::max(1, static_cast<int>(height * scale + 0.5));
+    }
+}
+
+namespace PngStream {
+
+bool previewSize(const void* data, std::size_t size, int maxWidth, int maxHeight, int& width, int& height) {
+    PngOptimizer::PngInfo info;
+    if (!PngOptimizer::readPngInfo(data, size, info) || maxWidth <= 0 || maxHeight <= 0) {
+        SDL_SetError("Not a PNG file");
+        return false;
+    }
+    if (info.width > s_maxSide || info.height > s_maxSide) {
+        SDL_SetError("PNG is too large (%ux%u)", info.width, info.height);
+        return false;
+    }
+    fitWithin(info.width, info.height, maxWidth, maxHeight, width, height);
+    return true;
+}
+
+bool decodeInto(const void* data, std::size_t size, SDL_Surface* target) {
+    TRACE_ZONE("PNG decode (streamed)");
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    Header header;
+    const std::size_t firstIdat = readHeader(bytes, size, header);
+    if (firstIdat == 0) {
+        return false;
+    }
+
+    BoxDownsampler downsampler(header.width, header.height, target, header.interlaced);
+    ScanlineSink sink(header, downsampler);
+    IdatReader input(bytes, size, firstIdat);
+    Inflater inflater(input, sink);
+
+    const bool inflated = inflater.run();
+    if (!inflated || !sink.done()) {
+        if (inflated) SDL_SetError("PNG image data ended early");
+        return false;
+    }
+
+    downsampler.finish();
+    SDL_Log("Streamed %ux%u PNG into a %dx%d preview", header.width, header.height, target->w, target->h);
+    return true;
+}
+
+SDL_Surface* loadDownsampled(const void* data, std::size_t size, int maxWidth, int maxHeight) {
+    int width = 0;
+    int height = 0;
+    if (!previewSize(data, size, maxWidth, maxHeight, width, height)) {
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface && !decodeInto(data, size, surface)) {
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    return surface;
+}
+
+SDL_Surface* loadPreview(const void* data, std::size_t size, int maxWidth, int maxHeight) {
+    PngOptimizer::PngInfo info;
+    const bool isPng = PngOptimizer::readPngInfo(data, size, info);
+
+    if (isPng && (info.width > static_cast<uint32_t>(maxWidth) || info.height > static_cast<uint32_t>(maxHeight))) {
+        return loadDownsampled(data, size, maxWidth, maxHeight);
+    }
+
+    TRACE_ZONE("PNG decode");
+    SDL_RWops* rw = SDL_RWFromConstMem(data, static_cast<int>(size));
+    return rw ? IMG_Load_RW(rw, 1) : nullptr;
+}
+
+} // namespace PngStream
@@ -0,0 +1,451 @@
+#include <utils/preset_store.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/content_hash.hpp>
+#include <utils/decor_collection.hpp>
+#include <utils/decor_importer.hpp>
+#include <utils/memory_tracker.hpp>
+#include <assets/data.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    // Header: magic, format version, ContentHash of the payload
+    constexpr char s_magic[4] = { 'S', 'N', 'P', 'S' };
+    constexpr uint32_t s_version = 1;
+    constexpr std::size_t s_headerSize = 16;
+    constexpr const char* s_extension = ".preset";
+    constexpr const char* s_decorDir = "decor";
+
+    // Little-endian records; strings are a 32-bit length and the bytes
+    class PresetWriter {
+    public:
+        void u8(uint8_t value) { m_bytes.push_back(static_cast<char>(value)); }
+
+        void u32(uint32_t value) {
+            for (int shift = 0; shift < 32; shift += 8) u8(static_cast<uint8_t>(value >> shift));
+        }
+
+        void u64(uint64_t value) {
+            for (int shift = 0; shift < 64; shift += 8) u8(static_cast<uint8_t>(value >> shift));
+        }
+
+        void string(std::string_view text) {
+            u32(static_cast<uint32_t>(text.size()));
+            m_bytes.append(text.data(), text.size());
+        }
+
+        [[nodiscard]] std::string& bytes() { return m_bytes; }
+
+    private:
+        std::string m_bytes;
+    };
+
+    // Reads records in place. Past the end every read yields 0 and ok() turns false.
+    class PresetReader {
+    public:
+        PresetReader(const unsigned char* data, std::size_t size) : m_pos(data), m_end(data + size) {}
+
+        uint8_t u8() {
+            if (!have(1)) return 0;
+            return *m_pos++;
+        }
+
+        uint32_t u32() {
+            if (!have(4)) return 0;
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(m_pos[i]) << (8 * i);
+            m_pos += 4;
+            return value;
+        }
+
+        uint64_t u64() {
+            if (!have(8)) return 0;
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(m_pos[i]) << (8 * i);
+            m_pos += 8;
+            return value;
+        }
+
+        // Points into the mapped file
+        std::string_view string() {
+            const uint32_t length = u32();
+            if (!have(length)) return {};
+            const std::string_view text(reinterpret_cast<const char*>(m_pos), length);
+            m_pos += length;
+            return text;
+        }
+
+        // A count of records at least `minRecordSize` bytes each, checked against what is left
+        uint32_t count(std::size_t minRecordSize) {
+            const uint32_t value = u32();
+            if (static_cast<std::size_t>(m_end - m_pos) / minRecordSize < value) {
+                m_ok = false;
+                return 0;
+            }
+            return value;
+        }
+
+        [[nodiscard]] bool ok() const { return m_ok; }
+
+    private:
+        bool have(std::size_t bytes) {
+            if (!m_ok || static_cast<std::size_t>(m_end - m_pos) < bytes) {
+                m_ok = false;
+                return false;
+            }
+            return true;
+        }
+
+        const unsigned char* m_pos;
+        const unsigned char* m_end;
+        bool m_ok = true;
+    };
+
+    using Entries = std::vector<std::pair<std::string, std::string>>;
+
+    void writeEntries(PresetWriter& out, const Entries& entries) {
+        out.u32(static_cast<uint32_t>(entries.size()));
+        for (const auto& [key, value] : entries) {
+            out.string(key);
+            out.string(value);
+        }
+    }
+
+    // True if `entries` had to change to match the preset
+    bool readEntries(PresetReader& in, Entries& entries) {
+        const uint32_t count = in.count(8);
+        const PresetReader first = in;
+        bool same = count == entries.size();
+        for (uint32_t i = 0; i < count && same; ++i) {
+            const std::string_view key = in.string();
+            const std::string_view value = in.string();
+            same = entries[i].first == key && entries[i].second == value;
+        }
+        if (same) {
+            return false;
+        }
+
+        // Differs somewhere: rebuild from the first record
+        in = first;
+        Entries result;
+        result.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const std::string_view key = in.string();
+            result.emplace_back(key, in.string());
+        }
+        entries.swap(result);
+        return true;
+    }
+
+    // Copies `value` into a fixed-size text field, cut to fit. False if it already held it.
+    template <std::size_t N>
+    bool assignText(std::array<char, N>& field, std::string_view value) {
+        value = value.substr(0, std::min(value.size(), N - 1));
+        if (std::strlen(field.data()) == value.size() && std::memcmp(field.data(), value.data(), value.size()) == 0) {
+            return false;
+        }
+        field.fill('\0');
+        std::memcpy(field.data(), value.data(), value.size());
+        return true;
+    }
+
+    bool assignInt(int& field, uint32_t value) {
+        const int parsed = static_cast<int>(value);
+        if (field == parsed) return false;
+        field = parsed;
+        return true;
+    }
+}
+
+bool PresetStore::isValidName(std::string_view name) {
+    if (name.empty() || name.size() > 64 || name == "." || name == ".." || name.back() == '.' || name.back() == ' ') {
+        return false;
+    }
+    return std::none_of(name.begin(), name.end(), [](char c) {
+        return static_cast<unsigned char>(c) < 0x20 || std::strchr("\\/:*?\"<>|", c) != nullptr;
+    });
+}
+
+std::filesystem::path PresetStore::presetPath(const std::string& name) const {
+    return m_directory / std::filesystem::u8path(name + s_extension);
+}
+
+std::filesystem::path PresetStore::decorStoreDir(uint64_t contentHash) const {
+    return m_directory / s_decorDir / ContentHash::toHex(contentHash);
+}
+
+bool PresetStore::open(std::filesystem::path directory) {
+    m_directory.clear();
+    m_names.clear();
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory / s_decorDir, ec);
+    if (ec) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot use presets in %s: %s",
+            directory.string().c_str(), ec.message().c_str());
+        return false;
+    }
+    m_directory = std::move(directory);
+
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+        const std::filesystem::path& file = entry.path();
+        if (entry.is_regular_file(ec) && file.extension() == s_extension) {
+            m_names.push_back(file.stem().u8string());
+        }
+    }
+    std::sort(m_names.begin(), m_names.end());
+
+    SDL_Log("Presets: %zu in %s", m_names.size(), m_directory.string().c_str());
+    return true;
+}
+
+void PresetStore::storeDecor(uint64_t contentHash, const std::string& name, const std::filesystem::path& source,
+                             const std::string& pendingBytes)
+{
+    // Content-addressed: a copy saved by an earlier preset is reused as is
+    const std::filesystem::path dir = decorStoreDir(contentHash);
+    std::error_code ec;
+    if (std::filesystem::exists(dir, ec) && !DecorImporter::listPngFiles(dir).empty()) {
+        return;
+    }
+
+    std::filesystem::create_directories(dir, ec);
+    const std::filesystem::path target = dir / std::filesystem::u8path(name + ".png");
+    bool stored = false;
+    if (!pendingBytes.empty()) {
+        stored = FileManager::writeLocalFile(target, pendingBytes);
+    }
+    else {
+        stored = std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing, ec);
+    }
+
+    if (!stored) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Preset keeps decor '%s' without a copy; it cannot be restored if deleted",
+            name.c_str());
+    }
+}
+
+bool PresetStore::save(const std::string& name) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    if (!isOpen() || !isValidName(name)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid preset name '%s'", name.c_str());
+        return false;
+    }
+
+    PresetWriter out;
+    out.bytes().reserve(LocalizationKeyCount * 256);
+
+    out.u32(static_cast<uint32_t>(LocalizationKeyCount));
+    for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+        out.string(LocalizationKeyNames[i]);
+        out.string(LocalizationList[i].data());
+    }
+    writeEntries(out, UnknownLocalizationEntries);
+
+    out.string(FontList.font.data());
+    out.u32(static_cast<uint32_t>(FontList.fontSize));
+    out.u32(static_cast<uint32_t>(FontList.otherTextFontSize));
+    writeEntries(out, UnknownFontEntries);
+
+    out.u32(static_cast<uint32_t>(StandartDecorList.size()));
+    for (const auto& [decorName, enabled] : StandartDecorList) {
+        out.string(decorName);
+        out.u8(enabled ? 1 : 0);
+    }
+
+    // Decor on its way out is not part of the set; items of unknown content cannot be matched later
+    std::vector<const CustomeDecorationList*> decor;
+    for (const CustomeDecorationList& item : CustomDecorList) {
+        if (item.contentHash != 0 && !item.hasOperation(CustomeDecorationOperationEnum::Remove)) {
+            decor.push_back(&item);
+        }
+    }
+    out.u32(static_cast<uint32_t>(decor.size()));
+    for (const CustomeDecorationList* item : decor) {
+        out.string(item->name);
+        out.u64(item->contentHash);
+        storeDecor(item->contentHash, item->name, item->path, item->pendingBytes);
+    }
+
+    PresetWriter header;
+    header.bytes().append(s_magic, sizeof(s_magic));
+    header.u32(s_version);
+    header.u64(ContentHash::hash(out.bytes()));
+    std::string& file = header.bytes();
+    file += out.bytes();
+
+    // Written beside the preset and renamed over it, so a failed save keeps the old one
+    const std::filesystem::path path = presetPath(name);
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::error_code ec;
+    if (FileManager::writeLocalFile(temp, file)) {
+        std::filesystem::rename(temp, path, ec);
+    }
+    else {
+        ec = std::make_error_code(std::errc::io_error);
+    }
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not save preset '%s'", name.c_str());
+        return false;
+    }
+
+    auto it = std::lower_bound(m_names.begin(), m_names.end(), name);
+    if (it == m_names.end() || *it != name) {
+        m_names.insert(it, name);
+    }
+    SDL_Log("Saved preset '%s' (%zu bytes, %zu custom decor)", name.c_str(), file.size(), decor.size());
+    return true;
+}
+
+bool PresetStore::apply(const std::string& name, Diff& diff) {
+    MemoryTagScope memoryTag(MemoryTag::ConfigIO);
+    diff = Diff();
+    if (!isOpen()) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(presetPath(name))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not open preset '%s': %s", name.c_str(), SDL_GetError());
+        return false;
+    }
+
+    PresetReader header(file.data(), file.size());
+    const bool validHeader = file.size() >= s_headerSize && std::memcmp(file.data(), s_magic, sizeof(s_magic)) == 0;
+    header.u32();
+    const uint32_t version = header.u32();
+    const uint64_t payloadHash = header.u64();
+    if (!validHeader || version != s_version
+        || ContentHash::hash(file.data() + s_headerSize, file.size() - s_headerSize) != payloadHash) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Preset '%s' is damaged or from another version", name.c_str());
+        return false;
+    }
+
+    // The payload is intact, so the in-place reads below cannot run out of bytes
+    PresetReader in(file.data() + s_headerSize, file.size() - s_headerSize);
+
+    // --- Localization ---
+    const uint32_t localizationCount = in.count(8);
+    for (uint32_t i = 0; i < localizationCount; ++i) {
+        const std::string_view key = in.string();
+        const std::string_view value = in.string();
+        const int index = LocalizationKeyHash.find(key);
+        if (index != PerfectHash<LocalizationKeyCount>::NotFound && assignText(LocalizationList[index], value)) {
+            diff.config.localization.set(static_cast<std::size_t>(index));
+        }
+    }
+    diff.config.unknownLocalization = readEntries(in, UnknownLocalizationEntries);
+
+    // --- Font ---
+    if (assignText(FontList.font, in.string())) {
+        diff.config.font.set(static_cast<std::size_t>(FontKey::FONT));
+    }
+    if (assignInt(FontList.fontSize, in.u32())) {
+        diff.config.font.set(static_cast<std::size_t>(FontKey::FONT_SIZE));
+    }
+    if (assignInt(FontList.otherTextFontSize, in.u32())) {
+        diff.config.font.set(static_cast<std::size_t>(FontKey::OTHER_TEXT_FONT_SIZE));
+    }
+    diff.config.unknownFont = readEntries(in, UnknownFontEntries);
+
+    // --- Standard decor ---
+    std::unordered_map<std::string_view, std::size_t> decorIndex;
+    decorIndex.reserve(StandartDecorList.size());
+    for (std::size_t i = 0; i < StandartDecorList.size(); ++i) {
+        decorIndex.emplace(StandartDecorList[i].first, i);
+    }
+    const uint32_t decorCount = in.count(5);
+    for (uint32_t i = 0; i < decorCount; ++i) {
+        const std::string_view decorName = in.string();
+        const bool enabled = in.u8() != 0;
+        auto it = decorIndex.find(decorName);
+        if (it != decorIndex.end() && StandartDecorList[it->second].second != enabled) {
+            StandartDecorList[it->second].second = enabled;
+            diff.config.decor.push_back(StandartDecorList[it->second].first);
+        }
+    }
+
+    // --- Custom decor ---
+    const uint32_t customCount = in.count(12);
+    std::unordered_map<uint64_t, std::string_view> wanted;
+    wanted.reserve(customCount);
+    for (uint32_t i = 0; i < customCount; ++i) {
+        const std::string_view decorName = in.string();
+        wanted.emplace(in.u64(), decorName);
+    }
+    if (!in.ok()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Preset '%s' ends early", name.c_str());
+        return false;
+    }
+
+    std::unordered_set<uint64_t> present;
+    for (CustomDecorCollection::Index i = 0; i < CustomDecorList.slotCount(); ++i) {
+        if (!CustomDecorList.isAlive(i) || CustomDecorList[i].contentHash == 0) {
+            continue;
+        }
+        CustomeDecorationList& item = CustomDecorList[i];
+
+        auto it = wanted.find(item.contentHash);
+        if (it == wanted.end() || !present.insert(item.contentHash).second) {
+            // Not in the preset, or a second copy of content it already has
+            if (item.hasOperation(CustomeDecorationOperationEnum::Add)) {
+                CustomDecorList.erase(i);
+                ++diff.decorRemoved;
+            }
+            else if (!item.hasOperation(CustomeDecorationOperationEnum::Remove)) {
+                item.addOperation(CustomeDecorationOperationEnum::Remove);
+                ++diff.decorRemoved;
+            }
+            continue;
+        }
+
+        if (item.hasOperation(CustomeDecorationOperationEnum::Remove)) {
+            item.restoreFromRemove();
+            ++diff.decorRestored;
+        }
+        if (item.name != it->second) {
+            CustomDecorList.rename(i, std::string(it->second));
+            ++diff.decorRenamed;
+        }
+    }
+    CustomDecorList.compact();
+
+    for (const auto& [contentHash, decorName] : wanted) {
+        if (present.count(contentHash) != 0) {
+            continue;
+        }
+        const std::filesystem::path dir = decorStoreDir(contentHash);
+        std::error_code ec;
+        const std::vector<std::filesystem::path> stored = std::filesystem::exists(dir, ec)
+            ? DecorImporter::listPngFiles(dir) : std::vector<std::filesystem::path>();
+        if (stored.empty()) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Preset decor '%.*s' has no stored copy",
+                static_cast<int>(decorName.size()), decorName.data());
+            ++diff.decorUnavailable;
+        }
+        else {
+            diff.missingDecor.push_back(stored.front());
+        }
+    }
+
+    SDL_Log("Applied preset '%s': %zu config entries, decor %zu renamed, %zu removed, %zu restored, %zu to import",
+        name.c_str(), diff.config.count(), diff.decorRenamed, diff.decorRemoved, diff.decorRestored,
+        diff.missingDecor.size());
+    return true;
+}
+
+bool PresetStore::remove(const std::string& name) {
+    std::error_code ec;
+    if (!isOpen() || !std::filesystem::remove(presetPath(name), ec)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not delete preset '%s'", name.c_str());
+        return false;
+    }
+    m_names.erase(std::remove(m_names.begin(), m_names.end(), name), m_names.end());
+    SDL_Log("Deleted preset '%s'", name.c_str());
+    return true;
+}
@@ -0,0 +1,173 @@
+#include <utils/steam_status.hpp>
+#include <utils/trace.hpp>
+
+#if !defined(__ANDROID__)
+#include <SDL.h>
+#include <algorithm>
+
+namespace {
+    constexpr uint32_t s_runningBit   = 1u << 0;
+    constexpr uint32_t s_ownsGameBit  = 1u << 1;
+    constexpr uint32_t s_installedBit = 1u << 2;
+    constexpr uint32_t s_flagsMask    = s_runningBit | s_ownsGameBit | s_installedBit;
+    constexpr uint32_t s_generationShift = 3;
+}
+
+bool SteamworksBackend::init() {
+    return SteamAPI_Init();
+}
+
+void SteamworksBackend::shutdown() {
+    SteamAPI_Shutdown();
+}
+
+void SteamworksBackend::runCallbacks() {
+    SteamAPI_RunCallbacks();
+}
+
+bool SteamworksBackend::isReady() {
+    return SteamUser() && SteamApps();
+}
+
+bool SteamworksBackend::isSubscribedApp(AppId_t appId) {
+    return SteamApps()->BIsSubscribedApp(appId);
+}
+
+bool SteamworksBackend::isAppInstalled(AppId_t appId) {
+    return SteamApps()->BIsAppInstalled(appId);
+}
+
+
+SteamStatus::SteamStatus(AppId_t appId, std::unique_ptr<SteamBackend> backend) :
+    m_appId(appId),
+    m_backend(std::move(backend))
+{}
+
+SteamStatus::~SteamStatus() {
+    stop();
+}
+
+void SteamStatus::start() {
+    if (m_thread.joinable() || !m_backend) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = false;
+        m_refreshRequested = false;
+    }
+    m_thread = std::thread(&SteamStatus::run, this);
+}
+
+void SteamStatus::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+}
+
+void SteamStatus::requestRefresh() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_refreshRequested = true;
+    }
+    m_wakeup.notify_one();
+}
+
+SteamStatus::Snapshot SteamStatus::snapshot() const {
+    const uint32_t state = m_state.load(std::memory_order_acquire);
+
+    Snapshot result;
+    result.steamRunning = (state & s_runningBit) != 0;
+    result.ownsGame = (state & s_ownsGameBit) != 0;
+    result.isInstalled = (state & s_installedBit) != 0;
+    result.generation = state >> s_generationShift;
+    return result;
+}
+
+void SteamStatus::publish(bool steamRunning, bool ownsGame, bool isInstalled) {
+    const uint32_t previous = m_state.load(std::memory_order_relaxed);
+    const uint32_t generation = (previous >> s_generationShift) + 1;
+
+    uint32_t state = generation << s_generationShift;
+    if (steamRunning) state |= s_runningBit;
+    if (ownsGame)     state |= s_ownsGameBit;
+    if (isInstalled)  state |= s_installedBit;
+
+    m_state.store(state, std::memory_order_release);
+}
+
+void SteamStatus::poll(bool& steamRunning) {
+    if (!steamRunning) {
+        steamRunning = m_backend->init();
+        if (steamRunning) {
+            SDL_Log("Steam API initialized by status monitor");
+        }
+    }
+
+    bool ownsGame = false;
+    bool isInstalled = false;
+
+    if (steamRunning && m_backend->isReady()) {
+        ownsGame = m_backend->isSubscribedApp(m_appId);
+        isInstalled = m_backend->isAppInstalled(m_appId);
+    }
+
+    publish(steamRunning, ownsGame, isInstalled);
+}
+
+void SteamStatus::run() {
+    Trace::setThreadName("Steam status");
+    bool steamRunning = false;
+    std::chrono::milliseconds backoff = s_minBackoff;
+    Clock::time_point nextPoll = Clock::now();
+
+    while (true) {
+        if (Clock::now() >= nextPoll) {
+            const uint32_t before = m_state.load(std::memory_order_relaxed) & s_flagsMask;
+            poll(steamRunning);
+            const uint32_t after = m_state.load(std::memory_order_relaxed) & s_flagsMask;
+
+            // Back off while nothing changes, snap back as soon as something
+            // does: waits of 250, 500, 1000 ms... up to the maximum
+            if (after != before) {
+                backoff = s_minBackoff;
+            }
+            nextPoll = Clock::now() + backoff;
+            backoff = std::min(backoff * 2, s_maxBackoff);
+        }
+
+        Clock::time_point wakeAt = nextPoll;
+        if (steamRunning) {
+            m_backend->runCallbacks();
+            wakeAt = std::min(wakeAt, Clock::now() + s_callbackInterval);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeup.wait_until(lock, wakeAt, [this]() {
+            return m_stopRequested || m_refreshRequested;
+        });
+
+        if (m_stopRequested) {
+            break;
+        }
+
+        if (m_refreshRequested) {
+            m_refreshRequested = false;
+            backoff = s_minBackoff;
+            nextPoll = Clock::now();
+        }
+    }
+
+    if (steamRunning) {
+        m_backend->shutdown();
+    }
+}
+#endif
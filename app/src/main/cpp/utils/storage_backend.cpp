@@ -0,0 +1,235 @@
+#include <utils/storage_backend.hpp>
+#include <SDL.h>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#if defined(__ANDROID__)
+#include <utils/jni_bridge.hpp>
+#endif
+
+// ---------- Desktop ----------
+
+bool DesktopStorageBackend::readFile(const std::string& path, std::string& bytes) {
+    try {
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for reading: %s", path.c_str());
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        if (size < 0) {
+            return false;
+        }
+
+        bytes.resize(static_cast<std::size_t>(size));
+        file.seekg(0, std::ios::beg);
+        return size == 0 || static_cast<bool>(file.read(bytes.data(), size));
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading file %s: %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+bool DesktopStorageBackend::writeFile(const std::string& path, const char* data, std::size_t size) {
+    try {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not open file for writing: %s", path.c_str());
+            return false;
+        }
+        file.write(data, static_cast<std::streamsize>(size));
+        return static_cast<bool>(file);
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error writing file %s: %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+bool DesktopStorageBackend::fileExists(const std::string& path) {
+    try {
+        return std::filesystem::is_regular_file(path);
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error checking file existence %s: %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+bool DesktopStorageBackend::dirExists(const std::string& path) {
+    try {
+        return std::filesystem::is_directory(path);
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error checking directory existence %s: %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+bool DesktopStorageBackend::createFile(const std::string& path) {
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    try {
+        return parent.empty() || std::filesystem::create_directories(parent);
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error creating directory %s: %s", parent.string().c_str(), e.what());
+        return false;
+    }
+}
+
+// ---------- In-memory ----------
+
+bool MemoryStorageBackend::readFile(const std::string& path, std::string& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_files.find(path);
+    if (it == m_files.end()) {
+        return false;
+    }
+    bytes.assign(it->second);
+    return true;
+}
+
+bool MemoryStorageBackend::writeFile(const std::string& path, const char* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[path].assign(data, size);
+    return true;
+}
+
+bool MemoryStorageBackend::fileExists(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_files.find(path) != m_files.end();
+}
+
+bool MemoryStorageBackend::dirExists(const std::string& path) {
+    std::string prefix = path;
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix.push_back('/');
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [name, content] : m_files) {
+        if (name.compare(0, prefix.size(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MemoryStorageBackend::createFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files.try_emplace(path);
+    return true;
+}
+
+std::size_t MemoryStorageBackend::fileCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_files.size();
+}
+
+void MemoryStorageBackend::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files.clear();
+}
+
+// ---------- Android ----------
+
+#if defined(__ANDROID__)
+namespace {
+    bool callPathMethod(const Jni::StaticMethod& method, const std::string& path) {
+        JNIEnv* env = Jni::env();
+        if (!env) {
+            return false;
+        }
+
+        Jni::LocalRef<jobject> activity = Jni::activity(env);
+        if (!activity) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNI environment or activity is null");
+            return false;
+        }
+
+        Jni::LocalRef<jstring> jPath = Jni::newString(env, path);
+        jboolean result = Jni::callStatic<jboolean>(env, method, activity.get(), jPath.get());
+        Jni::clearException(env, method.name);
+
+        return result == JNI_TRUE;
+    }
+}
+
+bool AndroidStorageBackend::readFile(const std::string& path, std::string& bytes) {
+    JNIEnv* env = Jni::env();
+    if (!env) {
+        return false;
+    }
+
+    Jni::LocalRef<jobject> activity = Jni::activity(env);
+    if (!activity) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JNIEnv or Activity is null!");
+        return false;
+    }
+
+    Jni::LocalRef<jstring> jPath = Jni::newString(env, path);
+    Jni::LocalRef<jbyteArray> jBytes = Jni::callStaticObject<jbyteArray>(
+            env, Jni::bindings().readFileBytes, activity.get(), jPath.get());
+
+    if (Jni::clearException(env, "readFileBytes") || !jBytes) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "readFileBytes returned null for path: %s", path.c_str());
+        return false;
+    }
+
+    const jsize size = env->GetArrayLength(jBytes.get());
+    bytes.resize(static_cast<std::size_t>(size));
+    if (size > 0) {
+        env->GetByteArrayRegion(jBytes.get(), 0, size, reinterpret_cast<jbyte*>(bytes.data()));
+    }
+    return true;
+}
+
+bool AndroidStorageBackend::writeFile(const std::string& path, const char* data, std::size_t size) {
+    JNIEnv* env = Jni::env();
+    if (!env) {
+        return false;
+    }
+
+    Jni::LocalRef<jobject> activity = Jni::activity(env);
+    if (!activity) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to get JNI environment or SDLActivity");
+        return false;
+    }
+
+    if (size > static_cast<std::size_t>(std::numeric_limits<jint>::max())) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "File too large for a ByteBuffer: %s", path.c_str());
+        return false;
+    }
+
+    // Java only reads from the buffer; it must not outlive this call.
+    static char s_empty = 0;
+    void* address = size > 0 ? const_cast<char*>(data) : &s_empty;
+
+    Jni::LocalRef<jstring> jPath = Jni::newString(env, path);
+    Jni::LocalRef<jobject> jBuffer(env, env->NewDirectByteBuffer(address, static_cast<jlong>(size)));
+    if (!jBuffer) {
+        Jni::clearException(env, "NewDirectByteBuffer");
+        return false;
+    }
+
+    jboolean result = Jni::callStatic<jboolean>(
+            env, Jni::bindings().writeFileBytes, activity.get(), jPath.get(), jBuffer.get());
+    Jni::clearException(env, "writeFileBytes");
+
+    return result == JNI_TRUE;
+}
+
+bool AndroidStorageBackend::fileExists(const std::string& path) {
+    return callPathMethod(Jni::bindings().fdExists, path);
+}
+
+bool AndroidStorageBackend::dirExists(const std::string& path) {
+    return callPathMethod(Jni::bindings().fdExists, path);
+}
+
+bool AndroidStorageBackend::createFile(const std::string& path) {
+    return callPathMethod(Jni::bindings().createFile, path);
+}
+#endif
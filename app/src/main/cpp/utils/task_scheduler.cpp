@@ -0,0 +1,249 @@
+#include <utils/task_scheduler.hpp>
+#include <utils/trace.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <exception>
+#include <string>
+
+struct TaskScheduler::Handle::State {
+    std::atomic<bool> isCancelled{ false };
+    std::atomic<bool> isDone{ false };
+    std::mutex mutex;
+    std::condition_variable done;
+
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isDone.store(true, std::memory_order_release);
+        }
+        done.notify_all();
+    }
+};
+
+namespace {
+    // Which pool, and which worker in it, the calling thread is
+    thread_local const TaskScheduler* s_currentScheduler = nullptr;
+    thread_local int s_currentWorker = -1;
+}
+
+void TaskScheduler::Handle::cancel() const {
+    if (m_state) {
+        m_state->isCancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool TaskScheduler::Handle::isCancelled() const {
+    return m_state && m_state->isCancelled.load(std::memory_order_relaxed);
+}
+
+bool TaskScheduler::Handle::isDone() const {
+    return !m_state || m_state->isDone.load(std::memory_order_acquire);
+}
+
+void TaskScheduler::Handle::wait() const {
+    if (!m_state) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    m_state->done.wait(lock, [this] { return m_state->isDone.load(std::memory_order_acquire); });
+}
+
+TaskScheduler::TaskScheduler(unsigned workerCount) {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    const unsigned threads = workerCount != 0 ? workerCount : std::max(1u, hardware > 1 ? hardware - 1 : 1u);
+
+    // Every deque exists before any worker can try to steal from it
+    m_workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        m_workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    // Whatever never ran is dropped, so nobody waits on it forever
+    for (auto& worker : m_workers) {
+        for (auto& queue : worker->queues) {
+            for (Task& task : queue) {
+                task.state->isCancelled.store(true, std::memory_order_relaxed);
+                task.state->finish();
+            }
+        }
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+int TaskScheduler::currentWorker() {
+    return s_currentWorker;
+}
+
+TaskScheduler::Handle TaskScheduler::submit(Work work, Priority priority, Continuation then) {
+    Handle handle;
+    handle.m_state = std::make_shared<Handle::State>();
+
+    // Counted before it is visible, so a worker never sees it taken before it was queued
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // A task spawned by a task stays on its worker, where its data is likely still in cache
+    const unsigned index = s_currentScheduler == this
+        ? static_cast<unsigned>(s_currentWorker)
+        : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % workerCount();
+    {
+        Worker& worker = *m_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[static_cast<std::size_t>(priority)].push_back({ std::move(work), std::move(then), handle.m_state });
+    }
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+
+    // Taking the lock orders this against a worker that just found nothing and is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+    return handle;
+}
+
+void TaskScheduler::post(Continuation continuation) {
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    m_mainQueue.push_back({ std::move(continuation), nullptr });
+}
+
+std::size_t TaskScheduler::runMainThread(std::chrono::microseconds budget) {
+    TRACE_ZONE("TaskScheduler::runMainThread");
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    std::size_t ran = 0;
+
+    for (;;) {
+        MainTask task;
+        {
+            std::lock_guard<std::mutex> lock(m_mainMutex);
+            if (m_mainQueue.empty()) {
+                break;
+            }
+            task = std::move(m_mainQueue.front());
+            m_mainQueue.pop_front();
+        }
+
+        // Cancelled after its work ran: the submitter no longer wants the result
+        if (task.state && task.state->isCancelled.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        task.continuation();
+        ++ran;
+        ++m_continuations;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return ran;
+}
+
+TaskScheduler::Stats TaskScheduler::stats() const {
+    Stats result;
+    result.submitted = m_submitted.load(std::memory_order_relaxed);
+    result.executed = m_executed.load(std::memory_order_relaxed);
+    result.stolen = m_stolen.load(std::memory_order_relaxed);
+    result.cancelled = m_cancelled.load(std::memory_order_relaxed);
+    result.continuations = m_continuations;
+    return result;
+}
+
+bool TaskScheduler::takeTask(unsigned index, Task& task) {
+    const unsigned count = workerCount();
+    for (std::size_t priority = 0; priority < s_priorityCount; ++priority) {
+        // Own work newest first...
+        {
+            Worker& own = *m_workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& queue = own.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.back());
+                queue.pop_back();
+                return true;
+            }
+        }
+
+        // ...then the oldest work of the others
+        for (unsigned offset = 1; offset < count; ++offset) {
+            Worker& victim = *m_workers[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto& queue = victim.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.front());
+                queue.pop_front();
+                m_stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::run(Task& task, Handle& handle) {
+    handle.m_state = task.state;
+    if (handle.isCancelled()) {
+        m_cancelled.fetch_add(1, std::memory_order_relaxed);
+        task.state->finish();
+        return;
+    }
+
+    // A thrown exception would otherwise end the process from a worker thread
+    try {
+        TRACE_ZONE("Task");
+        task.work(handle);
+    }
+    catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Task failed: %s", e.what());
+    }
+    catch (...) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Task failed with an unknown exception");
+    }
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+
+    if (task.then) {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        m_mainQueue.push_back({ std::move(task.then), task.state });
+    }
+    task.state->finish();
+}
+
+void TaskScheduler::workerLoop(unsigned index) {
+    s_currentScheduler = this;
+    s_currentWorker = static_cast<int>(index);
+    Trace::setThreadName(("Worker " + std::to_string(index)).c_str());
+
+    for (;;) {
+        Task task;
+        if (takeTask(index, task)) {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            Handle handle;
+            run(task, handle);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] { return m_stopRequested || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stopRequested) {
+            break;
+        }
+    }
+
+    s_currentScheduler = nullptr;
+    s_currentWorker = -1;
+}
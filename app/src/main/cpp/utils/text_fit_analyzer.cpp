@@ -0,0 +1,180 @@
+#include <utils/text_fit_analyzer.hpp>
+#include <utils/font_loader.hpp>
+#include <utils/utf8.hpp>
+#include <utils/memory_tracker.hpp>
+#include <assets/data.hpp>
+#include <SDL.h>
+#include <algorithm>
+
+namespace {
+    int measure(TTF_Font* font, const std::string& text) {
+        int width = 0;
+        int height = 0;
+        return TTF_SizeUTF8(font, text.c_str(), &width, &height) == 0 ? width : 0;
+    }
+}
+
+TextFitAnalyzer::TextFitAnalyzer(TaskScheduler& scheduler) :
+    m_scheduler(scheduler),
+    m_workerFonts(scheduler.workerCount())
+{}
+
+TextFitAnalyzer::~TextFitAnalyzer() {
+    for (const TaskScheduler::Handle& task : m_tasks) {
+        task.cancel();
+    }
+    for (const TaskScheduler::Handle& task : m_tasks) {
+        task.wait();
+    }
+    for (auto& fonts : m_workerFonts) {
+        for (WorkerFont& slot : fonts) {
+            closeFont(slot);
+        }
+    }
+}
+
+TextFitAnalyzer::SizeClass TextFitAnalyzer::sizeClassOf(std::size_t index) {
+    // The loading, endless-mode and instruction texts use FONT_SIZE; the
+    // story lines shown between stages use OTHER_TEXT_FONT_SIZE
+    return index < static_cast<std::size_t>(LocalizationKey::A_START) ? SizeClass::Text : SizeClass::OtherText;
+}
+
+void TextFitAnalyzer::setFont(const void* data, std::size_t size, std::shared_ptr<const void> owner) {
+    auto font = std::make_shared<FontData>();
+    font->data = data;
+    font->size = size;
+    font->owner = std::move(owner);
+    m_font = std::move(font);
+    updateAll();
+}
+
+void TextFitAnalyzer::setFontSizes(int textSize, int otherTextSize) {
+    const std::array<int, s_sizeClassCount> sizes = { textSize, otherTextSize };
+    for (std::size_t sizeClass = 0; sizeClass < s_sizeClassCount; ++sizeClass) {
+        if (m_fontSizes[sizeClass] == sizes[sizeClass]) continue;
+
+        m_fontSizes[sizeClass] = sizes[sizeClass];
+        for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+            if (static_cast<std::size_t>(sizeClassOf(i)) == sizeClass) update(i);
+        }
+    }
+}
+
+void TextFitAnalyzer::setArea(SizeClass sizeClass, const Area& area) {
+    Area& current = m_areas[static_cast<std::size_t>(sizeClass)];
+    if (current.width == area.width && current.height == area.height) {
+        return;
+    }
+    current = area;
+    for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+        if (sizeClassOf(i) == sizeClass) update(i);
+    }
+}
+
+void TextFitAnalyzer::update(std::size_t index) {
+    const std::size_t sizeClass = static_cast<std::size_t>(sizeClassOf(index));
+    if (!m_font || m_fontSizes[sizeClass] <= 0) {
+        return;
+    }
+
+    // A queued analysis of the same key is dropped rather than run twice
+    m_tasks[index].cancel();
+    if (m_finishedGenerations[index] == m_generations[index]) {
+        ++m_pending;
+    }
+    const uint32_t generation = ++m_generations[index];
+
+    auto job = std::make_shared<Job>(
+        Job{ index, LocalizationList[index].data(), m_font, m_fontSizes[sizeClass], m_areas[sizeClass], Result() });
+    m_tasks[index] = m_scheduler.submit(
+        [this, job](const TaskScheduler::Handle&) { run(*job); },
+        TaskScheduler::Priority::Low,
+        [this, job, generation] {
+            if (generation != m_generations[job->index]) return;
+            m_results[job->index] = std::move(job->result);
+            m_finishedGenerations[job->index] = generation;
+            --m_pending;
+        });
+}
+
+void TextFitAnalyzer::updateAll() {
+    for (std::size_t i = 0; i < LocalizationKeyCount; ++i) {
+        update(i);
+    }
+}
+
+TTF_Font* TextFitAnalyzer::openFont(WorkerFont& slot, const std::shared_ptr<const FontData>& font, int size) {
+    if (slot.handle && slot.font == font && slot.size == size) {
+        return slot.handle;
+    }
+    closeFont(slot);
+
+    std::lock_guard<std::mutex> lock(FontLoader::libraryMutex());
+    slot.handle = TTF_OpenFontRW(SDL_RWFromConstMem(font->data, static_cast<int>(font->size)), SDL_TRUE, size);
+    if (!slot.handle) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Text fit: TTF_OpenFontRW failed: %s", TTF_GetError());
+        return nullptr;
+    }
+    slot.font = font;
+    slot.size = size;
+    return slot.handle;
+}
+
+void TextFitAnalyzer::closeFont(WorkerFont& slot) {
+    if (slot.handle) {
+        std::lock_guard<std::mutex> lock(FontLoader::libraryMutex());
+        TTF_CloseFont(slot.handle);
+    }
+    slot = WorkerFont();
+}
+
+void TextFitAnalyzer::run(Job& job) {
+    MemoryTagScope memoryTag(MemoryTag::Text);
+
+    WorkerFont& slot = m_workerFonts[TaskScheduler::currentWorker()][static_cast<std::size_t>(sizeClassOf(job.index))];
+    if (TTF_Font* font = openFont(slot, job.font, job.fontSize)) {
+        analyze(font, job.text, job.area, job.result);
+    }
+    job.result.isReady = true;
+}
+
+void TextFitAnalyzer::analyze(TTF_Font* font, const std::string& text, const Area& area, Result& result) {
+    // Text::render() draws every line as written, one under the other: the
+    // game does not wrap, so a line wider than the area runs past its edge
+    std::string line;
+    for (std::size_t start = 0; start <= text.size();) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        line.assign(text, start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        start = end + 1;
+
+        // Text::render() skips empty lines entirely
+        if (line.empty()) continue;
+
+        result.widestLine = std::max(result.widestLine, measure(font, line));
+        ++result.lines;
+    }
+
+    result.height = result.lines * TTF_FontLineSkip(font);
+    result.overflows = result.widestLine > area.width || result.height > area.height;
+
+    std::string encoded;
+    std::size_t sampled = 0;
+    for (std::size_t pos = 0; pos < text.size();) {
+        const uint32_t codePoint = Utf8::next(text, pos);
+        if (codePoint < 0x20 || TTF_GlyphIsProvided32(font, codePoint)) {
+            continue;
+        }
+        ++result.missingGlyphs;
+
+        if (sampled < s_missingSampleSize) {
+            encoded.clear();
+            Utf8::append(encoded, codePoint);
+            if (result.missingSample.find(encoded) == std::string::npos) {
+                result.missingSample.append(encoded);
+                ++sampled;
+            }
+        }
+    }
+}
@@ -1,5 +1,26 @@
 ﻿#include <utils/texture.hpp>
+#include <utils/png_optimizer.hpp>
+#include <utils/png_stream.hpp>
+#include <utils/trace.hpp>
+#include <utils/frame_skip.hpp>
 #include <SDL_image.h>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TEXTURE_UPLOAD_SSE2 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        // Built for the baseline target; the AVX2 path is picked at runtime
+        #define TEXTURE_UPLOAD_AVX2_TARGET __attribute__((target("avx2")))
+    #else
+        #define TEXTURE_UPLOAD_AVX2_TARGET
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define TEXTURE_UPLOAD_NEON 1
+    #include <arm_neon.h>
+#endif
 
 
 Texture::Texture(SDL_Texture* texture, SDL_Renderer* renderer) :
@@ -80,19 +101,27 @@ void Texture::tile(
 }
 
 
+namespace {
+    SDL_Texture* uploadAndFreeSurface(SDL_Renderer* renderer, SDL_Surface* surface, bool premultiply = false) {
+        SDL_Texture* texture = TextureUpload::fromSurface(renderer, surface, premultiply);
+        SDL_FreeSurface(surface);
+        return texture;
+    }
+}
+
 RawTexture::RawTexture(SDL_RWops* data, SDL_Renderer* renderer) :
-    Texture(IMG_LoadTexture_RW(renderer, data, SDL_TRUE), renderer)
+    Texture(uploadAndFreeSurface(renderer, IMG_Load_RW(data, SDL_TRUE)), renderer)
 {
     if (!m_isInit) {
         SDL_LogCritical(
             SDL_LOG_CATEGORY_SYSTEM, "%s failed: %s",
-            "IMG_LoadTexture_RW", SDL_GetError()
+            "IMG_Load_RW", SDL_GetError()
         );
     }
 }
 
 RawTexture::RawTexture(const char* path, SDL_Renderer* renderer) :
-    Texture(IMG_LoadTexture(renderer, path), renderer)
+    Texture(uploadAndFreeSurface(renderer, IMG_Load(path)), renderer)
 {
     if (!m_isInit) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, 
@@ -108,13 +137,370 @@ void RawTexture::setAlpha(Uint8 alpha) {
 }
 
 SurfaceTexture::SurfaceTexture(SDL_Surface* surface, SDL_Renderer* renderer) :
-    Texture(SDL_CreateTextureFromSurface(renderer, surface), renderer)
+    Texture(uploadAndFreeSurface(renderer, surface), renderer)
 {
     if (!m_isInit) {
         SDL_LogCritical(
             SDL_LOG_CATEGORY_SYSTEM, "%s failed: %s",
-            "SDL_CreateTextureFromSurface", SDL_GetError()
+            "TextureUpload::fromSurface", SDL_GetError()
         );
     }
-    SDL_FreeSurface(surface);
 }
+
+
+// ---------- Pixel kernels ----------
+
+namespace {
+    // Exact round(c * a / 255) without a division
+    inline uint8_t mulDiv255(unsigned c, unsigned a) {
+        const unsigned t = c * a + 128;
+        return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+    }
+
+    template <bool SwapRedBlue, bool Premultiply>
+    void convertScalar(const uint8_t* src, uint8_t* dst, std::size_t pixels) {
+        for (std::size_t i = 0; i < pixels; ++i, src += 4, dst += 4) {
+            uint8_t r = src[0], g = src[1], b = src[2];
+            const uint8_t a = src[3];
+            if (Premultiply) {
+                r = mulDiv255(r, a);
+                g = mulDiv255(g, a);
+                b = mulDiv255(b, a);
+            }
+            if (SwapRedBlue) std::swap(r, b);
+            dst[0] = r;
+            dst[1] = g;
+            dst[2] = b;
+            dst[3] = a;
+        }
+    }
+
+#if defined(TEXTURE_UPLOAD_SSE2)
+    // Returns how many pixels were converted; the caller finishes the tail
+    template <bool SwapRedBlue, bool Premultiply>
+    std::size_t convertSse2(const uint8_t* src, uint8_t* dst, std::size_t pixels) {
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+
+        auto premultiply = [&](__m128i wide) {
+            const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(wide, 0xFF), 0xFF);
+            const __m128i t = _mm_add_epi16(_mm_mullo_epi16(wide, alpha), bias);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+
+        std::size_t i = 0;
+        for (; i + 4 <= pixels; i += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            if (Premultiply) {
+                const __m128i color = _mm_packus_epi16(premultiply(_mm_unpacklo_epi8(px, zero)),
+                                                       premultiply(_mm_unpackhi_epi8(px, zero)));
+                px = _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(px, alphaMask));
+            }
+            if (SwapRedBlue) {
+                const __m128i redBlue = _mm_and_si128(px, redBlueMask);
+                px = _mm_or_si128(_mm_andnot_si128(redBlueMask, px),
+                                  _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16)));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), px);
+        }
+        return i;
+    }
+
+    template <bool SwapRedBlue, bool Premultiply>
+    TEXTURE_UPLOAD_AVX2_TARGET
+    std::size_t convertAvx2(const uint8_t* src, uint8_t* dst, std::size_t pixels) {
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i redBlueMask = _mm256_set1_epi32(0x00FF00FF);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i bias = _mm256_set1_epi16(128);
+
+        std::size_t i = 0;
+        for (; i + 8 <= pixels; i += 8) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+            if (Premultiply) {
+                // unpack/pack work per 128-bit lane, so the pixel order survives the round trip
+                __m256i lo = _mm256_unpacklo_epi8(px, zero);
+                __m256i hi = _mm256_unpackhi_epi8(px, zero);
+                const __m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF);
+                const __m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF);
+                lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, alphaLo), bias);
+                hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, alphaHi), bias);
+                lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+                hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+                const __m256i color = _mm256_packus_epi16(lo, hi);
+                px = _mm256_or_si256(_mm256_andnot_si256(alphaMask, color), _mm256_and_si256(px, alphaMask));
+            }
+            if (SwapRedBlue) {
+                const __m256i redBlue = _mm256_and_si256(px, redBlueMask);
+                px = _mm256_or_si256(_mm256_andnot_si256(redBlueMask, px),
+                                     _mm256_or_si256(_mm256_slli_epi32(redBlue, 16), _mm256_srli_epi32(redBlue, 16)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), px);
+        }
+        return i;
+    }
+
+#endif
+
+#if defined(TEXTURE_UPLOAD_NEON)
+    inline uint8x16_t premultiplyNeon(uint8x16_t color, uint8x16_t alpha) {
+        const uint16x8_t lo = vmull_u8(vget_low_u8(color), vget_low_u8(alpha));
+        const uint16x8_t hi = vmull_u8(vget_high_u8(color), vget_high_u8(alpha));
+        // (t + ((t + 128) >> 8) + 128) >> 8, same rounding as mulDiv255
+        return vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+    }
+
+    template <bool SwapRedBlue, bool Premultiply>
+    std::size_t convertNeon(const uint8_t* src, uint8_t* dst, std::size_t pixels) {
+        std::size_t i = 0;
+        for (; i + 16 <= pixels; i += 16) {
+            uint8x16x4_t px = vld4q_u8(src + i * 4);
+            if (Premultiply) {
+                px.val[0] = premultiplyNeon(px.val[0], px.val[3]);
+                px.val[1] = premultiplyNeon(px.val[1], px.val[3]);
+                px.val[2] = premultiplyNeon(px.val[2], px.val[3]);
+            }
+            if (SwapRedBlue) {
+                std::swap(px.val[0], px.val[2]);
+            }
+            vst4q_u8(dst + i * 4, px);
+        }
+        return i;
+    }
+#endif
+
+    TextureUpload::Kernel bestKernel() {
+#if defined(TEXTURE_UPLOAD_SSE2)
+        return SDL_HasAVX2() ? TextureUpload::Kernel::Avx2 : TextureUpload::Kernel::Sse2;
+#elif defined(TEXTURE_UPLOAD_NEON)
+        return TextureUpload::Kernel::Neon;
+#else
+        return TextureUpload::Kernel::Scalar;
+#endif
+    }
+
+    TextureUpload::Kernel s_kernel = bestKernel();
+
+    template <bool SwapRedBlue, bool Premultiply>
+    void convert(const uint8_t* src, uint8_t* dst, std::size_t pixels) {
+        std::size_t done = 0;
+#if defined(TEXTURE_UPLOAD_SSE2)
+        if (s_kernel == TextureUpload::Kernel::Avx2) {
+            done = convertAvx2<SwapRedBlue, Premultiply>(src, dst, pixels);
+        }
+        if (s_kernel != TextureUpload::Kernel::Scalar) {
+            done += convertSse2<SwapRedBlue, Premultiply>(src + done * 4, dst + done * 4, pixels - done);
+        }
+#elif defined(TEXTURE_UPLOAD_NEON)
+        if (s_kernel == TextureUpload::Kernel::Neon) {
+            done = convertNeon<SwapRedBlue, Premultiply>(src, dst, pixels);
+        }
+#endif
+        convertScalar<SwapRedBlue, Premultiply>(src + done * 4, dst + done * 4, pixels - done);
+    }
+
+    // ---------- Texture creation ----------
+
+    // Byte-order formats, so alpha is the last byte on any endianness
+    bool isByteOrderRgba(Uint32 format) {
+        return format == SDL_PIXELFORMAT_RGBA32 || format == SDL_PIXELFORMAT_BGRA32;
+    }
+
+    Uint32 nativeFormat(SDL_Renderer* renderer) {
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(renderer, &info) == 0) {
+            for (Uint32 preferred : { Uint32(SDL_PIXELFORMAT_BGRA32), Uint32(SDL_PIXELFORMAT_RGBA32) }) {
+                for (Uint32 i = 0; i < info.num_texture_formats; ++i) {
+                    if (info.texture_formats[i] == preferred) return preferred;
+                }
+            }
+        }
+        return SDL_PIXELFORMAT_BGRA32;
+    }
+
+    SDL_BlendMode premultipliedBlendMode() {
+        static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        return mode;
+    }
+
+    // Clears `premultiply` when the renderer cannot blend premultiplied pixels
+    SDL_Texture* createStreaming(SDL_Renderer* renderer, Uint32 format, int width, int height,
+                                 SDL_BlendMode blendMode, bool& premultiply)
+    {
+        SDL_Texture* texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!texture) {
+            return nullptr;
+        }
+        if (premultiply && SDL_SetTextureBlendMode(texture, premultipliedBlendMode()) != 0) {
+            premultiply = false;
+        }
+        if (!premultiply) {
+            SDL_SetTextureBlendMode(texture, blendMode);
+        }
+        return texture;
+    }
+}
+
+namespace TextureUpload {
+
+void convertRow(const uint8_t* src, uint8_t* dst, std::size_t pixels, bool swapRedBlue, bool premultiply) {
+    if (swapRedBlue) {
+        premultiply ? convert<true, true>(src, dst, pixels) : convert<true, false>(src, dst, pixels);
+    } else if (premultiply) {
+        convert<false, true>(src, dst, pixels);
+    } else if (src != dst) {
+        std::memcpy(dst, src, pixels * 4);
+    }
+}
+
+Kernel kernel() {
+    return s_kernel;
+}
+
+bool isKernelSupported(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::Scalar: return true;
+#if defined(TEXTURE_UPLOAD_SSE2)
+    case Kernel::Sse2:   return true;
+    case Kernel::Avx2:   return SDL_HasAVX2() == SDL_TRUE;
+#elif defined(TEXTURE_UPLOAD_NEON)
+    case Kernel::Neon:   return true;
+#endif
+    default:             return false;
+    }
+}
+
+bool setKernel(Kernel kernel) {
+    if (!isKernelSupported(kernel)) {
+        return false;
+    }
+    s_kernel = kernel;
+    return true;
+}
+
+const char* kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::Scalar: return "scalar";
+    case Kernel::Sse2:   return "SSE2";
+    case Kernel::Avx2:   return "AVX2";
+    case Kernel::Neon:   return "NEON";
+    default:             return "unknown";
+    }
+}
+
+SDL_Texture* fromSurface(SDL_Renderer* renderer, SDL_Surface* surface, bool premultiply) {
+    TRACE_ZONE("Texture upload");
+    if (!renderer || !surface) {
+        return nullptr;
+    }
+
+    SDL_Surface* source = surface;
+    if (!isByteOrderRgba(surface->format->format)) {
+        // Palettes, colour keys and 24-bit data: let SDL expand them once
+        source = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        if (!source) {
+            return nullptr;
+        }
+    }
+
+    // Same rule as SDL_CreateTextureFromSurface: colour-keyed surfaces need blending
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    if (!SDL_HasColorKey(surface)) {
+        SDL_GetSurfaceBlendMode(surface, &blendMode);
+    }
+    if (blendMode != SDL_BLENDMODE_BLEND) {
+        premultiply = false;
+    }
+
+    const Uint32 format = nativeFormat(renderer);
+    SDL_Texture* texture = createStreaming(renderer, format, source->w, source->h, blendMode, premultiply);
+
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (texture && SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0) {
+        if (SDL_MUSTLOCK(source)) SDL_LockSurface(source);
+
+        const bool swapRedBlue = source->format->format != format;
+        for (int y = 0; y < source->h; ++y) {
+            convertRow(static_cast<const uint8_t*>(source->pixels) + static_cast<std::size_t>(y) * source->pitch,
+                       static_cast<uint8_t*>(pixels) + static_cast<std::size_t>(y) * pitch,
+                       static_cast<std::size_t>(source->w), swapRedBlue, premultiply);
+        }
+
+        if (SDL_MUSTLOCK(source)) SDL_UnlockSurface(source);
+        SDL_UnlockTexture(texture);
+    } else if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+
+    if (source != surface) {
+        SDL_FreeSurface(source);
+    }
+    if (texture) {
+        // May reuse a destroyed texture's address, which the draw data cannot tell apart
+        FrameSkip::requestRedraw();
+    }
+    return texture;
+}
+
+SDL_Texture* fromImage(SDL_Renderer* renderer, const void* data, std::size_t size,
+                       int maxWidth, int maxHeight, bool premultiply)
+{
+    PngOptimizer::PngInfo info;
+    const bool oversized = PngOptimizer::readPngInfo(data, size, info) &&
+        (info.width > static_cast<uint32_t>(maxWidth) || info.height > static_cast<uint32_t>(maxHeight));
+
+    if (!oversized) {
+        SDL_Surface* surface = nullptr;
+        if (SDL_RWops* rw = SDL_RWFromConstMem(data, static_cast<int>(size))) {
+            TRACE_ZONE("PNG decode");
+            surface = IMG_Load_RW(rw, 1);
+        }
+        return uploadAndFreeSurface(renderer, surface, premultiply);
+    }
+
+    TRACE_ZONE("Texture upload (streamed)");
+
+    int width = 0;
+    int height = 0;
+    if (!renderer || !PngStream::previewSize(data, size, maxWidth, maxHeight, width, height)) {
+        return nullptr;
+    }
+
+    const Uint32 format = nativeFormat(renderer);
+    SDL_Texture* texture = createStreaming(renderer, format, width, height, SDL_BLENDMODE_BLEND, premultiply);
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (!texture || SDL_LockTexture(texture, nullptr, &pixels, &pitch) != 0) {
+        if (texture) SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+
+    // The decoder writes RGBA straight into texture memory; one in-place pass fixes the layout
+    SDL_Surface* view = SDL_CreateRGBSurfaceWithFormatFrom(pixels, width, height, 32, pitch, SDL_PIXELFORMAT_RGBA32);
+    const bool decoded = view && PngStream::decodeInto(data, size, view);
+    if (view) SDL_FreeSurface(view);
+
+    if (decoded) {
+        const bool swapRedBlue = format != SDL_PIXELFORMAT_RGBA32;
+        for (int y = 0; y < height; ++y) {
+            uint8_t* row = static_cast<uint8_t*>(pixels) + static_cast<std::size_t>(y) * pitch;
+            convertRow(row, row, static_cast<std::size_t>(width), swapRedBlue, premultiply);
+        }
+    }
+    SDL_UnlockTexture(texture);
+
+    if (!decoded) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    FrameSkip::requestRedraw();
+    return texture;
+}
+
+} // namespace TextureUpload
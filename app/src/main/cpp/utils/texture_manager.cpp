@@ -0,0 +1,175 @@
+#include <utils/texture_manager.hpp>
+#include <utils/file_manager.hpp>
+#include <utils/texture.hpp>
+#include <SDL_image.h>
+
+namespace {
+    uint64_t textureBytes(SDL_Texture* texture) {
+        Uint32 format = 0;
+        int width = 0;
+        int height = 0;
+        if (SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0) {
+            return 0;
+        }
+        const uint64_t bytesPerPixel = SDL_BYTESPERPIXEL(format) ? SDL_BYTESPERPIXEL(format) : 4;
+        return bytesPerPixel * static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    }
+}
+
+SDL_Texture* TextureHandle::get() const {
+    if (!m_entry) {
+        return nullptr;
+    }
+    return m_entry->owner ? m_entry->owner->acquire(*m_entry) : m_entry->texture;
+}
+
+const std::filesystem::path& TextureHandle::source() const {
+    static const std::filesystem::path s_empty;
+    return m_entry ? m_entry->source : s_empty;
+}
+
+void TextureHandle::setSource(std::filesystem::path source) {
+    if (m_entry) {
+        m_entry->source = std::move(source);
+        m_entry->reloadFailed = false;
+    }
+}
+
+TextureManager::TextureManager(uint64_t budgetBytes) :
+    m_budget(budgetBytes)
+{}
+
+TextureManager::~TextureManager() {
+    shutdown();
+}
+
+void TextureManager::shutdown() {
+    // Handles may outlive the manager (static collections); they keep a null texture
+    for (TextureEntry* entry : m_entries) {
+        if (entry->texture) {
+            SDL_DestroyTexture(entry->texture);
+            entry->texture = nullptr;
+        }
+        entry->owner = nullptr;
+    }
+    m_entries.clear();
+    m_lru.clear();
+    m_residentBytes = 0;
+}
+
+TextureHandle TextureManager::adopt(SDL_Texture* texture, std::filesystem::path source, bool premultiply) {
+    if (!texture) {
+        return {};
+    }
+
+    auto* entry = new TextureEntry();
+    entry->owner = this;
+    entry->source = std::move(source);
+    entry->premultiply = premultiply;
+    m_entries.insert(entry);
+    makeResident(*entry, texture);
+
+    return TextureHandle(std::shared_ptr<TextureEntry>(entry, &TextureManager::release));
+}
+
+void TextureManager::release(TextureEntry* entry) {
+    if (TextureManager* owner = entry->owner) {
+        if (entry->texture) {
+            owner->m_residentBytes -= entry->bytes;
+            owner->m_lru.erase(entry->lruPosition);
+        }
+        owner->m_entries.erase(entry);
+    }
+    if (entry->texture) {
+        SDL_DestroyTexture(entry->texture);
+    }
+    delete entry;
+}
+
+SDL_Texture* TextureManager::acquire(TextureEntry& entry) {
+    entry.lastUsedFrame = m_frame;
+
+    if (entry.texture) {
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+        return entry.texture;
+    }
+
+    if (entry.reloadFailed || !reload(entry)) {
+        return nullptr;
+    }
+    ++m_misses;
+    return entry.texture;
+}
+
+bool TextureManager::reload(TextureEntry& entry) {
+    std::string bytes;
+    SDL_Texture* texture = nullptr;
+    if (m_renderer && FileManager::readLocalFile(entry.source, bytes)) {
+        texture = TextureUpload::fromImage(m_renderer, bytes.data(), bytes.size(),
+            m_previewWidth, m_previewHeight, entry.premultiply);
+    }
+
+    if (!texture) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not reload evicted texture %s: %s",
+            entry.source.string().c_str(), IMG_GetError());
+        entry.reloadFailed = true;
+        return false;
+    }
+
+    makeResident(entry, texture);
+    return true;
+}
+
+void TextureManager::makeResident(TextureEntry& entry, SDL_Texture* texture) {
+    entry.texture = texture;
+    entry.bytes = textureBytes(texture);
+    entry.lastUsedFrame = m_frame;
+    m_residentBytes += entry.bytes;
+    m_lru.push_front(&entry);
+    entry.lruPosition = m_lru.begin();
+}
+
+void TextureManager::evict(TextureEntry& entry) {
+    SDL_DestroyTexture(entry.texture);
+    entry.texture = nullptr;
+    m_residentBytes -= entry.bytes;
+    entry.bytes = 0;
+    m_lru.erase(entry.lruPosition);
+    ++m_evictions;
+}
+
+void TextureManager::beginFrame() {
+    const uint64_t previousFrame = m_frame++;
+    if (m_residentBytes <= m_budget) {
+        return;
+    }
+
+    // Oldest first; stop at textures still on screen, everything before them is newer
+    auto it = m_lru.end();
+    while (m_residentBytes > m_budget && it != m_lru.begin()) {
+        TextureEntry* entry = *--it;
+        if (entry->lastUsedFrame >= previousFrame) {
+            break;
+        }
+        if (entry->source.empty()) {
+            continue;
+        }
+        auto next = it;
+        ++next;
+        evict(*entry);
+        it = next;
+    }
+}
+
+TextureManager::Stats TextureManager::stats() const {
+    Stats result;
+    result.textures = m_entries.size();
+    result.resident = m_lru.size();
+    result.residentBytes = m_residentBytes;
+    result.budgetBytes = m_budget;
+    result.hits = m_hits;
+    result.misses = m_misses;
+    result.evictions = m_evictions;
+    return result;
+}
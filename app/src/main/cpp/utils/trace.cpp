@@ -0,0 +1,158 @@
+#include <utils/trace.hpp>
+#include <utils/file_manager.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Zone {
+        const char* name;
+        uint64_t begin;     // Nanoseconds since the session started
+        uint64_t end;
+    };
+
+    // Each thread appends to its own buffer; the lock is only contended
+    // while start() or stop() walk the buffers
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<Zone> zones;
+        std::string name;
+        uint32_t id = 0;
+        uint64_t dropped = 0;
+    };
+
+    // Keeps a long session from growing without bound: 24 MB per thread
+    constexpr std::size_t s_maxZonesPerThread = std::size_t(1) << 20;
+
+    // Buffers outlive their threads so stop() can still write them
+    std::mutex s_buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+    std::filesystem::path s_path;
+    const auto s_epoch = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> s_sessionStart{ 0 };
+
+    thread_local ThreadBuffer* s_threadBuffer = nullptr;
+    thread_local std::string s_threadName;
+
+    ThreadBuffer& threadBuffer() {
+        if (!s_threadBuffer) {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->name = s_threadName;
+            std::lock_guard<std::mutex> lock(s_buffersMutex);
+            buffer->id = static_cast<uint32_t>(s_buffers.size() + 1);
+            s_threadBuffer = buffer.get();
+            s_buffers.push_back(std::move(buffer));
+        }
+        return *s_threadBuffer;
+    }
+}
+
+namespace Trace {
+
+bool start(std::filesystem::path path) {
+    if (!isCompiledIn()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Tracing is not built in (SENSE_TRACING)");
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        for (const auto& buffer : s_buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->zones.clear();
+            buffer->dropped = 0;
+        }
+        s_path = std::move(path);
+    }
+    s_sessionStart.store(detail::now(), std::memory_order_relaxed);
+    detail::s_isRecording.store(true, std::memory_order_release);
+    SDL_Log("Tracing to %s", s_path.string().c_str());
+    return true;
+}
+
+bool stop() {
+    if (!detail::s_isRecording.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    const uint64_t sessionStart = s_sessionStart.load(std::memory_order_relaxed);
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    std::size_t zoneCount = 0;
+    uint64_t dropped = 0;
+    bool isFirst = true;
+
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    for (const auto& buffer : s_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (buffer->zones.empty()) {
+            continue;
+        }
+        json.reserve(json.size() + buffer->zones.size() * 80);
+
+        if (!buffer->name.empty()) {
+            FileManager::appendf(json, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                isFirst ? "" : ",\n", buffer->id, buffer->name.c_str());
+            isFirst = false;
+        }
+        for (const Zone& zone : buffer->zones) {
+            // Zones started before the session have their start clipped
+            const uint64_t begin = std::max(zone.begin, sessionStart) - sessionStart;
+            const uint64_t duration = zone.end - std::max(zone.begin, sessionStart);
+            FileManager::appendf(json, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                isFirst ? "" : ",\n", zone.name, buffer->id, begin / 1000.0, duration / 1000.0);
+            isFirst = false;
+        }
+        zoneCount += buffer->zones.size();
+        dropped += buffer->dropped;
+        buffer->zones.clear();
+        buffer->zones.shrink_to_fit();
+    }
+    json += "\n]}\n";
+
+    if (dropped > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Trace buffers were full: %llu zones dropped",
+            static_cast<unsigned long long>(dropped));
+    }
+    if (!FileManager::writeLocalFile(s_path, json)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write trace %s", s_path.string().c_str());
+        return false;
+    }
+    SDL_Log("Trace with %zu zones written to %s", zoneCount, s_path.string().c_str());
+    return true;
+}
+
+void setThreadName(const char* name) {
+    s_threadName = name;
+    if (s_threadBuffer) {
+        std::lock_guard<std::mutex> lock(s_threadBuffer->mutex);
+        s_threadBuffer->name = name;
+    }
+}
+
+namespace detail {
+
+uint64_t now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+void record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (!isRecording()) {
+        return;     // Finished after stop(); the trace is already written
+    }
+    if (buffer.zones.size() >= s_maxZonesPerThread) {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.zones.push_back({ name, begin, end });
+}
+
+} // namespace detail
+
+} // namespace Trace
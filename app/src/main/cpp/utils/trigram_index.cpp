@@ -0,0 +1,171 @@
+#include <utils/trigram_index.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    uint32_t trigramAt(const std::string& text, std::size_t i) {
+        // Past the end reads as 0, so every byte starts a trigram and short
+        // queries match at the end of the text too
+        const auto byte = [&](std::size_t at) -> uint32_t {
+            return at < text.size() ? static_cast<unsigned char>(text[at]) : 0;
+        };
+        return (byte(i) << 16) | (byte(i + 1) << 8) | byte(i + 2);
+    }
+}
+
+void TrigramIndex::fold(std::string_view text, std::string& out) {
+    out.assign(text.data(), text.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        auto c = static_cast<unsigned char>(out[i]);
+        if (c >= 'A' && c <= 'Z') {
+            out[i] = static_cast<char>(c + ('a' - 'A'));
+        }
+        else if ((c == 0xD0 || c == 0xD2) && i + 1 < out.size()) {
+            // Two-byte Cyrillic capitals; the lower-case form has the same length
+            const auto next = static_cast<unsigned char>(out[i + 1]);
+            if (c == 0xD0 && next >= 0x80 && next <= 0x8F) {         // Ѐ..Џ
+                out[i] = static_cast<char>(0xD1);
+                out[i + 1] = static_cast<char>(next + 0x10);
+            }
+            else if (c == 0xD0 && next >= 0x90 && next <= 0x9F) {    // А..П
+                out[i + 1] = static_cast<char>(next + 0x20);
+            }
+            else if (c == 0xD0 && next >= 0xA0 && next <= 0xAF) {    // Р..Я
+                out[i] = static_cast<char>(0xD1);
+                out[i + 1] = static_cast<char>(next - 0x20);
+            }
+            else if (c == 0xD2 && next == 0x90) {                    // Ґ
+                out[i + 1] = static_cast<char>(0x91);
+            }
+            ++i;
+        }
+    }
+}
+
+void TrigramIndex::collectTrigrams(const std::string& folded, std::vector<uint32_t>& trigrams) {
+    trigrams.clear();
+    for (std::size_t i = 0; i < folded.size(); ++i) {
+        trigrams.push_back(trigramAt(folded, i));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void TrigramIndex::resize(std::size_t documentCount) {
+    m_postings.clear();
+    m_docTrigrams.assign(documentCount, {});
+    m_folded.assign(documentCount, {});
+}
+
+void TrigramIndex::addPosting(uint32_t trigram, DocId doc) {
+    std::vector<DocId>& list = m_postings[trigram];
+    list.insert(std::lower_bound(list.begin(), list.end(), doc), doc);
+}
+
+void TrigramIndex::removePosting(uint32_t trigram, DocId doc) {
+    auto it = m_postings.find(trigram);
+    if (it == m_postings.end()) {
+        return;
+    }
+    std::vector<DocId>& list = it->second;
+    auto pos = std::lower_bound(list.begin(), list.end(), doc);
+    if (pos != list.end() && *pos == doc) {
+        list.erase(pos);
+    }
+    if (list.empty()) {
+        m_postings.erase(it);
+    }
+}
+
+void TrigramIndex::update(DocId doc, std::string_view text) {
+    if (doc >= m_folded.size()) {
+        return;
+    }
+
+    fold(text, m_scratch);
+    if (m_scratch == m_folded[doc]) {
+        return;
+    }
+    collectTrigrams(m_scratch, m_trigrams);
+
+    // Both sets are sorted: walk them together and touch only the difference
+    const std::vector<uint32_t>& old = m_docTrigrams[doc];
+    auto a = old.begin();
+    auto b = m_trigrams.begin();
+    while (a != old.end() || b != m_trigrams.end()) {
+        if (b == m_trigrams.end() || (a != old.end() && *a < *b)) {
+            removePosting(*a++, doc);
+        }
+        else if (a == old.end() || *b < *a) {
+            addPosting(*b++, doc);
+        }
+        else {
+            ++a;
+            ++b;
+        }
+    }
+
+    m_docTrigrams[doc].swap(m_trigrams);
+    m_folded[doc].swap(m_scratch);
+}
+
+void TrigramIndex::search(std::string_view query, std::vector<DocId>& results) const {
+    results.clear();
+    fold(query, m_query);
+
+    if (m_query.empty()) {
+        for (DocId doc = 0; doc < m_folded.size(); ++doc) {
+            results.push_back(doc);
+        }
+        return;
+    }
+
+    // One or two bytes: every trigram with that prefix, no verification needed
+    if (m_query.size() < 3) {
+        const uint32_t shift = m_query.size() == 1 ? 16 : 8;
+        const uint32_t first = trigramAt(m_query, 0);
+        const uint32_t last = first | ((1u << shift) - 1);
+
+        m_marks.assign(m_folded.size(), 0);
+        for (auto it = m_postings.lower_bound(first); it != m_postings.end() && it->first <= last; ++it) {
+            for (DocId doc : it->second) {
+                m_marks[doc] = 1;
+            }
+        }
+        for (DocId doc = 0; doc < m_marks.size(); ++doc) {
+            if (m_marks[doc]) results.push_back(doc);
+        }
+        return;
+    }
+
+    m_queryTrigrams.clear();
+    for (std::size_t i = 0; i + 3 <= m_query.size(); ++i) {
+        m_queryTrigrams.push_back(trigramAt(m_query, i));
+    }
+    std::sort(m_queryTrigrams.begin(), m_queryTrigrams.end());
+    m_queryTrigrams.erase(std::unique(m_queryTrigrams.begin(), m_queryTrigrams.end()), m_queryTrigrams.end());
+
+    m_lists.clear();
+    for (uint32_t trigram : m_queryTrigrams) {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) {
+            return;
+        }
+        m_lists.push_back(&it->second);
+    }
+
+    // Rarest first keeps every intersection as small as possible
+    std::sort(m_lists.begin(), m_lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+    results = *m_lists.front();
+    for (std::size_t i = 1; i < m_lists.size() && !results.empty(); ++i) {
+        m_swap.clear();
+        std::set_intersection(results.begin(), results.end(), m_lists[i]->begin(), m_lists[i]->end(),
+            std::back_inserter(m_swap));
+        results.swap(m_swap);
+    }
+
+    // Shared trigrams do not prove the query occurs in order
+    results.erase(std::remove_if(results.begin(), results.end(), [&](DocId doc) {
+        return m_folded[doc].find(m_query) == std::string::npos;
+    }), results.end());
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fast non-cryptographic 64-bit hash for file contents (XXH64 layout). The
+// bulk loop runs four independent accumulators over 32-byte stripes, so the
+// multiplies overlap instead of forming one long dependency chain.
+namespace ContentHash {
+
+uint64_t hash(const void* data, std::size_t size, uint64_t seed = 0);
+
+inline uint64_t hash(const std::string& bytes, uint64_t seed = 0) {
+    return hash(bytes.data(), bytes.size(), seed);
+}
+
+std::string toHex(uint64_t value);
+bool fromHex(const std::string& text, uint64_t& value);
+
+} // namespace ContentHash
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL.h>
+#include <utils/texture_manager.hpp>
+
+enum class CustomeDecorationOperationEnum : uint8_t {
+    None   = 0,
+    Add    = 1 << 0,
+    Remove = 1 << 1,
+    Rename = 1 << 2
+};
+
+struct CustomeDecorationList {
+    std::string name;
+    std::string originalName;   // Name on disk, or the source file stem for new items
+    TextureHandle texture;
+    std::filesystem::path path;
+    uint8_t operations = 0;     // CustomeDecorationOperationEnum bits, 0 = None
+    uint8_t prevOperations = 0; // Operations to bring back when a removal is undone
+    uint64_t contentHash = 0;   // ContentHash of the PNG bytes, 0 = unknown
+    std::string pendingBytes;   // Optimized file to write on Add instead of copying `path`
+
+    [[nodiscard]] bool hasOperation(CustomeDecorationOperationEnum op) const {
+        if (op == CustomeDecorationOperationEnum::None) {
+            return operations == 0;
+        }
+        return (operations & static_cast<uint8_t>(op)) != 0;
+    }
+
+    void setOperation(CustomeDecorationOperationEnum op) {
+        operations = static_cast<uint8_t>(op);
+    }
+
+    void addOperation(CustomeDecorationOperationEnum op);
+    void restoreFromRemove();
+
+    static void sanitizeFileName(std::string& s);
+};
+
+// Owns the custom decorations. Names are unique and indexed by a hash map, so
+// adding or renaming an item does not scan the list. Erasing leaves a
+// tombstone: indices stay valid until compact() is called at a safe point.
+class CustomDecorCollection {
+public:
+    using Index = std::size_t;
+    static constexpr Index npos = static_cast<Index>(-1);
+
+    template <typename Collection, typename Item>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CustomeDecorationList;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Item*;
+        using reference = Item&;
+
+        Iterator(Collection* owner, Index index) : m_owner(owner), m_index(index) { skipDead(); }
+
+        reference operator*() const { return m_owner->m_items[m_index]; }
+        pointer operator->() const { return &m_owner->m_items[m_index]; }
+        [[nodiscard]] Index index() const { return m_index; }
+
+        Iterator& operator++() {
+            ++m_index;
+            skipDead();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        void skipDead() {
+            while (m_index < m_owner->m_items.size() && !m_owner->m_alive[m_index]) ++m_index;
+        }
+
+        Collection* m_owner;
+        Index m_index;
+    };
+
+    using iterator = Iterator<CustomDecorCollection, CustomeDecorationList>;
+    using const_iterator = Iterator<const CustomDecorCollection, const CustomeDecorationList>;
+
+    // Sanitizes and de-duplicates the name, then appends. Returns the new index.
+    Index add(CustomeDecorationList item);
+
+    // Renames in place, keeping the name unique, and records a Rename.
+    void rename(Index index, const std::string& newName);
+
+    // Leaves a tombstone; the slot's index is not reused until compact().
+    void erase(Index index);
+
+    // Erases every live item matching pred, then compacts.
+    template <typename Pred>
+    std::size_t eraseIf(Pred pred) {
+        std::size_t erased = 0;
+        for (Index i = 0; i < m_items.size(); ++i) {
+            if (m_alive[i] && pred(m_items[i])) {
+                erase(i);
+                ++erased;
+            }
+        }
+        compact();
+        return erased;
+    }
+
+    // Drops tombstones. Invalidates indices.
+    void compact();
+    void clear();
+
+    [[nodiscard]] bool isNameTaken(const std::string& name) const;
+
+    // Lowest live index whose contentHash equals `hash`, ignoring `exclude`.
+    // npos if none, or if hash is 0 (unknown).
+    [[nodiscard]] Index findByHash(uint64_t hash, Index exclude = npos) const;
+
+    // Live items
+    [[nodiscard]] std::size_t size() const { return m_items.size() - m_deadCount; }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // Slots including tombstones; valid indices are [0, slotCount()).
+    [[nodiscard]] std::size_t slotCount() const { return m_items.size(); }
+    [[nodiscard]] bool isAlive(Index index) const { return index < m_items.size() && m_alive[index]; }
+
+    CustomeDecorationList& operator[](Index index) { return m_items[index]; }
+    const CustomeDecorationList& operator[](Index index) const { return m_items[index]; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_items.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_items.size()); }
+
+private:
+    // Picks the lowest free of name, name_new, name_new2, ... Every suffix
+    // below the per-base counter is taken, so a run of clashing imports costs
+    // O(1) each instead of O(n); freeing a suffix moves the counter back.
+    std::string uniqueName(const std::string& base);
+    void releaseName(const std::string& name);
+
+    std::vector<CustomeDecorationList> m_items;
+    std::vector<bool> m_alive;
+    std::size_t m_deadCount = 0;
+
+    std::unordered_map<std::string, Index> m_nameIndex;
+    std::unordered_multimap<uint64_t, Index> m_hashIndex;
+    std::unordered_map<std::string, int> m_nextSuffix;
+};
+
+extern CustomDecorCollection CustomDecorList;
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Content hashes of the files in decor/, cached in a text file next to the
+// folder. An entry is reused while the file's size and write time match, so
+// rescanning a large folder only hashes what changed.
+class DecorHashIndex {
+public:
+    static constexpr const char* FILE_NAME = "decor_hashes.idx";
+
+    explicit DecorHashIndex(std::filesystem::path indexFile);
+
+    bool load();
+    bool save() const;
+
+    // Cached hash for `name` if the file has not changed since it was hashed.
+    bool lookup(const std::string& name, uint64_t size, int64_t writeTime, uint64_t& hash) const;
+    void update(const std::string& name, uint64_t size, int64_t writeTime, uint64_t hash);
+
+    // Forgets entries whose file did not show up in the last scan.
+    void retainOnly(const std::unordered_set<std::string>& seen);
+
+    [[nodiscard]] std::size_t size() const { return m_entries.size(); }
+
+    // Write time of `path` in filesystem clock ticks, 0 on error.
+    static int64_t writeTimeOf(const std::filesystem::path& path);
+
+private:
+    struct Entry {
+        uint64_t size = 0;
+        int64_t writeTime = 0;
+        uint64_t hash = 0;
+    };
+
+    std::filesystem::path m_indexFile;
+    std::unordered_map<std::string, Entry> m_entries;
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include <utils/decor_collection.hpp>
+#include <utils/png_optimizer.hpp>
+#include <utils/task_scheduler.hpp>
+#include <utils/texture_manager.hpp>
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Imports a batch of PNG files as custom decorations. Files are decoded to
+// surfaces as one scheduler task each; the render thread turns a few of them into
+// textures per frame in pump(), so the UI keeps running during large imports.
+class DecorImporter {
+public:
+    struct Progress {
+        std::size_t total = 0;
+        std::size_t decoded = 0;   // Surfaces ready or already uploaded
+        std::size_t imported = 0;  // Added to the collection
+        std::size_t failed = 0;
+        std::size_t duplicates = 0; // Identical to an item already in the collection
+        double hashMBps = 0.0;      // Hashing throughput so far
+        std::size_t optimized = 0;  // Re-encoded by the PNG optimizer
+        uint64_t bytesIn = 0;       // Source size of every decoded file
+        uint64_t bytesOut = 0;      // Size that will be written to the decor folder
+    };
+
+    explicit DecorImporter(TaskScheduler& scheduler = TaskScheduler::shared());
+    ~DecorImporter();
+
+    // Starts decoding in the background. Returns false if an import is still running.
+    bool start(std::vector<std::filesystem::path> files);
+
+    // Applies to the next start(); a running import keeps the options it began with.
+    void setPngOptions(const PngOptimizer::Options& options) { m_pngOptions = options; }
+    [[nodiscard]] const PngOptimizer::Options& pngOptions() const { return m_pngOptions; }
+
+    // Larger images are stream-decoded straight into a preview of this size.
+    void setPreviewLimit(int maxWidth, int maxHeight) { m_previewWidth = maxWidth; m_previewHeight = maxHeight; }
+
+    // Render thread only. Uploads up to `maxUploads` decoded images into
+    // `textures` and adds them to `decor` as new items, skipping byte-identical copies of items
+    // it already holds. Items are added in selection order whatever order they finish decoding
+    // in, so clashing names get the same suffixes on every run. Returns how many were added.
+    std::size_t pump(SDL_Renderer* renderer, TextureManager& textures, CustomDecorCollection& decor,
+                     std::size_t maxUploads = s_uploadBatch);
+
+    // Stops the decode tasks and drops everything not yet uploaded.
+    void cancel();
+
+    [[nodiscard]] bool isBusy() const { return m_isBusy; }
+    [[nodiscard]] Progress progress() const;
+
+    // Every *.png (any case) directly inside `folder`, sorted by name.
+    static std::vector<std::filesystem::path> listPngFiles(const std::filesystem::path& folder);
+
+    DecorImporter(const DecorImporter&) = delete;
+    DecorImporter(DecorImporter&&) = delete;
+    DecorImporter& operator=(const DecorImporter&) = delete;
+    DecorImporter& operator=(DecorImporter&&) = delete;
+
+private:
+    struct Decoded {
+        std::size_t index;
+        SDL_Surface* surface;       // Null if the file failed to decode
+        uint64_t contentHash;
+        std::string optimizedBytes; // Empty = copy the source file unchanged
+    };
+
+    void decode(std::size_t index);
+    void pushReady(Decoded decoded);
+    void markFailed(std::size_t index);
+    void waitTasks();
+    void finish();
+
+    // Heap order for m_ready: the lowest selection index on top
+    static bool isLater(const Decoded& a, const Decoded& b) { return a.index > b.index; }
+
+    static constexpr std::size_t s_uploadBatch = 8;
+
+    TaskScheduler& m_scheduler;
+    std::vector<TaskScheduler::Handle> m_tasks;
+
+    std::vector<std::filesystem::path> m_files;
+    std::atomic<std::size_t> m_decoded{ 0 };
+    std::atomic<std::size_t> m_failed{ 0 };
+    std::atomic<uint64_t> m_hashedBytes{ 0 };
+    std::atomic<uint64_t> m_hashNanoseconds{ 0 };
+    std::atomic<bool> m_cancelRequested{ false };
+    std::atomic<std::size_t> m_optimized{ 0 };
+    std::atomic<uint64_t> m_bytesIn{ 0 };
+    std::atomic<uint64_t> m_bytesOut{ 0 };
+
+    PngOptimizer::Options m_pngOptions;
+    PngOptimizer::Options m_activeOptions; // Snapshot read by the tasks
+    int m_previewWidth = 4096;
+    int m_previewHeight = 4096;
+
+    std::mutex m_readyMutex;
+    std::vector<Decoded> m_ready;   // Min-heap on index, held until every earlier file is done
+
+    // Render thread state
+    std::size_t m_nextIndex = 0;    // Next file to hand to the collection
+    bool m_isBusy = false;
+    std::size_t m_imported = 0;
+    std::size_t m_duplicates = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+};
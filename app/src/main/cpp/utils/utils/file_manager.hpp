@@ -1,14 +1,42 @@
 #pragma once
+#include <assets/config_keys.hpp>
+#include <SDL.h>
+#include <bitset>
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <optional>
 #include <filesystem>
 
+class StorageBackend;
+
 namespace FileManager {
 
 void setGamePath(std::filesystem::path path);
 
+// Where files are actually read from and written to. Defaults to the platform
+// backend; swap in a MemoryStorageBackend to run FileManager without a device.
+void setStorageBackend(std::unique_ptr<StorageBackend> backend);
+StorageBackend& storage();
+
+// Direct file access by absolute path through SDL_RWops, bypassing the storage
+// backend. For files the app can reach itself (picked images, the scanned
+// decor folder), as opposed to the game's config files.
+bool readLocalFile(const std::filesystem::path& path, std::string& bytes);
+bool writeLocalFile(const std::filesystem::path& path, const std::string& bytes);
+
+// Per-user writable directory for the app's own files (SDL_GetPrefPath).
+// Empty if the platform has none.
+const std::filesystem::path& prefPath();
+
+// Whole-buffer line handling shared by every backend. CRLF is accepted on read.
+std::vector<std::string> splitLines(const std::string& bytes, bool skipComments);
+std::string joinLines(const std::vector<std::string>& lines);
+
+// printf-style append for the JSON reports; output of any length is kept
+void appendf(std::string& out, SDL_PRINTF_FORMAT_STRING const char* fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+
 // Basic filesystem operations
 std::vector<std::string> readTextFile(const std::string& path);
 bool writeTextFile(const std::string& path, const std::vector<std::string>& lines);
@@ -22,6 +50,13 @@ std::map<std::string, std::string> loadLocalization();
 // Custom font
 bool loadCustomFontSize();
 
+// FONT from font.cfg as a path that exists, or "" if unset or missing
+std::string loadCustomFontPath();
+
+// A FONT value as the game reads it: relative paths are under the game folder.
+// "" if the file does not exist.
+std::string resolveCustomFontPath(const std::string& fontPath);
+
 // Decor assets
 struct DecorAsset {
     std::string name;        // File name without extension
@@ -39,6 +74,27 @@ std::string joinPath(const std::string& base, const std::string& path);
 std::string unescapeString(const std::string& input);
 
 void updateOrAddLine(std::vector<std::string>& lines, const std::string& key, const std::string& newValue, bool quoted = false);
+
+// Entries to write back to the config files. A file with nothing selected is
+// not read or written at all.
+struct ConfigChanges {
+    std::bitset<LocalizationKeyCount> localization;
+    std::bitset<FontKeyCount> font;
+    std::vector<std::string> decor;         // Names in StandartDecorList
+    bool unknownLocalization = false;       // Write UnknownLocalizationEntries too
+    bool unknownFont = false;               // Write UnknownFontEntries too
+
+    [[nodiscard]] bool empty() const {
+        return localization.none() && font.none() && decor.empty() && !unknownLocalization && !unknownFont;
+    }
+    [[nodiscard]] std::size_t count() const {
+        return localization.count() + font.count() + decor.size();
+    }
+
+    static ConfigChanges all();
+};
+
+void updateConfigFiles(const ConfigChanges& changes);
 void updateAllConfigFiles() ;
 void processCustomDecorations(const std::filesystem::path& gamePath);
 
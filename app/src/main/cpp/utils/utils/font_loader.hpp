@@ -0,0 +1,63 @@
+#pragma once
+#include <utils/mapped_file.hpp>
+#include <utils/task_scheduler.hpp>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+// Opens a font file off the render thread: the file is memory-mapped, its
+// pages are read in, and FreeType is asked to open it once so a broken file
+// is caught before anyone draws with it. Large CJK fonts take long enough
+// that doing this on the render thread would drop frames.
+class FontLoader {
+public:
+    enum class State {
+        Idle,
+        Loading,
+        Ready,
+        Failed
+    };
+
+    explicit FontLoader(TaskScheduler& scheduler = TaskScheduler::shared());
+    ~FontLoader();
+
+    // Starts loading `path`, replacing the current font and any load in flight
+    void load(std::filesystem::path path);
+
+    // Back to Idle: callers fall back to the embedded font
+    void reset();
+
+    // Render thread only. True when state() changed since the last call; a
+    // load finishes in the scheduler's runMainThread().
+    bool pump();
+
+    [[nodiscard]] State state() const { return m_state; }
+    [[nodiscard]] const std::filesystem::path& path() const { return m_path; }
+
+    // Bytes of the loaded font while Ready; shared so a TTF_Font opened on
+    // them can outlive the next load()
+    [[nodiscard]] const std::shared_ptr<const MappedFile>& font() const { return m_font; }
+
+    // FreeType's library object is shared by every TTF_Font in the process:
+    // TTF_OpenFont*/TTF_CloseFont from more than one thread go through this
+    // lock. Drawing or measuring with a font no other thread uses needs none.
+    static std::mutex& libraryMutex();
+
+    FontLoader(const FontLoader&) = delete;
+    FontLoader(FontLoader&&) = delete;
+    FontLoader& operator=(const FontLoader&) = delete;
+    FontLoader& operator=(FontLoader&&) = delete;
+
+private:
+    // Worker side: leaves `file` closed if it cannot be used
+    static void open(MappedFile& file, const std::filesystem::path& path);
+
+    TaskScheduler& m_scheduler;
+    TaskScheduler::Handle m_task;
+
+    // Render thread state
+    State m_state = State::Idle;
+    bool m_isChanged = false;
+    std::filesystem::path m_path;
+    std::shared_ptr<const MappedFile> m_font;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Bump allocator for data that only lives until the end of the frame (UI
+// labels, converted paths). reset() rewinds it without freeing, so once it
+// has grown to the largest frame seen, drawing a frame allocates nothing.
+// Render thread only.
+class FrameArena {
+public:
+    static constexpr std::size_t s_defaultCapacity = 64 * 1024;
+
+    explicit FrameArena(std::size_t capacity = s_defaultCapacity);
+
+    // Never returns nullptr; an exhausted arena chains another block and
+    // folds everything into one block on the next reset()
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* allocateArray(std::size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // printf into the arena; valid until the next reset()
+    const char* format(SDL_PRINTF_FORMAT_STRING const char* fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+
+    // UTF-8 form of `path` without a std::string temporary. Returns the
+    // path's own buffer where it is already narrow (POSIX).
+    const char* pathString(const std::filesystem::path& path);
+
+    void reset();
+
+    [[nodiscard]] std::size_t used() const { return m_used + m_offset; }
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t highWater() const { return m_highWater; }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    void addBlock(std::size_t minSize);
+
+    std::vector<Block> m_blocks;
+    std::size_t m_offset = 0;      // Into m_blocks.back()
+    std::size_t m_used = 0;        // Bytes in the blocks before the last one
+    std::size_t m_highWater = 0;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <SDL.h>
+#include <imgui.h>
+#include <cstdint>
+
+// Skips drawing and presenting frames that would look exactly like the one
+// on screen. After ImGui::Render() the final ImDrawData is fingerprinted:
+// vertices, indices, and per command the texture, clip rect, offsets and
+// callback. A match with the last drawn frame means clear, draw and present
+// can all be left out; on the software renderer that is most of a frame.
+//
+// Pixels can change behind an unchanged texture pointer, so whatever
+// rewrites or recreates a texture calls requestRedraw(). Window exposure,
+// resizes and render target resets do the same through noteEvent().
+namespace FrameSkip {
+
+struct Stats {
+    uint64_t drawn = 0;
+    uint64_t skipped = 0;
+};
+
+// Any thread: the next frame is drawn even if its fingerprint matches
+void requestRedraw();
+
+// Every dequeued SDL event; redraws after the window lost its contents or size
+void noteEvent(const SDL_Event& event);
+
+// Render thread, inside the ImGui frame: `list` is left out of this frame's
+// fingerprint. For live readouts such as frame counters, which would
+// otherwise change every frame and keep any frame from being skipped; they
+// are brought up to date whenever something else on screen changes.
+void excludeDrawList(const ImDrawList* list);
+
+// Render thread, after ImGui::Render(). False when the frame can be skipped.
+[[nodiscard]] bool shouldDraw(const ImDrawData* drawData);
+
+[[nodiscard]] Stats stats();
+
+} // namespace FrameSkip
@@ -0,0 +1,67 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// The SDL events InputSystem handles, saved frame by frame to a compact file
+// and played back in place of live input, so a UI session can be rerun as a
+// benchmark. While recording or replaying ImGui runs on a simulated clock of
+// s_frameSeconds per frame, which makes double clicks and key repeat land on
+// the same frames in both runs.
+//
+// Events are stored field by field, not as raw SDL_Event bytes: keyboard,
+// text input and editing, mouse, touch, controller buttons, axes and
+// removal, window and quit. Controller hot-plug is left out; a replayed pad
+// does not need to be connected.
+class InputRecording {
+public:
+    enum class Mode {
+        Off,
+        Recording,
+        Replaying
+    };
+
+    static constexpr float s_frameSeconds = 1.0f / 60.0f;
+
+    bool startRecording(std::filesystem::path path);
+    bool startReplay(const std::filesystem::path& path);
+
+    // Writes the recording, or logs how long the replay took. Back to Off.
+    bool finish();
+
+    // InputSystem, at the start of every processEvents()
+    void beginFrame();
+
+    // Recording: one event as dequeued. Types not listed above are skipped.
+    void record(const SDL_Event& event);
+
+    // Replaying: the current frame's events, in recorded order
+    bool nextEvent(SDL_Event& event);
+
+    // Replaying: true once the frame the recording ended on has begun
+    [[nodiscard]] bool isReplayDone() const;
+
+    [[nodiscard]] Mode mode() const { return m_mode; }
+    [[nodiscard]] bool isActive() const { return m_mode != Mode::Off; }
+    [[nodiscard]] uint64_t frame() const { return m_frame; }
+    [[nodiscard]] const std::filesystem::path& path() const { return m_path; }
+
+private:
+    bool readRecordHeader();
+    void stopReplay(const char* reason);
+
+    Mode m_mode = Mode::Off;
+    std::filesystem::path m_path;
+    std::string m_bytes;            // The whole file, written or read at once
+    uint64_t m_frame = 0;           // Frames begun since start
+    uint64_t m_recordFrame = 0;     // Frame of the last record written or read
+    Uint32 m_timestamp = 0;         // Of the last event written or read
+    std::size_t m_eventCount = 0;
+
+    // Replaying
+    std::size_t m_readPos = 0;
+    uint8_t m_nextKind = 0;         // Kind of the record at m_readPos, read ahead
+    Uint64 m_replayStart = 0;       // Performance counter
+};
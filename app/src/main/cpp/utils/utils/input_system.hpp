@@ -1,11 +1,92 @@
 #pragma once
 
+#include <utils/input_recording.hpp>
 #include <SDL.h>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
 #include <imgui.h>
 #include <backends/imgui_impl_sdl2.h>
 #include <SDL_log.h>
 
-void UpdateGamepadNavigation(ImGuiIO& io, SDL_GameController* controller);
+// SDL events to ImGui for the app's windows. Every connected controller is
+// kept by joystick instance ID; the buttons and left stick ImGui navigates
+// with are merged over all of them and sent to ImGui only when the merged
+// value changes. SDL text input is started or stopped only when ImGui's
+// WantTextInput flips. While an InputRecording replays, live input is
+// dropped (except quitting) and the recorded events are handled instead.
+class InputSystem {
+public:
+    InputSystem() = default;
+    ~InputSystem();
 
-void ProcessSDLEvents(bool& isRunning, std::vector<SDL_GameController*>& controllers);
\ No newline at end of file
+    // Drains the SDL event queue. Clears `isRunning` on SDL_QUIT and when a
+    // replay has run out.
+    void processEvents(bool& isRunning);
+
+    // Once per frame, before ImGui::NewFrame()
+    void updateTextInput(const ImGuiIO& io);
+
+    // Once, after ImGui_ImplSDL2_Init*(). The SDL backend would otherwise
+    // open the first controller itself and send its raw state every frame,
+    // overriding the merged, change-only events.
+    static void takeOverImGuiGamepads();
+
+    // Every frame, after ImGui_ImplSDL2_NewFrame(), which clears
+    // ImGuiBackendFlags_HasGamepad while it has no controllers of its own
+    static void markImGuiGamepads(ImGuiIO& io);
+
+    // Before SDL_Quit()
+    void closeControllers();
+
+    [[nodiscard]] std::size_t controllerCount() const { return m_controllers.size(); }
+
+    [[nodiscard]] InputRecording& recording() { return m_recording; }
+
+    InputSystem(const InputSystem&) = delete;
+    InputSystem(InputSystem&&) = delete;
+    InputSystem& operator=(const InputSystem&) = delete;
+    InputSystem& operator=(InputSystem&&) = delete;
+
+private:
+    // The gamepad inputs ImGui navigates with
+    enum class NavInput : uint8_t {
+        FaceDown,   // A: OK/Enter
+        FaceRight,  // B: Cancel
+        FaceLeft,   // X: Back
+        FaceUp,     // Y
+        DpadUp,
+        DpadDown,
+        DpadLeft,
+        DpadRight,
+        StickLeft,
+        StickRight,
+        StickUp,
+        StickDown,
+        Count
+    };
+    static constexpr std::size_t s_navInputCount = static_cast<std::size_t>(NavInput::Count);
+
+    struct Controller {
+        SDL_GameController* handle = nullptr;
+        std::array<float, s_navInputCount> values{};   // 0..1
+    };
+
+    void handleEvent(const SDL_Event& event, bool& isRunning);
+    Controller* findController(SDL_JoystickID id);
+    void addController(int deviceIndex);
+    void removeController(SDL_JoystickID id);
+    void setButton(Controller& controller, Uint8 button, bool isPressed);
+    void setAxis(Controller& controller, Uint8 axis, Sint16 value);
+    void setValue(Controller& controller, NavInput input, float value);
+    void publish(NavInput input);
+
+    std::unordered_map<SDL_JoystickID, Controller> m_controllers;
+    std::array<float, s_navInputCount> m_sent{};   // What ImGui last got, per input
+
+    InputRecording m_recording;
+
+    bool m_isTextInputSynced = false;   // False until the first updateTextInput()
+    bool m_wantsTextInput = false;
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#if defined(__ANDROID__)
+#include <jni.h>
+#include <SDL.h>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+// Java classes and method IDs used by the native side, resolved once in
+// JNI_OnLoad. FindClass from a native thread only sees system classes, so the
+// app's own classes have to be looked up while the library is being loaded.
+namespace Jni {
+
+struct StaticMethod {
+    jclass cls = nullptr;
+    jmethodID id = nullptr;
+    const char* name = "";
+    const char* signature = "";
+};
+
+struct Method {
+    jmethodID id = nullptr;
+    const char* name = "";
+    const char* signature = "";
+};
+
+struct Bindings {
+    // Global class references
+    jclass fileManager = nullptr;
+    jclass activityThread = nullptr;
+    jclass context = nullptr;
+    jclass packageManager = nullptr;
+    jclass file = nullptr;
+    jclass uri = nullptr;
+    jclass intent = nullptr;
+
+    // com.ipoleksenko.sense.customizer.FileManager
+    StaticMethod readFileBytes;
+    StaticMethod writeFileBytes;
+    StaticMethod fdExists;
+    StaticMethod createFile;
+    StaticMethod copyFile;
+    StaticMethod deleteDecorFile;
+    StaticMethod renameDecorFile;
+    StaticMethod pickImageFromGallery;
+
+    // Android framework
+    StaticMethod currentApplication;
+    StaticMethod uriParse;
+    Method getPackageManager;
+    Method getExternalFilesDir;
+    Method startActivity;
+    Method getPackageInfo;
+    Method getLaunchIntentForPackage;
+    Method getAbsolutePath;
+    Method intentInit;
+};
+
+bool init(JNIEnv* env);
+void shutdown(JNIEnv* env);
+[[nodiscard]] bool isInit();
+[[nodiscard]] const Bindings& bindings();
+
+// JNIEnv of the calling thread, or nullptr (logged) when bindings are missing.
+[[nodiscard]] JNIEnv* env();
+
+// Deletes the wrapped local reference when it goes out of scope.
+template <typename T = jobject>
+class LocalRef {
+public:
+    LocalRef() = default;
+    LocalRef(JNIEnv* env, T ref) : m_env(env), m_ref(ref) {}
+    ~LocalRef() { reset(); }
+
+    LocalRef(LocalRef&& other) noexcept :
+        m_env(other.m_env),
+        m_ref(std::exchange(other.m_ref, nullptr))
+    {}
+
+    LocalRef& operator=(LocalRef&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_env = other.m_env;
+            m_ref = std::exchange(other.m_ref, nullptr);
+        }
+        return *this;
+    }
+
+    LocalRef(const LocalRef&) = delete;
+    LocalRef& operator=(const LocalRef&) = delete;
+
+    [[nodiscard]] T get() const { return m_ref; }
+    explicit operator bool() const { return m_ref != nullptr; }
+
+    T release() { return std::exchange(m_ref, nullptr); }
+
+    void reset(T ref = nullptr) {
+        if (m_ref && m_env) {
+            m_env->DeleteLocalRef(m_ref);
+        }
+        m_ref = ref;
+    }
+
+private:
+    JNIEnv* m_env = nullptr;
+    T m_ref = nullptr;
+};
+
+// Pushes a local reference frame, so every local created inside the scope is
+// released in one go, however the scope is left.
+class LocalFrame {
+public:
+    explicit LocalFrame(JNIEnv* env, jint capacity = 16);
+    ~LocalFrame();
+
+    [[nodiscard]] bool isInit() const { return m_isInit; }
+
+    LocalFrame(const LocalFrame&) = delete;
+    LocalFrame& operator=(const LocalFrame&) = delete;
+
+private:
+    JNIEnv* m_env;
+    bool m_isInit;
+};
+
+// SDL's activity object; SDL hands out a fresh local reference every call.
+LocalRef<jobject> activity(JNIEnv* env);
+
+// Java string from UTF-8. Goes through UTF-16 rather than NewStringUTF, which
+// expects modified UTF-8 and mangles embedded NULs and 4-byte sequences.
+LocalRef<jstring> newString(JNIEnv* env, const std::string& value);
+
+// UTF-8 copy of a Java string (surrogate pairs become 4-byte sequences);
+// releases the JNI chars immediately.
+std::string toString(JNIEnv* env, jstring value);
+
+// Clears and logs a pending Java exception. Returns true if there was one.
+bool clearException(JNIEnv* env, const char* what);
+
+namespace detail {
+    template <typename T> struct TypeCode;
+    template <> struct TypeCode<void>       { static constexpr char value = 'V'; };
+    template <> struct TypeCode<jboolean>   { static constexpr char value = 'Z'; };
+    template <> struct TypeCode<jint>       { static constexpr char value = 'I'; };
+    template <> struct TypeCode<jlong>      { static constexpr char value = 'J'; };
+    template <> struct TypeCode<jobject>    { static constexpr char value = 'L'; };
+    template <> struct TypeCode<jstring>    { static constexpr char value = 'L'; };
+    template <> struct TypeCode<jclass>     { static constexpr char value = 'L'; };
+    template <> struct TypeCode<jbyteArray> { static constexpr char value = '['; };
+    template <> struct TypeCode<std::nullptr_t> { static constexpr char value = 'L'; };
+
+    // Compares the C++ argument/return types against the JNI descriptor.
+    bool checkSignature(const char* name, const char* signature, const char* codes, std::size_t count, char ret);
+
+    template <typename R, typename... Args>
+    bool checkSignature(const char* name, const char* signature) {
+#if defined(NDEBUG)
+        (void)name; (void)signature;
+        return true;
+#else
+        static constexpr char codes[] = { TypeCode<Args>::value..., '\0' };
+        return checkSignature(name, signature, codes, sizeof...(Args), TypeCode<R>::value);
+#endif
+    }
+
+    template <typename R> struct Invoke;
+
+    template <> struct Invoke<void> {
+        template <typename... A> static void callStatic(JNIEnv* e, jclass c, jmethodID m, A... a) { e->CallStaticVoidMethod(c, m, a...); }
+        template <typename... A> static void call(JNIEnv* e, jobject o, jmethodID m, A... a) { e->CallVoidMethod(o, m, a...); }
+    };
+    template <> struct Invoke<jboolean> {
+        template <typename... A> static jboolean callStatic(JNIEnv* e, jclass c, jmethodID m, A... a) { return e->CallStaticBooleanMethod(c, m, a...); }
+        template <typename... A> static jboolean call(JNIEnv* e, jobject o, jmethodID m, A... a) { return e->CallBooleanMethod(o, m, a...); }
+    };
+    template <> struct Invoke<jint> {
+        template <typename... A> static jint callStatic(JNIEnv* e, jclass c, jmethodID m, A... a) { return e->CallStaticIntMethod(c, m, a...); }
+        template <typename... A> static jint call(JNIEnv* e, jobject o, jmethodID m, A... a) { return e->CallIntMethod(o, m, a...); }
+    };
+    template <> struct Invoke<jobject> {
+        template <typename... A> static jobject callStatic(JNIEnv* e, jclass c, jmethodID m, A... a) { return e->CallStaticObjectMethod(c, m, a...); }
+        template <typename... A> static jobject call(JNIEnv* e, jobject o, jmethodID m, A... a) { return e->CallObjectMethod(o, m, a...); }
+    };
+}
+
+template <typename R, typename... Args>
+R callStatic(JNIEnv* env, const StaticMethod& method, Args... args) {
+    if (!method.id || !detail::checkSignature<R, Args...>(method.name, method.signature)) {
+        return R();
+    }
+    return detail::Invoke<R>::callStatic(env, method.cls, method.id, args...);
+}
+
+template <typename R, typename... Args>
+R call(JNIEnv* env, jobject object, const Method& method, Args... args) {
+    if (!object || !method.id || !detail::checkSignature<R, Args...>(method.name, method.signature)) {
+        return R();
+    }
+    return detail::Invoke<R>::call(env, object, method.id, args...);
+}
+
+// Object-returning calls wrapped straight into a LocalRef of the wanted type.
+template <typename T, typename... Args>
+LocalRef<T> callStaticObject(JNIEnv* env, const StaticMethod& method, Args... args) {
+    return LocalRef<T>(env, static_cast<T>(callStatic<jobject>(env, method, args...)));
+}
+
+template <typename T, typename... Args>
+LocalRef<T> callObject(JNIEnv* env, jobject object, const Method& method, Args... args) {
+    return LocalRef<T>(env, static_cast<T>(call<jobject>(env, object, method, args...)));
+}
+
+} // namespace Jni
+#endif
@@ -0,0 +1,75 @@
+#pragma once
+#include <SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// The kind of input a latency sample came from
+enum class InputKind : uint8_t {
+    Mouse,      // Button presses and wheel
+    Keyboard,   // Key presses and text input
+    Touch,
+    Gamepad,
+    Count
+};
+
+// Input-to-present latency. Every press-like SDL event is stamped with the
+// time it happened and carried until the Renderer::present() that shows the
+// first frame built after it. Render thread only.
+namespace LatencyTracker {
+
+inline constexpr std::size_t s_kindCount = static_cast<std::size_t>(InputKind::Count);
+
+// Where the time goes between an input and the present that reflects it
+enum class Stage : uint8_t {
+    Queue,      // Waiting in SDL's queue, including the previous frame's delay
+    Frame,      // Dequeued until present() is called: the ImGui frame and drawing
+    Present,    // Inside present(), mostly waiting for vsync
+    Count
+};
+inline constexpr std::size_t s_stageCount = static_cast<std::size_t>(Stage::Count);
+
+// 1 ms buckets; the last one also holds everything slower
+inline constexpr std::size_t s_bucketCount = 250;
+
+struct Histogram {
+    std::array<uint32_t, s_bucketCount> buckets{};
+    uint64_t count = 0;
+    double sumMs = 0.0;
+    double maxMs = 0.0;
+
+    void add(double ms);
+    // Upper edge of the bucket holding the `fraction` quantile, in ms
+    [[nodiscard]] double percentile(double fraction) const;
+    [[nodiscard]] double meanMs() const { return count > 0 ? sumMs / count : 0.0; }
+};
+
+struct Snapshot {
+    std::array<Histogram, s_kindCount> total{};    // Input to present, per kind
+    std::array<Histogram, s_stageCount> stages{};  // All kinds
+    uint64_t presents = 0;
+};
+
+[[nodiscard]] const char* kindName(InputKind kind);
+[[nodiscard]] const char* stageName(Stage stage);
+
+// Every dequeued SDL event; anything that is not a press is ignored
+void noteEvent(const SDL_Event& event);
+
+// Around SDL_RenderPresent()
+void beginPresent();
+void endPresent();
+
+// A frame that was not presented because nothing on screen changed: its
+// inputs had no visible effect, so there is no latency to measure
+void skipPresent();
+
+[[nodiscard]] const Snapshot& snapshot();
+void reset();
+
+// JSON with count, mean, p50/p95/p99 and max per kind and stage, plus the
+// raw buckets, for comparing pacing changes
+bool writeReport(const std::filesystem::path& path);
+
+} // namespace LatencyTracker
@@ -0,0 +1,69 @@
+#pragma once
+#include <assets/data.hpp>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Several localization languages side by side. Only the active one is
+// resident, in LocalizationList; every language is spilled to a pack file in
+// the app's pref directory: a small header followed by one LocalizationText
+// slot per key. Switching language is one read of that file, and imports
+// write each value straight into its slot, so CSV and PO files of any size
+// are parsed from fixed-size chunks without holding them in memory.
+//
+// localization.cfg itself is still written by FileManager from the active
+// language, through updateOrAddLine().
+class LocalizationPacks {
+public:
+    // The language read from the game's localization.cfg at startup
+    static constexpr const char* s_gameLanguage = "game";
+
+    struct ImportResult {
+        std::size_t values = 0;         // Stored into a pack
+        std::size_t unknownKeys = 0;    // Entries for keys the game does not have
+        std::size_t truncated = 0;      // Longer than a LocalizationText, cut
+        std::vector<std::string> languages;
+    };
+
+    // Lists the packs in `directory` (created if missing) and stores the
+    // current LocalizationList as `activeLanguage`.
+    bool open(std::filesystem::path directory, const std::string& activeLanguage = s_gameLanguage);
+    [[nodiscard]] bool isOpen() const { return !m_directory.empty(); }
+
+    [[nodiscard]] const std::vector<std::string>& languages() const { return m_languages; }
+    [[nodiscard]] const std::string& active() const { return m_active; }
+
+    // LocalizationList was edited; the active pack is rewritten on flush()
+    void markDirty() { m_dirty = true; }
+    bool flush();
+
+    // Spills the active language and loads `language` into LocalizationList;
+    // keys it has no text for keep the game default
+    bool activate(const std::string& language);
+
+    // CSV: header "key,<language>,<language>...", one row per key, RFC 4180 quoting.
+    // PO: msgctxt (or msgid when there is none) is the key, msgstr the text;
+    // the language comes from the header's Language field or the file name.
+    bool importCsv(const std::filesystem::path& path, ImportResult& result);
+    bool importPo(const std::filesystem::path& path, ImportResult& result);
+    bool exportCsv(const std::filesystem::path& path);
+    bool exportPo(const std::string& language, const std::filesystem::path& path);
+
+    // Letters, digits, '-' and '_'; used as a file name
+    [[nodiscard]] static bool isValidLanguage(std::string_view language);
+
+private:
+    [[nodiscard]] std::filesystem::path packPath(const std::string& language) const;
+    bool readPack(const std::string& language, std::array<LocalizationText, LocalizationKeyCount>& texts) const;
+    bool writePack(const std::string& language, const std::array<LocalizationText, LocalizationKeyCount>& texts);
+    void addLanguage(const std::string& language);
+    bool finishImport(const ImportResult& result);
+
+    std::filesystem::path m_directory;
+    std::vector<std::string> m_languages;   // Sorted
+    std::string m_active;
+    bool m_dirty = false;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+// Read-only view of a whole file. The file is memory-mapped where the
+// platform allows it, so opening costs nothing per byte and pages are only
+// read when touched; otherwise it falls back to reading the file into memory.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_data != nullptr || m_isEmpty; }
+    [[nodiscard]] const unsigned char* data() const { return m_data; }
+    [[nodiscard]] std::size_t size() const { return m_size; }
+    [[nodiscard]] bool isMapped() const { return m_isMapped; }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_isMapped = false;
+    bool m_isEmpty = false;     // Opened, but there is nothing to map
+    std::string m_fallback;     // Owns the bytes when the file could not be mapped
+};
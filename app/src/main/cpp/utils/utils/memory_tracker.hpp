@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Subsystem an allocation is charged to. The current tag is per thread and
+// set with MemoryTagScope; ImGui's allocator always charges ImGui.
+enum class MemoryTag : uint8_t {
+    Other,
+    ConfigIO,
+    Decor,
+    Text,
+    ImGui,
+    Count
+};
+
+// Opt-in allocation accounting. Built with SENSE_MEMORY_TRACKING, install()
+// routes global operator new/delete, SDL_malloc and ImGui's allocator through
+// per-thread counters; without it only RSS and texture bytes are reported.
+namespace MemoryTracker {
+
+inline constexpr std::size_t s_tagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+struct TagStats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;     // Highest liveBytes seen at a frame boundary
+};
+
+struct Snapshot {
+    std::array<TagStats, s_tagCount> tags{};
+    uint64_t frames = 0;
+    uint64_t frameAllocations = 0;      // During the last completed frame
+    uint64_t frameBytes = 0;
+    uint64_t maxFrameAllocations = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;
+    uint64_t peakRssBytes = 0;
+    uint64_t textureBytes = 0;
+};
+
+[[nodiscard]] constexpr bool isEnabled() {
+#if defined(SENSE_MEMORY_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] const char* tagName(MemoryTag tag);
+
+// First thing in main(), before SDL or ImGui allocate anything
+void install();
+
+// Render thread, once per frame: closes the per-frame counters
+void beginFrame();
+void setTextureBytes(uint64_t bytes);
+
+[[nodiscard]] Snapshot snapshot();
+[[nodiscard]] uint64_t peakRssBytes();
+
+// JSON with the snapshot above, per tag
+bool writeReport(const std::filesystem::path& path);
+
+namespace detail {
+    inline thread_local MemoryTag s_currentTag = MemoryTag::Other;
+}
+
+} // namespace MemoryTracker
+
+// Charges allocations on this thread to `tag` until the scope ends
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) :
+        m_previous(MemoryTracker::detail::s_currentTag)
+    {
+        MemoryTracker::detail::s_currentTag = tag;
+    }
+    ~MemoryTagScope() { MemoryTracker::detail::s_currentTag = m_previous; }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope(MemoryTagScope&&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(MemoryTagScope&&) = delete;
+
+private:
+    MemoryTag m_previous;
+};
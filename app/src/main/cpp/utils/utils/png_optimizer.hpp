@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Import-time PNG slimming: images larger than the configured size are
+// downscaled and every image is re-encoded with only IHDR/IDAT/IEND, so the
+// game has less to read and decode at each launch.
+namespace PngOptimizer {
+
+struct PngInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint8_t bitDepth = 0;
+    uint8_t colorType = 0;
+    uint8_t interlace = 0;
+    std::size_t ancillaryBytes = 0; // tEXt, iCCP, eXIf, ... including chunk headers
+};
+
+struct Options {
+    bool enabled = false;
+    int maxDimension = 1024; // Longest side after import, in pixels
+};
+
+struct Result {
+    std::string bytes;       // Re-encoded file; empty when the source is kept as is
+    int width = 0;
+    int height = 0;
+    double encodeMs = 0.0;
+};
+
+// Validates the signature and walks the chunk list without decoding anything.
+bool readPngInfo(const void* data, std::size_t size, PngInfo& info);
+
+// Largest size with the same aspect ratio whose longest side fits maxDimension.
+void fitWithin(int width, int height, int maxDimension, int& outWidth, int& outHeight);
+
+// Builds the optimized file from an already decoded surface, which may be
+// smaller than the source described by `info`. The file is stored at the
+// decoded size when that is below maxDimension, so decode at
+// fitWithin(source, maxDimension) to honour the option. Returns false when
+// there is nothing to gain (no downscale and the output is not smaller).
+bool optimize(SDL_Surface* decoded, const PngInfo& info, std::size_t sourceSize,
+              const Options& options, Result& result);
+
+} // namespace PngOptimizer
@@ -0,0 +1,32 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+
+// Row-streaming PNG decoder for previews. IDAT data is inflated a few
+// kilobytes at a time and every row is box-filtered into the output as soon
+// as it is complete, so memory depends on the image width and the preview
+// size, never on the full source resolution.
+namespace PngStream {
+
+// Longest side the decoder accepts. Its row buffers and column map grow with
+// the width, so a crafted IHDR must not be able to ask for gigabytes.
+constexpr uint32_t s_maxSide = 65536;
+
+// Size of the preview that fits within maxWidth x maxHeight, keeping the
+// aspect ratio; never larger than the source. False if `data` is not a PNG
+// or is wider or taller than s_maxSide.
+bool previewSize(const void* data, std::size_t size, int maxWidth, int maxHeight, int& width, int& height);
+
+// Decodes into `target`, an RGBA32 surface no larger than the image (its pixels may live
+// in a locked texture). Returns false and sets the SDL error on failure.
+bool decodeInto(const void* data, std::size_t size, SDL_Surface* target);
+
+// Decodes to an RGBA32 surface of previewSize(). Returns nullptr and sets
+// the SDL error on failure.
+SDL_Surface* loadDownsampled(const void* data, std::size_t size, int maxWidth, int maxHeight);
+
+// IMG_Load_RW for images that already fit, loadDownsampled() for larger ones.
+SDL_Surface* loadPreview(const void* data, std::size_t size, int maxWidth, int maxHeight);
+
+} // namespace PngStream
@@ -0,0 +1,63 @@
+#pragma once
+#include <utils/file_manager.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Named snapshots of the whole customization: LocalizationList, FontList,
+// StandartDecorList and the custom decor manifest, with the unknown config
+// entries kept alongside. A preset is one versioned binary file of
+// length-prefixed records in the app's pref directory. Applying maps it and
+// compares it with the current state field by field, so nothing is parsed
+// as text, and the result says exactly which entries changed: only those
+// cfg keys and decor files are written.
+//
+// Custom decor is identified by content hash. Saving keeps a copy of each
+// PNG under decor/<hash>/ beside the presets, so applying can bring back
+// decor that has since been deleted from the game folder.
+class PresetStore {
+public:
+    struct Diff {
+        FileManager::ConfigChanges config;
+        std::size_t decorRenamed = 0;
+        std::size_t decorRemoved = 0;
+        std::size_t decorRestored = 0;                      // Pending removals undone
+        std::vector<std::filesystem::path> missingDecor;    // Stored copies to import again
+        std::size_t decorUnavailable = 0;                   // In the preset, but no stored copy
+
+        [[nodiscard]] bool hasDecorChanges() const { return decorRenamed + decorRemoved + decorRestored > 0; }
+        [[nodiscard]] bool empty() const {
+            return config.empty() && !hasDecorChanges() && missingDecor.empty();
+        }
+    };
+
+    // Lists the presets in `directory`, creating it if missing
+    bool open(std::filesystem::path directory);
+    [[nodiscard]] bool isOpen() const { return !m_directory.empty(); }
+
+    [[nodiscard]] const std::vector<std::string>& names() const { return m_names; }
+
+    // Snapshots the current state, replacing a preset of the same name
+    bool save(const std::string& name);
+
+    // Brings the current state in line with the preset in memory. `diff`
+    // lists what changed; writing it out is up to the caller.
+    bool apply(const std::string& name, Diff& diff);
+
+    bool remove(const std::string& name);
+
+    // Usable as a file name on every platform
+    [[nodiscard]] static bool isValidName(std::string_view name);
+
+private:
+    [[nodiscard]] std::filesystem::path presetPath(const std::string& name) const;
+    [[nodiscard]] std::filesystem::path decorStoreDir(uint64_t contentHash) const;
+    void storeDecor(uint64_t contentHash, const std::string& name, const std::filesystem::path& source,
+                    const std::string& pendingBytes);
+
+    std::filesystem::path m_directory;
+    std::vector<std::string> m_names;   // Sorted
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Bounded queue between exactly one producer thread and one consumer thread.
+// Neither side locks or waits: a push into a full ring or a pop from an
+// empty one just returns false. Items are moved in and out, so a message
+// that owns a buffer hands it over without copying it.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+        "SpscRing items are moved through default-constructed slots");
+
+public:
+    // Producer only. False when full, and `value` is left as it was.
+    bool tryPush(T&& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == Capacity) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == Capacity) {
+                return false;
+            }
+        }
+        m_slots[tail & s_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. False when empty.
+    bool tryPop(T& out) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) {
+                return false;
+            }
+        }
+        T& slot = m_slots[head & s_mask];
+        out = std::move(slot);
+        slot = T();     // Whatever the moved-from item still holds goes now, not a lap later
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Exact only on a thread that is not pushing or popping at the same time
+    [[nodiscard]] std::size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t s_mask = Capacity - 1;
+    static constexpr std::size_t s_cacheLine = 64;
+
+    // Each side writes only its own index; the other side's index is cached
+    // so the shared cache line is read only when the ring looks full or empty
+    alignas(s_cacheLine) std::atomic<std::size_t> m_head{ 0 };   // Consumer
+    std::size_t m_tailCache = 0;                                 // Consumer
+    alignas(s_cacheLine) std::atomic<std::size_t> m_tail{ 0 };   // Producer
+    std::size_t m_headCache = 0;                                 // Producer
+    alignas(s_cacheLine) std::array<T, Capacity> m_slots{};
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#if !defined(__ANDROID__)
+#include <steam/steam_api.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// The Steamworks calls used by SteamStatus. Kept behind an interface so the
+// poller can be driven by a fake on machines without Steam.
+class SteamBackend {
+public:
+    virtual ~SteamBackend() = default;
+
+    virtual bool init() = 0;
+    virtual void shutdown() = 0;
+    virtual void runCallbacks() = 0;
+    virtual bool isReady() = 0;
+    virtual bool isSubscribedApp(AppId_t appId) = 0;
+    virtual bool isAppInstalled(AppId_t appId) = 0;
+};
+
+class SteamworksBackend : public SteamBackend {
+public:
+    bool init() override;
+    void shutdown() override;
+    void runCallbacks() override;
+    bool isReady() override;
+    bool isSubscribedApp(AppId_t appId) override;
+    bool isAppInstalled(AppId_t appId) override;
+};
+
+// Polls Steam on a background thread and publishes the result as one atomic
+// word, so the render loop only ever does a single acquire load.
+class SteamStatus {
+public:
+    struct Snapshot {
+        bool steamRunning = false;
+        bool ownsGame = false;
+        bool isInstalled = false;
+        uint32_t generation = 0; // Completed polls, 0 = nothing known yet
+    };
+
+    explicit SteamStatus(AppId_t appId, std::unique_ptr<SteamBackend> backend = std::make_unique<SteamworksBackend>());
+    ~SteamStatus();
+
+    void start();
+    void stop();
+    void requestRefresh();
+
+    [[nodiscard]] Snapshot snapshot() const;
+
+    SteamStatus(const SteamStatus&) = delete;
+    SteamStatus(SteamStatus&&) = delete;
+    SteamStatus& operator=(const SteamStatus&) = delete;
+    SteamStatus& operator=(SteamStatus&&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void poll(bool& steamRunning);
+    void publish(bool steamRunning, bool ownsGame, bool isInstalled);
+
+    const AppId_t m_appId;
+    std::unique_ptr<SteamBackend> m_backend;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopRequested = false;
+    bool m_refreshRequested = false;
+
+    // bit 0 = running, bit 1 = owns game, bit 2 = installed, bits 3..31 = generation
+    std::atomic<uint32_t> m_state{ 0 };
+
+    static constexpr std::chrono::milliseconds s_minBackoff{ 250 };
+    static constexpr std::chrono::milliseconds s_maxBackoff{ 8000 };
+    static constexpr std::chrono::milliseconds s_callbackInterval{ 100 };
+};
+#endif
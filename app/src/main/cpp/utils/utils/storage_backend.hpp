@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Whole-file storage behind FileManager. Every read and write moves the
+// complete file as one byte buffer, so a config file costs a single transfer
+// regardless of how many lines it has.
+class StorageBackend {
+public:
+    virtual ~StorageBackend() = default;
+
+    // Replaces `bytes` with the file contents. Returns false if the file could not be read.
+    virtual bool readFile(const std::string& path, std::string& bytes) = 0;
+    virtual bool writeFile(const std::string& path, const char* data, std::size_t size) = 0;
+    virtual bool fileExists(const std::string& path) = 0;
+    virtual bool dirExists(const std::string& path) = 0;
+    virtual bool createFile(const std::string& path) = 0;
+};
+
+// std::filesystem / fstream, used on desktop.
+class DesktopStorageBackend : public StorageBackend {
+public:
+    bool readFile(const std::string& path, std::string& bytes) override;
+    bool writeFile(const std::string& path, const char* data, std::size_t size) override;
+    bool fileExists(const std::string& path) override;
+    bool dirExists(const std::string& path) override;
+
+    // Only makes sure the parent directory exists; the file appears on first write.
+    bool createFile(const std::string& path) override;
+};
+
+// Keeps every file in memory. Lets the FileManager parsing and transfer code
+// run (and be timed) on a workstation without a device or a game install.
+class MemoryStorageBackend : public StorageBackend {
+public:
+    bool readFile(const std::string& path, std::string& bytes) override;
+    bool writeFile(const std::string& path, const char* data, std::size_t size) override;
+    bool fileExists(const std::string& path) override;
+    bool dirExists(const std::string& path) override;
+    bool createFile(const std::string& path) override;
+
+    [[nodiscard]] std::size_t fileCount() const;
+    void clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::string> m_files;
+};
+
+#if defined(__ANDROID__)
+// The game's ContentProvider, reached through FileManager.java. A read is one
+// byte[] handed back from Java; a write wraps the native buffer in a direct
+// ByteBuffer, so the file content is never converted to a Java String.
+class AndroidStorageBackend : public StorageBackend {
+public:
+    bool readFile(const std::string& path, std::string& bytes) override;
+    bool writeFile(const std::string& path, const char* data, std::size_t size) override;
+    bool fileExists(const std::string& path) override;
+    bool dirExists(const std::string& path) override;
+    bool createFile(const std::string& path) override;
+};
+#endif
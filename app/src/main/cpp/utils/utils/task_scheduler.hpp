@@ -0,0 +1,139 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The thread pool behind the background jobs (decor imports, text fitting,
+// font loading). Every worker owns a deque per priority and takes its newest
+// task first; a worker with nothing to do steals the oldest task of another.
+// Anything that has to touch the renderer or UI state is returned as a
+// continuation, which runMainThread() runs on the render thread once per
+// frame under a time budget.
+class TaskScheduler {
+public:
+    enum class Priority : uint8_t {
+        High,       // The user is waiting on it
+        Normal,
+        Low,        // Background analysis
+        Count
+    };
+    static constexpr std::size_t s_priorityCount = static_cast<std::size_t>(Priority::Count);
+
+    // A submitted task, shared by the scheduler and the submitter
+    class Handle {
+    public:
+        Handle() = default;
+
+        // A queued task is dropped; a running one sees isCancelled(). Its
+        // continuation is skipped either way.
+        void cancel() const;
+        [[nodiscard]] bool isCancelled() const;
+
+        // Ran or was dropped. The continuation may still be queued.
+        [[nodiscard]] bool isDone() const;
+
+        // Blocks until isDone(). Does not run continuations, so never wait on
+        // the render thread for a task that posts one and then waits itself.
+        void wait() const;
+
+        [[nodiscard]] bool isValid() const { return m_state != nullptr; }
+
+    private:
+        friend class TaskScheduler;
+        struct State;
+        std::shared_ptr<State> m_state;
+    };
+
+    using Work = std::function<void(const Handle& self)>;
+    using Continuation = std::function<void()>;
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t executed = 0;
+        uint64_t stolen = 0;        // Executed by a worker other than the one it was queued on
+        uint64_t cancelled = 0;     // Dropped before they ran
+        uint64_t continuations = 0; // Run by runMainThread()
+    };
+
+    // 0 = one worker per hardware thread, leaving one for the render thread
+    explicit TaskScheduler(unsigned workerCount = 0);
+    ~TaskScheduler();
+
+    // The pool the app's background jobs use. Created on first use; objects
+    // that keep tasks in flight take it in their constructor so it outlives them.
+    static TaskScheduler& shared();
+
+    // Any thread. `then` runs on the render thread after `work`, unless the
+    // task was cancelled by then.
+    Handle submit(Work work, Priority priority = Priority::Normal, Continuation then = {});
+
+    // Any thread. Runs `continuation` on the render thread at the next runMainThread().
+    void post(Continuation continuation);
+
+    // Render thread only. Runs queued continuations until none are left or
+    // `budget` is spent; at least one runs so a long frame cannot starve them.
+    // Returns how many ran.
+    std::size_t runMainThread(std::chrono::microseconds budget);
+
+    [[nodiscard]] unsigned workerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    // The calling thread's index in [0, workerCount()) of the pool it belongs
+    // to, or -1 on any other thread. Lets tasks keep per-worker state.
+    [[nodiscard]] static int currentWorker();
+
+    [[nodiscard]] Stats stats() const;
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+private:
+    struct Task {
+        Work work;
+        Continuation then;
+        std::shared_ptr<Handle::State> state;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<Task>, s_priorityCount> queues;   // Guarded by mutex
+        std::thread thread;
+    };
+
+    struct MainTask {
+        Continuation continuation;
+        std::shared_ptr<Handle::State> state;   // Null for post()
+    };
+
+    void workerLoop(unsigned index);
+    bool takeTask(unsigned index, Task& task);
+    void run(Task& task, Handle& handle);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<unsigned> m_nextWorker{ 0 };
+
+    // Workers sleep here when every deque is empty
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<std::size_t> m_queued{ 0 };
+    bool m_stopRequested = false;               // Guarded by m_sleepMutex
+
+    std::mutex m_mainMutex;
+    std::deque<MainTask> m_mainQueue;           // Guarded by m_mainMutex
+
+    std::atomic<uint64_t> m_submitted{ 0 };
+    std::atomic<uint64_t> m_executed{ 0 };
+    std::atomic<uint64_t> m_stolen{ 0 };
+    std::atomic<uint64_t> m_cancelled{ 0 };
+    uint64_t m_continuations = 0;               // Render thread
+};
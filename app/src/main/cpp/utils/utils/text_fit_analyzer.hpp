@@ -0,0 +1,116 @@
+#pragma once
+#include <assets/config_keys.hpp>
+#include <utils/task_scheduler.hpp>
+#include <SDL_ttf.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Checks every localization value against the game's text areas: each line
+// is measured with TTF_SizeUTF8 at the size its key is drawn with, unwrapped
+// as the game draws it, and every code point is checked for a glyph in the
+// font. Each key is a low-priority scheduler task; every worker keeps its own
+// TTF_Font per size, so measuring never shares FreeType state. Results land
+// on the render thread as task continuations.
+//
+// Widths and heights are in the game's 1280x720 reference space, the one
+// Text::render() scales from.
+class TextFitAnalyzer {
+public:
+    // The two sizes the game draws localization with
+    enum class SizeClass : uint8_t {
+        Text,       // FONT_SIZE
+        OtherText,  // OTHER_TEXT_FONT_SIZE
+        Count
+    };
+    static constexpr std::size_t s_sizeClassCount = static_cast<std::size_t>(SizeClass::Count);
+
+    struct Area {
+        int width = 1200;
+        int height = 680;
+    };
+
+    struct Result {
+        bool isReady = false;
+        int widestLine = 0;             // Pixels, longest line as written
+        int lines = 0;                  // Non-empty lines as written; nothing is wrapped
+        int height = 0;                 // Pixels for `lines`
+        bool overflows = false;         // `widestLine` wider, or `height` taller, than the area
+        uint32_t missingGlyphs = 0;     // Code points the font has no glyph for
+        std::string missingSample;      // Up to s_missingSampleSize of them, UTF-8
+    };
+    static constexpr std::size_t s_missingSampleSize = 8;
+
+    explicit TextFitAnalyzer(TaskScheduler& scheduler = TaskScheduler::shared());
+    ~TextFitAnalyzer();
+
+    // Font bytes to measure with; `owner` keeps them alive while any worker
+    // still uses them. Re-analyzes everything.
+    void setFont(const void* data, std::size_t size, std::shared_ptr<const void> owner = {});
+
+    // Cheap when nothing changed; a change re-analyzes the affected keys
+    void setFontSizes(int textSize, int otherTextSize);
+    void setArea(SizeClass sizeClass, const Area& area);
+    [[nodiscard]] const Area& area(SizeClass sizeClass) const { return m_areas[static_cast<std::size_t>(sizeClass)]; }
+
+    // Queues LocalizationList[index] (or every key) for analysis, superseding
+    // any analysis of it still queued
+    void update(std::size_t index);
+    void updateAll();
+
+    [[nodiscard]] const Result& result(std::size_t index) const { return m_results[index]; }
+    [[nodiscard]] bool isBusy() const { return m_pending != 0; }
+
+    [[nodiscard]] static SizeClass sizeClassOf(std::size_t index);
+
+    TextFitAnalyzer(const TextFitAnalyzer&) = delete;
+    TextFitAnalyzer(TextFitAnalyzer&&) = delete;
+    TextFitAnalyzer& operator=(const TextFitAnalyzer&) = delete;
+    TextFitAnalyzer& operator=(TextFitAnalyzer&&) = delete;
+
+private:
+    struct FontData {
+        const void* data = nullptr;
+        std::size_t size = 0;
+        std::shared_ptr<const void> owner;
+    };
+
+    struct Job {
+        std::size_t index;
+        std::string text;
+        std::shared_ptr<const FontData> font;
+        int fontSize;
+        Area area;
+        Result result;
+    };
+
+    // A worker's font for one size class, reopened when the job's font or size differs
+    struct WorkerFont {
+        std::shared_ptr<const FontData> font;
+        int size = 0;
+        TTF_Font* handle = nullptr;
+    };
+
+    void run(Job& job);
+    static TTF_Font* openFont(WorkerFont& slot, const std::shared_ptr<const FontData>& font, int size);
+    static void closeFont(WorkerFont& slot);
+    static void analyze(TTF_Font* font, const std::string& text, const Area& area, Result& result);
+
+    TaskScheduler& m_scheduler;
+
+    // Indexed by TaskScheduler::currentWorker(); a worker runs one task at a time
+    std::vector<std::array<WorkerFont, s_sizeClassCount>> m_workerFonts;
+
+    // Render thread state
+    std::shared_ptr<const FontData> m_font;
+    std::array<int, s_sizeClassCount> m_fontSizes{};
+    std::array<Area, s_sizeClassCount> m_areas{};
+    std::array<TaskScheduler::Handle, LocalizationKeyCount> m_tasks;
+    std::array<uint32_t, LocalizationKeyCount> m_generations{};
+    std::array<uint32_t, LocalizationKeyCount> m_finishedGenerations{};
+    std::array<Result, LocalizationKeyCount> m_results{};
+    std::size_t m_pending = 0;          // Keys whose latest analysis has not landed
+};
@@ -3,6 +3,8 @@
 #include <assets/assets.hpp>
 #include <SDL2/SDL.h>
 #include <SDL_image.h>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 class Texture {
@@ -44,3 +46,36 @@ class SurfaceTexture : public Texture {
 public:
     explicit SurfaceTexture(SDL_Surface* surface, SDL_Renderer* renderer);
 };
+
+
+// Uploads go through a locked SDL_TEXTUREACCESS_STREAMING texture in the
+// renderer's native layout: pixels are converted once, straight into texture
+// memory, instead of SDL_CreateTextureFromSurface's convert-then-copy.
+namespace TextureUpload {
+
+// `premultiply` stores premultiplied alpha and sets a matching blend mode,
+// which keeps edges clean when the texture is drawn scaled down. It is
+// dropped when the renderer has no custom blend modes.
+SDL_Texture* fromSurface(SDL_Renderer* renderer, SDL_Surface* surface, bool premultiply = false);
+
+// Decodes a PNG or any other SDL_image format. PNGs larger than
+// maxWidth x maxHeight are box-filtered by PngStream directly into the
+// locked texture, so no full-size surface is ever allocated.
+SDL_Texture* fromImage(SDL_Renderer* renderer, const void* data, std::size_t size,
+                       int maxWidth, int maxHeight, bool premultiply = false);
+
+// RGBA8 row kernel (SSE2/AVX2/NEON with a scalar tail). `src` and `dst` may
+// be the same buffer. Alpha stays in the last byte of each pixel.
+void convertRow(const uint8_t* src, uint8_t* dst, std::size_t pixels, bool swapRedBlue, bool premultiply);
+
+// Instruction set convertRow() uses. The fastest one the CPU has is picked
+// at startup; tests and benchmarks force the others to compare them.
+enum class Kernel { Scalar, Sse2, Avx2, Neon };
+
+[[nodiscard]] Kernel kernel();
+[[nodiscard]] bool isKernelSupported(Kernel kernel);
+// Not thread-safe: only while nothing is uploading. False if unsupported.
+bool setKernel(Kernel kernel);
+[[nodiscard]] const char* kernelName(Kernel kernel);
+
+} // namespace TextureUpload
@@ -0,0 +1,125 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <unordered_set>
+
+class TextureManager;
+
+// Shared state behind every handle to one texture. Only TextureManager
+// changes it; handles just read `texture` through TextureManager::acquire().
+struct TextureEntry {
+    TextureManager* owner = nullptr;    // nullptr once the manager is gone
+    SDL_Texture* texture = nullptr;     // nullptr while evicted
+    std::filesystem::path source;       // Reload path, empty = never evicted
+    bool premultiply = false;
+    bool reloadFailed = false;
+    uint64_t bytes = 0;                 // Size while resident
+    uint64_t lastUsedFrame = 0;
+    std::list<TextureEntry*>::iterator lruPosition;
+};
+
+// Refcounted reference to a managed texture. Copies share the texture; it
+// is destroyed with the last handle. get() reloads an evicted texture from
+// its source, so holders never see eviction except as a short stall.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(std::nullptr_t) {}
+
+    [[nodiscard]] SDL_Texture* get() const;
+    [[nodiscard]] bool isResident() const { return m_entry && m_entry->texture; }
+    [[nodiscard]] const std::filesystem::path& source() const;
+
+    // The file moved (copied into the decor folder, renamed): reload from here
+    void setSource(std::filesystem::path source);
+
+    void reset() { m_entry.reset(); }
+    explicit operator bool() const { return m_entry != nullptr; }
+
+private:
+    friend class TextureManager;
+    explicit TextureHandle(std::shared_ptr<TextureEntry> entry) : m_entry(std::move(entry)) {}
+
+    std::shared_ptr<TextureEntry> m_entry;
+};
+
+// Owns decor textures for the render thread. Tracks the bytes of every
+// resident texture and, at the start of each frame, evicts the least
+// recently used ones that can be reloaded until the total fits the budget.
+// Not thread-safe: create, acquire and evict on the render thread only.
+class TextureManager {
+public:
+    struct Stats {
+        std::size_t textures = 0;     // Live handles' textures, resident or not
+        std::size_t resident = 0;
+        uint64_t residentBytes = 0;
+        uint64_t budgetBytes = 0;
+        uint64_t hits = 0;            // get() on a resident texture
+        uint64_t misses = 0;          // get() that had to reload
+        uint64_t evictions = 0;
+
+        [[nodiscard]] double hitRate() const {
+            const uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / total : 1.0;
+        }
+    };
+
+    static constexpr uint64_t s_defaultBudget = 256ull * 1024 * 1024;
+
+    explicit TextureManager(uint64_t budgetBytes = s_defaultBudget);
+    ~TextureManager();
+
+    // Needed to reload evicted textures
+    void setRenderer(SDL_Renderer* renderer) { m_renderer = renderer; }
+    void setPreviewLimit(int maxWidth, int maxHeight) { m_previewWidth = maxWidth; m_previewHeight = maxHeight; }
+
+    void setBudget(uint64_t budgetBytes) { m_budget = budgetBytes; }
+    [[nodiscard]] uint64_t budget() const { return m_budget; }
+
+    // Takes ownership of `texture`. With an empty `source` it stays resident
+    // for as long as a handle exists. `premultiply` must match how it was uploaded.
+    TextureHandle adopt(SDL_Texture* texture, std::filesystem::path source = {}, bool premultiply = false);
+
+    // Marks the frame boundary and evicts down to the budget. Textures used
+    // in the frame that just ended are kept even when over budget.
+    void beginFrame();
+
+    // Destroys every texture while the renderer is still alive. Handles that
+    // remain afterwards return nullptr.
+    void shutdown();
+
+    [[nodiscard]] Stats stats() const;
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager(TextureManager&&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+    TextureManager& operator=(TextureManager&&) = delete;
+
+private:
+    friend class TextureHandle;
+
+    SDL_Texture* acquire(TextureEntry& entry);
+    bool reload(TextureEntry& entry);
+    void makeResident(TextureEntry& entry, SDL_Texture* texture);
+    void evict(TextureEntry& entry);
+    static void release(TextureEntry* entry);
+
+    SDL_Renderer* m_renderer = nullptr;
+    int m_previewWidth = 4096;
+    int m_previewHeight = 4096;
+
+    uint64_t m_budget;
+    uint64_t m_residentBytes = 0;
+    uint64_t m_frame = 1;
+
+    std::unordered_set<TextureEntry*> m_entries;
+    std::list<TextureEntry*> m_lru; // Resident entries, most recently used first
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+// Scoped trace zones written out as Chrome trace-event JSON, which
+// chrome://tracing and ui.perfetto.dev open directly. Each thread records
+// into its own buffer, so zones on worker threads show up on their own
+// track and overlap with the render thread as they really did.
+//
+// Built with SENSE_TRACING, a zone costs one relaxed load while no session
+// is running; without it TRACE_ZONE compiles to nothing. Zone names must be
+// string literals: only the pointer is kept.
+namespace Trace {
+
+[[nodiscard]] constexpr bool isCompiledIn() {
+#if defined(SENSE_TRACING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Starts recording; stop() writes everything since to `path`
+bool start(std::filesystem::path path);
+bool stop();
+
+// Shown as the calling thread's track name. Works before start().
+void setThreadName(const char* name);
+
+namespace detail {
+    inline std::atomic<bool> s_isRecording{ false };
+
+    [[nodiscard]] uint64_t now();
+    void record(const char* name, uint64_t begin, uint64_t end);
+}
+
+[[nodiscard]] inline bool isRecording() {
+    return detail::s_isRecording.load(std::memory_order_relaxed);
+}
+
+} // namespace Trace
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) :
+        m_name(Trace::isRecording() ? name : nullptr),
+        m_begin(m_name ? Trace::detail::now() : 0)
+    {}
+
+    ~TraceZone() {
+        if (m_name) {
+            Trace::detail::record(m_name, m_begin, Trace::detail::now());
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone(TraceZone&&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+    TraceZone& operator=(TraceZone&&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_begin;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if defined(SENSE_TRACING)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __COUNTER__)(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#endif
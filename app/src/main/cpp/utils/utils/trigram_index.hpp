@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Case-insensitive substring search over a fixed set of documents. Each
+// document is split into byte trigrams of its case-folded text (ASCII and
+// basic Cyrillic); a query intersects the posting lists of its trigrams and
+// checks only the surviving documents. update() diffs a document's old and
+// new trigrams, so editing one entry never touches the others.
+class TrigramIndex {
+public:
+    using DocId = uint32_t;
+
+    void resize(std::size_t documentCount);
+    [[nodiscard]] std::size_t size() const { return m_folded.size(); }
+
+    // Replaces the indexed text of `doc`
+    void update(DocId doc, std::string_view text);
+
+    // Ids of the documents containing `query`, ascending. An empty query
+    // matches everything. `results` is reused, not appended to.
+    void search(std::string_view query, std::vector<DocId>& results) const;
+
+    [[nodiscard]] std::size_t trigramCount() const { return m_postings.size(); }
+
+private:
+    static void fold(std::string_view text, std::string& out);
+    static void collectTrigrams(const std::string& folded, std::vector<uint32_t>& trigrams);
+
+    void addPosting(uint32_t trigram, DocId doc);
+    void removePosting(uint32_t trigram, DocId doc);
+
+    // Posting lists are sorted; ordered keys let a 1-2 byte query take every
+    // trigram that starts with it
+    std::map<uint32_t, std::vector<DocId>> m_postings;
+    std::vector<std::vector<uint32_t>> m_docTrigrams;   // Sorted, unique
+    std::vector<std::string> m_folded;                  // For verifying candidates
+
+    // Scratch, kept to avoid allocating per query
+    mutable std::string m_query;
+    mutable std::vector<uint32_t> m_queryTrigrams;
+    mutable std::vector<const std::vector<DocId>*> m_lists;
+    mutable std::vector<DocId> m_swap;
+    mutable std::vector<uint8_t> m_marks;
+    std::string m_scratch;
+    std::vector<uint32_t> m_trigrams;
+};
@@ -20,8 +20,6 @@ import androidx.documentfile.provider.DocumentFile;
 
 import org.libsdl.app.SDLActivity;
 
-import java.io.BufferedReader;
-import java.io.BufferedWriter;
 import java.io.ByteArrayOutputStream;
 import java.io.File;
 import java.io.FileInputStream;
@@ -29,12 +27,11 @@ import java.io.FileNotFoundException;
 import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
-import java.io.InputStreamReader;
 import java.io.OutputStream;
-import java.io.OutputStreamWriter;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.WritableByteChannel;
 import java.nio.file.Files;
-import java.util.Collections;
-import java.util.List;
 
 public class FileManager extends SDLActivity {
     private static final String TAG = "JFileManager";
@@ -161,25 +158,27 @@ public class FileManager extends SDLActivity {
         startActivityForResult(pickIntent, PICK_IMAGE_REQUEST);
     }
 
-    public static String readFullText(Context context, String path) {
-        Log.w(TAG, "readFullText called with path: " + path);
-        StringBuilder textBuilder = new StringBuilder();
-
+    public static byte[] readFileBytes(Context context, String path) {
         Uri uri = Uri.parse(PROVIDER_URI + path);
-        try (BufferedReader reader = new BufferedReader(
-                new InputStreamReader(context.getContentResolver().openInputStream(uri))
-        )) {
-            String line;
-            while ((line = reader.readLine()) != null) {
-                textBuilder.append(line).append('\n');
+        try (InputStream inputStream = context.getContentResolver().openInputStream(uri)) {
+            if (inputStream == null) {
+                Log.w(TAG, "Failed to open input stream for reading: " + uri);
+                return null;
+            }
+
+            ByteArrayOutputStream bytes = new ByteArrayOutputStream(Math.max(inputStream.available(), 8192));
+            byte[] buffer = new byte[8192];
+            int bytesRead;
+            while ((bytesRead = inputStream.read(buffer)) != -1) {
+                bytes.write(buffer, 0, bytesRead);
             }
+            return bytes.toByteArray();
         } catch (IOException e) {
             Log.e(TAG, "Error reading file from URI: " + uri, e);
         } catch (Exception e) {
             Log.e(TAG, "Unexpected error while reading file: " + uri, e);
         }
-
-        return textBuilder.toString();
+        return null;
     }
 
     public static boolean createFile(Context context, String fileName) {
@@ -230,21 +229,22 @@ public class FileManager extends SDLActivity {
         return exists;
     }
 
-    public static boolean writeTextFile(Context context, String path, List<String> lines) {
+    // data wraps native memory and is only valid for the duration of the call.
+    public static boolean writeFileBytes(Context context, String path, ByteBuffer data) {
         Uri uri = Uri.parse(PROVIDER_URI + path);
-        try (OutputStream outputStream = context.getContentResolver().openOutputStream(uri, "rwt");
-             BufferedWriter writer = new BufferedWriter(new OutputStreamWriter(outputStream))) {
-
+        try (OutputStream outputStream = context.getContentResolver().openOutputStream(uri, "rwt")) {
             if (outputStream == null) {
                 Log.w(TAG, "Failed to open output stream for writing: " + uri);
                 return false;
             }
 
-            for (String line : lines) {
-                writer.write(line);
-                writer.newLine();
+            if (data != null) {
+                WritableByteChannel channel = Channels.newChannel(outputStream);
+                while (data.hasRemaining()) {
+                    channel.write(data);
+                }
             }
-            writer.flush();
+            outputStream.flush();
 
             Log.i(TAG, "File successfully written: " + uri);
             return true;